@@ -0,0 +1,201 @@
+/**
+ * This program measures the error of the SSPPR methods against exact PPR and their runtime, and prints the
+ * settings on the Pareto front of latency against error.
+ *
+ * Usage:
+ *   Accuracy <filename> <graph_type> [--args]
+ *
+ * Arguments:
+ *   <filename>    : Path to the input graph file.
+ *   <graph_type>  : Type of the graph. Currently supported: "uwudgraph", "wudgraph", "uwdigraph", "wdigraph".
+ *
+ * Optional arguments (specified with --args):
+ *   --methods     : Comma-separated methods (default push,fora,speedppr,ppw); fora_f32 etc. for float storage.
+ *   --alpha       : Damping factor (default 0.2).
+ *   --eps         : Comma-separated relative errors of fora and speedppr (default 0.5,0.2,0.1,0.05).
+ *   --rmax        : Comma-separated residual thresholds of push and fora_skeleton (default 1e-3,1e-4,1e-5,1e-6).
+ *   --rw_num      : Comma-separated numbers of walks of rw and fora_skeleton (default 100,1000,10000).
+ *   --pi_num      : Comma-separated numbers of power iterations of ppw (default 2,5,10).
+ *   --sources     : Number of sampled sources (default 10).
+ *   --source_list : Comma-separated sources, replaces sampling.
+ *   --reps        : Timed runs per source and setting (default 3).
+ *   --k           : k of precision@k and NDCG@k (default 100).
+ *   --delta       : Smallest exact value counted in the max relative error (default 1/n).
+ *   --tol         : L1 error of the ground truth (default 1e-12).
+ *   --truth       : Cache file of the ground truth, reused while the query matches.
+ *   --metric      : [max_rel_err | l1 | precision | ndcg] metric of the Pareto front (default max_rel_err).
+ *   --budget_ms   : Also print the most accurate setting with a median latency within this budget.
+ *   --dangling    : [restart | uniform | selfloop] (default restart on directed graphs, selfloop on undirected ones).
+ *   --seed        : Seed of the source sampling (default 1).
+ *   --threads     : Number of threads used for the ground truth (default all cores).
+ *   --csv         : Path to save all settings as CSV, with a pareto column.
+ */
+
+#include <sstream>
+
+#include "convenientPrint.hpp"
+#include "multithread/parallel.hpp"
+
+#include "uwudgraph/graphio.hpp"
+#include "wudgraph/graphio.hpp"
+#include "uwdigraph/graphio.hpp"
+#include "wdigraph/graphio.hpp"
+#include "uwudgraph/apps/accuracy/accuracy.hpp"
+
+std::vector<std::string> split(const std::string &list) {
+    std::vector<std::string> items;
+    std::stringstream ss(list);
+    std::string item;
+    while (std::getline(ss, item, ',')) {
+        if (!item.empty()) items.push_back(item);
+    }
+    return items;
+}
+
+template <class G>
+std::vector<uwudgraph::AccuracyRecord> evaluate(const G &g, uwudgraph::AccuracyConfig config) {
+    if (config.sources.empty()) config.sources = uwudgraph::sample_sources(g, config.num_sources, config.seed);
+    auto start = std::chrono::steady_clock::now();
+    uwudgraph::GroundTruth truth =
+        uwudgraph::ground_truth(g, config.sources, config.alpha, config.tol, config.dangling, config.cache);
+    print("Ground truth of", truth.sources.size(), "sources in",
+          std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count(), "seconds");
+    return uwudgraph::accuracy_sweep(g, truth, config);
+}
+
+int main(int argc, char **argv) {
+    if (argc < 3) {
+        print("Usage: Accuracy <filename> <graph_type> [--args]");
+        print("Optional arguments (specified with --args):");
+        print("\t--methods");
+        print("\t--alpha");
+        print("\t--eps");
+        print("\t--rmax");
+        print("\t--rw_num");
+        print("\t--pi_num");
+        print("\t--sources");
+        print("\t--source_list");
+        print("\t--reps");
+        print("\t--k");
+        print("\t--delta");
+        print("\t--tol");
+        print("\t--truth");
+        print("\t--metric");
+        print("\t--budget_ms");
+        print("\t--dangling");
+        print("\t--seed");
+        print("\t--threads");
+        print("\t--csv");
+        return -1;
+    }
+
+    std::string filename = argv[1];
+    std::string graph_type = argv[2];
+
+    uwudgraph::AccuracyConfig config;
+    config.graph = filename;
+    std::string dangling = "";
+    std::string metric = "max_rel_err";
+    double budget_ms = 0;
+    std::string csv = "";
+
+    for (int i = 3; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--methods") {
+            config.methods = split(argv[++i]);
+        } else if (arg == "--alpha") {
+            config.alpha = std::stod(argv[++i]);
+        } else if (arg == "--eps") {
+            config.epss.clear();
+            for (const std::string &x : split(argv[++i])) config.epss.push_back(std::stod(x));
+        } else if (arg == "--rmax") {
+            config.rmaxs.clear();
+            for (const std::string &x : split(argv[++i])) config.rmaxs.push_back(std::stod(x));
+        } else if (arg == "--rw_num") {
+            config.rw_nums.clear();
+            for (const std::string &x : split(argv[++i])) config.rw_nums.push_back(std::stoull(x));
+        } else if (arg == "--pi_num") {
+            config.pi_nums.clear();
+            for (const std::string &x : split(argv[++i])) config.pi_nums.push_back(std::stoull(x));
+        } else if (arg == "--sources") {
+            config.num_sources = std::stoull(argv[++i]);
+        } else if (arg == "--source_list") {
+            for (const std::string &x : split(argv[++i])) config.sources.push_back(std::stoull(x));
+        } else if (arg == "--reps") {
+            config.reps = std::stoull(argv[++i]);
+        } else if (arg == "--k") {
+            config.k = std::stoull(argv[++i]);
+        } else if (arg == "--delta") {
+            config.delta = std::stod(argv[++i]);
+        } else if (arg == "--tol") {
+            config.tol = std::stod(argv[++i]);
+        } else if (arg == "--truth") {
+            config.cache = argv[++i];
+        } else if (arg == "--metric") {
+            metric = argv[++i];
+        } else if (arg == "--budget_ms") {
+            budget_ms = std::stod(argv[++i]);
+        } else if (arg == "--dangling") {
+            dangling = argv[++i];
+        } else if (arg == "--seed") {
+            config.seed = std::stoul(argv[++i]);
+        } else if (arg == "--threads") {
+            set_num_threads(std::stoull(argv[++i]));
+        } else if (arg == "--csv") {
+            csv = argv[++i];
+        } else {
+            print("Unknown argument: " + arg);
+            return -1;
+        }
+    }
+
+    bool directed = graph_type == "uwdigraph" || graph_type == "wdigraph";
+    config.dangling = uwudgraph::parse_dangling(dangling.empty() ? (directed ? "restart" : "selfloop") : dangling);
+    uwudgraph::metric_error(uwudgraph::AccuracyRecord(), metric);     // rejects an unknown metric before the sweep
+
+    std::vector<uwudgraph::AccuracyRecord> records;
+    if (graph_type == "uwudgraph") {
+        uwudgraph::Graph *g = uwudgraph::load_graph(filename);
+        records = evaluate(*g, config);
+        delete g;
+    } else if (graph_type == "wudgraph") {
+        wudgraph::Graph *g = wudgraph::load_edgelist(filename);
+        records = evaluate(*g, config);
+        delete g;
+    } else if (graph_type == "uwdigraph") {
+        uwdigraph::Graph *g = uwdigraph::load_edgelist(filename);
+        records = evaluate(*g, config);
+        delete g;
+    } else if (graph_type == "wdigraph") {
+        wdigraph::Graph *g = wdigraph::load_edgelist(filename);
+        records = evaluate(*g, config);
+        delete g;
+    } else {
+        throw std::invalid_argument("Unsupported graph type for Accuracy: " + graph_type);
+    }
+
+    uwudgraph::mark_pareto(records, metric);
+    std::vector<const uwudgraph::AccuracyRecord *> front;
+    for (const uwudgraph::AccuracyRecord &r : records) {
+        if (r.pareto) front.push_back(&r);
+    }
+    std::sort(front.begin(), front.end(), [](auto a, auto b) { return a->latency.median < b->latency.median; });
+    print("Pareto front of median latency against", metric + ":");
+    auto report = [](const uwudgraph::AccuracyRecord &r) {
+        print(r.method, "eps", r.eps, "rmax", r.rmax, "rw_num", r.rw_num, "pi_num", r.pi_num, ": median",
+              r.latency.median, "ms max_rel_err", r.metrics.max_rel_err, "l1", r.metrics.l1, "precision",
+              r.metrics.precision, "ndcg", r.metrics.ndcg);
+    };
+    for (const uwudgraph::AccuracyRecord *r : front) report(*r);
+    if (budget_ms > 0) {
+        const uwudgraph::AccuracyRecord *best = uwudgraph::best_under_budget(records, metric, budget_ms);
+        if (best == nullptr) {
+            print("No setting runs within", budget_ms, "ms");
+        } else {
+            print("Best within", budget_ms, "ms:");
+            report(*best);
+        }
+    }
+    if (!csv.empty()) uwudgraph::write_accuracy_csv(csv, records);
+    return 0;
+}
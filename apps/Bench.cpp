@@ -0,0 +1,185 @@
+/**
+ * This program benchmarks the SSPPR methods on a graph and optionally compares the run with a baseline.
+ *
+ * Usage:
+ *   Bench <filename> <graph_type> [--args]
+ *
+ * Arguments:
+ *   <filename>    : Path to the input graph file.
+ *   <graph_type>  : Type of the graph. Currently supported: "uwudgraph", "wudgraph", "uwdigraph", "wdigraph".
+ *
+ * Optional arguments (specified with --args):
+ *   --methods     : Comma-separated methods (default push,rw,fora_skeleton,fora,speedppr,ppw).
+ *   --alpha       : Comma-separated damping factors (default 0.2).
+ *   --eps         : Comma-separated relative errors (default 0.1).
+ *   --sources     : Number of sampled sources (default 10).
+ *   --source_list : Comma-separated sources, replaces sampling.
+ *   --warmup      : Untimed queries per source (default 1).
+ *   --reps        : Timed passes over the sources (default 5).
+ *   --rmax        : Residual threshold for push-based methods (default as in SSPPR).
+ *   --rw_num      : Number of random walks for sampling-based methods (default as in SSPPR).
+ *   --dangling    : [restart | uniform | selfloop] (default restart on directed graphs, selfloop on undirected ones).
+ *   --seed        : Seed of the source sampling (default 1).
+ *   --threads     : Number of threads of the parallel loops (default all cores).
+ *   --numa        : [interleave | first_touch] placement of the graph arrays on NUMA machines (default interleave).
+ *   --huge_pages  : [on | off] back the graph and the query workspaces with huge pages (default on).
+ *   --json        : Path to save the records as JSON.
+ *   --csv         : Path to save the records as CSV.
+ *   --baseline    : CSV of an earlier run; the program fails if a median regressed.
+ *   --tolerance   : Allowed relative slowdown of a median (default 0.25).
+ *   --noise_ms    : Slowdowns below this many milliseconds are ignored (default 0.05).
+ */
+
+#include <sstream>
+
+#include "convenientPrint.hpp"
+#include "memory.hpp"
+#include "multithread/parallel.hpp"
+
+#include "uwudgraph/graphio.hpp"
+#include "wudgraph/graphio.hpp"
+#include "uwdigraph/graphio.hpp"
+#include "wdigraph/graphio.hpp"
+#include "uwudgraph/apps/bench/bench.hpp"
+
+std::vector<std::string> split(const std::string &list) {
+    std::vector<std::string> items;
+    std::stringstream ss(list);
+    std::string item;
+    while (std::getline(ss, item, ',')) {
+        if (!item.empty()) items.push_back(item);
+    }
+    return items;
+}
+
+int main(int argc, char **argv) {
+    if (argc < 3) {
+        print("Usage: Bench <filename> <graph_type> [--args]");
+        print("Optional arguments (specified with --args):");
+        print("\t--methods");
+        print("\t--alpha");
+        print("\t--eps");
+        print("\t--sources");
+        print("\t--source_list");
+        print("\t--warmup");
+        print("\t--reps");
+        print("\t--rmax");
+        print("\t--rw_num");
+        print("\t--dangling");
+        print("\t--seed");
+        print("\t--threads");
+        print("\t--numa [interleave | first_touch]");
+        print("\t--huge_pages [on | off]");
+        print("\t--json");
+        print("\t--csv");
+        print("\t--baseline");
+        print("\t--tolerance");
+        print("\t--noise_ms");
+        return -1;
+    }
+
+    std::string filename = argv[1];
+    std::string graph_type = argv[2];
+
+    uwudgraph::BenchConfig config;
+    config.graph = filename;
+    std::string dangling = "";
+    std::string json = "";
+    std::string csv = "";
+    std::string baseline = "";
+    double tolerance = 0.25;
+    double noise_ms = 0.05;
+
+    for (int i = 3; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--methods") {
+            config.methods = split(argv[++i]);
+        } else if (arg == "--alpha") {
+            config.alphas.clear();
+            for (const std::string &x : split(argv[++i])) config.alphas.push_back(std::stod(x));
+        } else if (arg == "--eps") {
+            config.epss.clear();
+            for (const std::string &x : split(argv[++i])) config.epss.push_back(std::stod(x));
+        } else if (arg == "--sources") {
+            config.num_sources = std::stoull(argv[++i]);
+        } else if (arg == "--source_list") {
+            for (const std::string &x : split(argv[++i])) config.sources.push_back(std::stoull(x));
+        } else if (arg == "--warmup") {
+            config.warmup = std::stoull(argv[++i]);
+        } else if (arg == "--reps") {
+            config.reps = std::stoull(argv[++i]);
+        } else if (arg == "--rmax") {
+            config.rmax = std::stod(argv[++i]);
+        } else if (arg == "--rw_num") {
+            config.rw_num = std::stoull(argv[++i]);
+        } else if (arg == "--dangling") {
+            dangling = argv[++i];
+        } else if (arg == "--seed") {
+            config.seed = std::stoul(argv[++i]);
+        } else if (arg == "--threads") {
+            set_num_threads(std::stoull(argv[++i]));
+        } else if (arg == "--numa") {
+            set_numa_policy(parse_numa_policy(argv[++i]));
+        } else if (arg == "--huge_pages") {
+            set_huge_pages(std::string(argv[++i]) != "off");
+        } else if (arg == "--json") {
+            json = argv[++i];
+        } else if (arg == "--csv") {
+            csv = argv[++i];
+        } else if (arg == "--baseline") {
+            baseline = argv[++i];
+        } else if (arg == "--tolerance") {
+            tolerance = std::stod(argv[++i]);
+        } else if (arg == "--noise_ms") {
+            noise_ms = std::stod(argv[++i]);
+        } else {
+            print("Unknown argument: " + arg);
+            return -1;
+        }
+    }
+
+    bool directed = graph_type == "uwdigraph" || graph_type == "wdigraph";
+    config.dangling = uwudgraph::parse_dangling(dangling.empty() ? (directed ? "restart" : "selfloop") : dangling);
+
+    std::vector<uwudgraph::BenchRecord> records;
+    if (graph_type == "uwudgraph") {
+        uwudgraph::Graph *g = uwudgraph::load_graph(filename);
+        records = uwudgraph::bench_ssppr(*g, config);
+        delete g;
+    } else if (graph_type == "wudgraph") {
+        wudgraph::Graph *g = wudgraph::load_edgelist(filename);
+        records = uwudgraph::bench_ssppr(*g, config);
+        delete g;
+    } else if (graph_type == "uwdigraph") {
+        uwdigraph::Graph *g = uwdigraph::load_edgelist(filename);
+        records = uwudgraph::bench_ssppr(*g, config);
+        delete g;
+    } else if (graph_type == "wdigraph") {
+        wdigraph::Graph *g = wdigraph::load_edgelist(filename);
+        records = uwudgraph::bench_ssppr(*g, config);
+        delete g;
+    } else {
+        throw std::invalid_argument("Unsupported graph type for Bench: " + graph_type);
+    }
+
+    for (const uwudgraph::BenchRecord &r : records) {
+        print(r.method, "alpha", r.alpha, "eps", r.eps, ": median", r.latency.median, "ms p99", r.latency.p99,
+              "ms pushes", r.pushes, "walk steps", r.walk_steps, "peak rss", r.peak_rss_kb, "kB");
+    }
+    if (!json.empty()) uwudgraph::write_bench_json(json, records);
+    if (!csv.empty()) uwudgraph::write_bench_csv(csv, records);
+
+    if (!baseline.empty()) {
+        std::ifstream exists(baseline);
+        if (!exists.is_open()) {
+            print("No baseline at", baseline, "- run make bench_baseline to record one.");
+            return 0;
+        }
+        size_t regressions = uwudgraph::compare_baseline(records, baseline, tolerance, noise_ms);
+        if (regressions > 0) {
+            print(regressions, "configurations regressed against", baseline);
+            return 1;
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,100 @@
+/**
+ * This program turns a raw edge list into a graph with dense node ids, optionally keeping only the
+ * largest connected component. It replaces scripts/map_points.py and scripts/get_component.py.
+ *
+ * Usage:
+ *   Component <filename> <save_path> [--args]
+ *
+ * Arguments:
+ *   <filename>    : Path to the raw edge list, node ids may be any 64-bit integers or strings.
+ *   <save_path>   : Path of the output graph.
+ *
+ * Optional arguments (specified with --args):
+ *   --ids         : [auto | int | string] how node ids are parsed (default auto).
+ *   --largest     : [1 | 0] keep only the largest connected component (default 1).
+ *   --format      : [bin | text] output format, bin is read by load_graph (default bin).
+ *   --mapping     : Path to save "original<TAB>dense" id pairs.
+ *   --threads     : Number of threads for union-find and graph construction (default all cores).
+ */
+
+#include <chrono>
+
+#include "convenientPrint.hpp"
+
+#include "uwudgraph/graphio.hpp"
+#include "uwudgraph/apps/component/compact.hpp"
+#include "uwudgraph/apps/component/component.hpp"
+
+int main(int argc, char **argv) {
+    if (argc < 3) {
+        print("Usage: Component <filename> <save_path> [--args]");
+        print("Optional arguments (specified with --args):");
+        print("\t--ids [auto | int | string]");
+        print("\t--largest [1 | 0]");
+        print("\t--format [bin | text]");
+        print("\t--mapping");
+        print("\t--threads");
+        return -1;
+    }
+
+    std::string filename = argv[1];
+    std::string save_path = argv[2];
+
+    std::string ids_mode = "auto";
+    bool largest = true;
+    std::string format = "bin";
+    std::string mapping = "";
+
+    for (int i = 3; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--ids") {
+            ids_mode = argv[++i];
+        } else if (arg == "--largest") {
+            largest = std::stoi(argv[++i]) != 0;
+        } else if (arg == "--format") {
+            format = argv[++i];
+        } else if (arg == "--mapping") {
+            mapping = argv[++i];
+        } else if (arg == "--threads") {
+            set_num_threads(std::stoull(argv[++i]));
+        } else {
+            print("Unknown argument: " + arg);
+            return -1;
+        }
+    }
+    if (format != "bin" && format != "text") {
+        throw std::invalid_argument("Invalid output format specified for Component: " + format);
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    uwudgraph::IdMap ids(ids_mode);
+    uwudgraph::Graph* g = nullptr;
+    {
+        std::vector<uwudgraph::edge> edges = uwudgraph::read_raw_edgelist(filename, ids);
+        g = uwudgraph::build_graph(ids.size(), edges);
+    }
+    print("nodes:", g->n, "edges:", g->m, "seconds:", std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+
+    std::vector<uwudgraph::node_id> new_id;
+    if (largest) {
+        uwudgraph::node_id num_components = 0;
+        std::vector<uwudgraph::node_id> label = uwudgraph::connected_components(*g, num_components);
+        uwudgraph::node_id c = uwudgraph::largest_component(label, num_components);
+        uwudgraph::Graph* sub = uwudgraph::extract_component(*g, label, c, new_id);
+        delete g;
+        g = sub;
+        print("components:", num_components, "largest component: nodes:", g->n, "edges:", g->m,
+              "seconds:", std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+    }
+
+    if (format == "bin") {
+        uwudgraph::save_binary(save_path, *g);
+    } else {
+        uwudgraph::save_edgelist(save_path, *g);
+    }
+    if (!mapping.empty()) {
+        ids.save(mapping, new_id);
+    }
+    delete g;
+    return 0;
+}
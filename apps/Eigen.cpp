@@ -0,0 +1,93 @@
+/**
+ * This program computes extreme eigenpairs of graph matrices with a thick-restart block Lanczos solver.
+ *
+ * Usage:
+ *   Eigen <filename> <graph_type> <k> <operator> [--args]
+ *
+ * Arguments:
+ *   <filename>    : Path to the input graph file.
+ *   <graph_type>  : Type of the graph. Currently supported: "uwudgraph".
+ *   <k>           : Number of eigenpairs to compute.
+ *   <operator>    : "laplacian" (k smallest eigenpairs of D - A) or
+ *                   "normalized_adjacency" (k largest eigenpairs of D^{-1/2} A D^{-1/2}).
+ *
+ * Optional arguments (specified with --args):
+ *   --tol          : Relative residual tolerance (default 1e-8).
+ *   --max_restarts : Maximum number of thick restarts (default 1000).
+ *   --block_size   : Lanczos block size (default min(k, 4)).
+ *   --threads      : Number of threads for SpMV and orthogonalization (default all cores).
+ *   --output       : [save | display | none] (default none).
+ *   --save_path    : Path to save (eigenvalues, eigenvectors) if --output is set to "save".
+ */
+
+#include "convenientPrint.hpp"
+#include "serialize.hpp"
+
+#include "uwudgraph/apps/eigen/eigen.hpp"
+
+int main(int argc, char **argv) {
+    if (argc < 5) {
+        print("Usage: Eigen <filename> <graph_type> <k> <operator> [--args]");
+        print("Optional arguments (specified with --args):");
+        print("\t--tol");
+        print("\t--max_restarts");
+        print("\t--block_size");
+        print("\t--threads");
+        print("\t--output");
+        print("\t--save_path");
+        return -1;
+    }
+
+    std::string filename = argv[1];
+    std::string graph_type = argv[2];
+    size_t k = std::stoull(argv[3]);
+    std::string which = argv[4];
+
+    double tol = 0.0;
+    size_t max_restarts = 0;
+    size_t block_size = 0;
+    std::string output = "";
+    std::string save_path = "";
+
+    for (int i = 5; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--tol") {
+            tol = std::stod(argv[++i]);
+        } else if (arg == "--max_restarts") {
+            max_restarts = std::stoull(argv[++i]);
+        } else if (arg == "--block_size") {
+            block_size = std::stoull(argv[++i]);
+        } else if (arg == "--threads") {
+            set_num_threads(std::stoull(argv[++i]));
+        } else if (arg == "--output") {
+            output = argv[++i];
+        } else if (arg == "--save_path") {
+            save_path = argv[++i];
+        } else {
+            print("Unknown argument: " + arg);
+            return -1;
+        }
+    }
+
+    uwudgraph::EigenResult result;
+    if (graph_type == "uwudgraph") {
+        result = uwudgraph::Eigen(filename, k, which, tol, max_restarts, block_size);
+    } else {
+        throw std::invalid_argument("Unsupported graph type for Eigen: " + graph_type);
+    }
+
+    if (!result.converged) {
+        print("Warning: Lanczos did not converge after", result.restarts, "restarts.");
+    }
+    if (output == "display") {
+        print("operator:", which, "k:", k, "spmv:", result.spmv, "restarts:", result.restarts);
+        print("Eigenvalues:", result.values);
+        for (size_t i = 0; i < result.vectors.size(); ++i) {
+            print("Eigenvector", i, ":", result.vectors[i]);
+        }
+    } else if (output == "save") {
+        save_file(save_path, std::make_pair(result.values, result.vectors));
+    }
+
+    return 0;
+}
@@ -0,0 +1,115 @@
+/**
+ * This program generates a synthetic undirected graph and saves it.
+ *
+ * Usage:
+ *   Generate <model> <save_path> [--args]
+ *
+ * Arguments:
+ *   <model>       : "rmat", "er", "ba", "sbm" or "grid".
+ *   <save_path>   : Path of the output graph.
+ *
+ * Optional arguments (specified with --args):
+ *   --scale       : rmat: 2^scale nodes.
+ *   --n           : er, ba, sbm: number of nodes.
+ *   --m           : rmat, er, sbm: number of edge draws (default 16 per node).
+ *   --a, --b, --c : rmat: quadrant probabilities (default 0.57, 0.19, 0.19).
+ *   --k           : ba: edges per node (default 8).
+ *   --blocks      : sbm: number of blocks (default 10).
+ *   --mu          : sbm: fraction of draws between blocks (default 0.1).
+ *   --rows, --cols: grid: lattice size.
+ *   --keep        : grid: probability to keep each lattice edge (default 1).
+ *   --seed        : Random seed (default 1); a seed gives the same graph for any thread count.
+ *   --threads     : Number of threads (default all cores).
+ *   --format      : [bin | text] output format, bin is read by load_graph (default bin).
+ */
+
+#include <chrono>
+
+#include "convenientPrint.hpp"
+#include "multithread/parallel.hpp"
+
+#include "uwudgraph/graphio.hpp"
+#include "uwudgraph/apps/generate/generate.hpp"
+
+int main(int argc, char **argv) {
+    if (argc < 3) {
+        print("Usage: Generate <model> <save_path> [--args]");
+        print("Optional arguments (specified with --args):");
+        print("\t--scale");
+        print("\t--n");
+        print("\t--m");
+        print("\t--a --b --c");
+        print("\t--k");
+        print("\t--blocks");
+        print("\t--mu");
+        print("\t--rows --cols");
+        print("\t--keep");
+        print("\t--seed");
+        print("\t--threads");
+        print("\t--format [bin | text]");
+        return -1;
+    }
+
+    std::string model = argv[1];
+    std::string save_path = argv[2];
+
+    uwudgraph::GeneratorParams params;
+    std::string format = "bin";
+
+    for (int i = 3; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--scale") {
+            params.scale = std::stoul(argv[++i]);
+        } else if (arg == "--n") {
+            params.n = std::stoul(argv[++i]);
+        } else if (arg == "--m") {
+            params.m = std::stoull(argv[++i]);
+        } else if (arg == "--a") {
+            params.a = std::stod(argv[++i]);
+        } else if (arg == "--b") {
+            params.b = std::stod(argv[++i]);
+        } else if (arg == "--c") {
+            params.c = std::stod(argv[++i]);
+        } else if (arg == "--k") {
+            params.k = std::stoul(argv[++i]);
+        } else if (arg == "--blocks") {
+            params.blocks = std::stoul(argv[++i]);
+        } else if (arg == "--mu") {
+            params.mu = std::stod(argv[++i]);
+        } else if (arg == "--rows") {
+            params.rows = std::stoul(argv[++i]);
+        } else if (arg == "--cols") {
+            params.cols = std::stoul(argv[++i]);
+        } else if (arg == "--keep") {
+            params.keep = std::stod(argv[++i]);
+        } else if (arg == "--seed") {
+            params.seed = std::stoull(argv[++i]);
+        } else if (arg == "--threads") {
+            set_num_threads(std::stoull(argv[++i]));
+        } else if (arg == "--format") {
+            format = argv[++i];
+        } else {
+            print("Unknown argument: " + arg);
+            return -1;
+        }
+    }
+    if (format != "bin" && format != "text") {
+        throw std::invalid_argument("Invalid output format specified for Generate: " + format);
+    }
+    if (params.k == 0) params.k = 8;
+    if (params.blocks == 0) params.blocks = 10;
+    if (params.m == 0) params.m = 16 * static_cast<size_t>(model == "rmat" ? (size_t(1) << params.scale) : params.n);
+
+    auto start = std::chrono::steady_clock::now();
+    uwudgraph::Graph *g = uwudgraph::generate_graph(model, params);
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    print("model:", model, "nodes:", g->n, "edges:", g->m, "seconds:", seconds);
+
+    if (format == "bin") {
+        uwudgraph::save_binary(save_path, *g);
+    } else {
+        uwudgraph::save_edgelist(save_path, *g);
+    }
+    delete g;
+    return 0;
+}
@@ -0,0 +1,145 @@
+/**
+ * This program builds a hub index (precomputed pushes from the highest-degree nodes, see
+ * uwudgraph/apps/ssppr/ssppr_hubs.hpp) for a graph, saves it and optionally measures the query speedup.
+ *
+ * Usage:
+ *   HubIndex <filename> <graph_type> <alpha> <save_path> [--args]
+ *
+ * Arguments:
+ *   <filename>    : Path to the input graph file.
+ *   <graph_type>  : Type of the graph. Currently supported: "uwudgraph", "wudgraph", "uwdigraph", "wdigraph".
+ *   <alpha>       : Damping factor (teleport probability) the index is built for.
+ *   <save_path>   : Path of the index file, "none" to not save it.
+ *
+ * Optional arguments (specified with --args):
+ *   --rmax        : Residual threshold of the hub vectors (default 1e-6); queries gain most with rmax at least this.
+ *   --budget_mb   : Megabytes the index may take (default 256).
+ *   --max_hubs    : Largest number of hubs (default no limit).
+ *   --threads     : Number of threads (default all cores).
+ *   --dangling    : [uniform | selfloop] (default uniform on directed graphs, selfloop on undirected ones).
+ *   --bench       : Number of random sources to time forward push with and without the index on (default 0).
+ *   --query_rmax  : rmax of the timed queries (default --rmax).
+ *   --seed        : Random seed of the timed sources (default 1).
+ */
+
+#include <chrono>
+#include <random>
+
+#include "convenientPrint.hpp"
+#include "multithread/parallel.hpp"
+
+#include "uwudgraph/graphio.hpp"
+#include "wudgraph/graphio.hpp"
+#include "uwdigraph/graphio.hpp"
+#include "wdigraph/graphio.hpp"
+#include "uwudgraph/apps/ssppr/ssppr_hubs.hpp"
+
+struct Options {
+    double alpha = 0.2;
+    double rmax = 1e-6;
+    double query_rmax = 0;
+    size_t budget_bytes = static_cast<size_t>(256) << 20;
+    size_t max_hubs = 0;
+    std::string dangling = "";
+    size_t bench = 0;
+    uint64_t seed = 1;
+    std::string save_path = "none";
+};
+
+template <class G>
+void run(const G *g, const Options &opt) {
+    auto start = std::chrono::steady_clock::now();
+    auto elapsed = [](std::chrono::steady_clock::time_point since) {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - since).count();
+    };
+    uwudgraph::HubIndex index = uwudgraph::build_hub_index(*g, opt.alpha, opt.rmax, opt.budget_bytes, opt.max_hubs,
+                                                           uwudgraph::parse_dangling(opt.dangling));
+    print("indexed", index.hubs().size(), "hubs,", index.entries(), "entries,", index.bytes(), "bytes in", elapsed(start), "seconds");
+    if (opt.save_path != "none") uwudgraph::save_hub_index(opt.save_path, index);
+    if (opt.bench == 0) return;
+
+    double rmax = opt.query_rmax > 0 ? opt.query_rmax : opt.rmax;
+    std::mt19937_64 rng(opt.seed);
+    double plain = 0, hubs = 0, diff = 0;
+    for (size_t i = 0; i < opt.bench; ++i) {
+        uwudgraph::node_id source = rng() % g->n;
+        start = std::chrono::steady_clock::now();
+        auto [ppr, r] = uwudgraph::ppr_forwardpush(*g, source, opt.alpha, rmax, index.dangling());
+        plain += elapsed(start);
+        start = std::chrono::steady_clock::now();
+        auto [ppr_hubs, r_hubs] = uwudgraph::ppr_forwardpush(*g, index, source, opt.alpha, rmax);
+        hubs += elapsed(start);
+        // both keep pi = ppr + sum_u r[u] * pi_u, so the estimates differ by at most the two residuals
+        double l1 = 0;
+        for (uwudgraph::node_id v = 0; v < g->n; ++v) l1 += std::abs(ppr[v] - ppr_hubs[v]);
+        diff = std::max(diff, l1);
+    }
+    print("push seconds per query: plain", plain / opt.bench, "with hubs", hubs / opt.bench, "speedup", plain / hubs,
+          "largest l1 difference", diff);
+}
+
+int main(int argc, char **argv) {
+    if (argc < 5) {
+        print("Usage: HubIndex <filename> <graph_type> <alpha> <save_path> [--args]");
+        print("Optional arguments (specified with --args):");
+        print("\t--rmax");
+        print("\t--budget_mb");
+        print("\t--max_hubs");
+        print("\t--threads");
+        print("\t--dangling [uniform | selfloop]");
+        print("\t--bench");
+        print("\t--query_rmax");
+        print("\t--seed");
+        return -1;
+    }
+
+    std::string filename = argv[1];
+    std::string graph_type = argv[2];
+    Options opt;
+    opt.alpha = std::stod(argv[3]);
+    opt.save_path = argv[4];
+
+    for (int i = 5; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--rmax") {
+            opt.rmax = std::stod(argv[++i]);
+        } else if (arg == "--budget_mb") {
+            opt.budget_bytes = static_cast<size_t>(std::stod(argv[++i]) * (1 << 20));
+        } else if (arg == "--max_hubs") {
+            opt.max_hubs = std::stoull(argv[++i]);
+        } else if (arg == "--threads") {
+            set_num_threads(std::stoull(argv[++i]));
+        } else if (arg == "--dangling") {
+            opt.dangling = argv[++i];
+        } else if (arg == "--bench") {
+            opt.bench = std::stoull(argv[++i]);
+        } else if (arg == "--query_rmax") {
+            opt.query_rmax = std::stod(argv[++i]);
+        } else if (arg == "--seed") {
+            opt.seed = std::stoull(argv[++i]);
+        } else {
+            print("Unknown argument: " + arg);
+            return -1;
+        }
+    }
+
+    bool directed = graph_type == "uwdigraph" || graph_type == "wdigraph";
+    if (opt.dangling.empty()) opt.dangling = directed ? "uniform" : "selfloop";
+
+    auto load = [&](const auto *g) {
+        run(g, opt);
+        delete g;
+    };
+    if (graph_type == "uwudgraph") {
+        load(uwudgraph::load_graph(filename));
+    } else if (graph_type == "wudgraph") {
+        load(wudgraph::load_edgelist(filename));
+    } else if (graph_type == "uwdigraph") {
+        load(uwdigraph::load_edgelist(filename));
+    } else if (graph_type == "wdigraph") {
+        load(wdigraph::load_edgelist(filename));
+    } else {
+        throw std::invalid_argument("Unsupported graph type for HubIndex: " + graph_type);
+    }
+    return 0;
+}
@@ -0,0 +1,128 @@
+/**
+ * This program drives an SSPPRServer with concurrent clients and reports throughput and latency.
+ *
+ * Usage:
+ *   LoadGen <socket> [--args]
+ *
+ * Arguments:
+ *   <socket>      : Path of the Unix domain socket of the server.
+ *
+ * Optional arguments (specified with --args):
+ *   --connections : Concurrent clients, one connection each (default 4).
+ *   --queries     : Queries per client (default 100).
+ *   --kind        : [ssppr | topk | pair] (default topk).
+ *   --k           : k of top-k queries (default 10).
+ *   --method      : SSPPR method of the queries (default fora).
+ *   --alpha       : Damping factor (default 0.2).
+ *   --eps         : Relative error (default as in SSPPR).
+ *   --sources     : Sources are drawn uniformly from the first this many nodes, so a small value makes
+ *                   queries repeat and hit the cache (default all nodes).
+ *   --seed        : Seed of the source sampling (default 1).
+ */
+
+#include <chrono>
+#include <random>
+#include <thread>
+
+#include "benchmark.hpp"
+#include "convenientPrint.hpp"
+
+#include "uwudgraph/apps/server/server.hpp"
+
+int main(int argc, char **argv) {
+    if (argc < 2) {
+        print("Usage: LoadGen <socket> [--args]");
+        print("Optional arguments (specified with --args):");
+        print("\t--connections");
+        print("\t--queries");
+        print("\t--kind [ssppr | topk | pair]");
+        print("\t--k");
+        print("\t--method");
+        print("\t--alpha");
+        print("\t--eps");
+        print("\t--sources");
+        print("\t--seed");
+        return -1;
+    }
+
+    std::string socket = argv[1];
+    size_t connections = 4;
+    size_t queries = 100;
+    std::string kind = "topk";
+    uint64_t k = 10;
+    uint64_t sources = 0;
+    uint64_t seed = 1;
+    uwudgraph::ServerRequest req;
+
+    for (int i = 2; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--connections") {
+            connections = std::stoull(argv[++i]);
+        } else if (arg == "--queries") {
+            queries = std::stoull(argv[++i]);
+        } else if (arg == "--kind") {
+            kind = argv[++i];
+        } else if (arg == "--k") {
+            k = std::stoull(argv[++i]);
+        } else if (arg == "--method") {
+            req.method = argv[++i];
+        } else if (arg == "--alpha") {
+            req.alpha = std::stod(argv[++i]);
+        } else if (arg == "--eps") {
+            req.eps = std::stod(argv[++i]);
+        } else if (arg == "--sources") {
+            sources = std::stoull(argv[++i]);
+        } else if (arg == "--seed") {
+            seed = std::stoull(argv[++i]);
+        } else {
+            print("Unknown argument: " + arg);
+            return -1;
+        }
+    }
+    if (kind != "ssppr" && kind != "topk" && kind != "pair") {
+        throw std::invalid_argument("Unsupported query kind: " + kind);
+    }
+
+    uwudgraph::ServerCounters before = uwudgraph::SSPPRClient(socket).info();
+    if (sources == 0 || sources > before.n) sources = before.n;
+
+    std::vector<std::vector<double>> latencies(connections);
+    std::vector<size_t> failures(connections, 0);
+    auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> clients;
+    for (size_t c = 0; c < connections; ++c) {
+        clients.emplace_back([&, c] {
+            uwudgraph::SSPPRClient client(socket);
+            std::mt19937_64 rng(seed * 1000003 + c);
+            std::uniform_int_distribution<uint64_t> pick(0, sources - 1);
+            uwudgraph::ServerRequest q = req;
+            for (size_t i = 0; i < queries; ++i) {
+                q.source = pick(rng);
+                auto t = std::chrono::steady_clock::now();
+                try {
+                    if (kind == "ssppr") client.ssppr(q);
+                    else if (kind == "topk") client.topk(q, k);
+                    else client.pair(q, pick(rng));
+                } catch (const std::runtime_error &e) {
+                    ++failures[c];
+                }
+                latencies[c].push_back(std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t).count());
+            }
+        });
+    }
+    for (std::thread &t : clients) t.join();
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    uwudgraph::ServerCounters after = uwudgraph::SSPPRClient(socket).info();
+
+    std::vector<double> all;
+    size_t failed = 0;
+    for (size_t c = 0; c < connections; ++c) {
+        all.insert(all.end(), latencies[c].begin(), latencies[c].end());
+        failed += failures[c];
+    }
+    LatencySummary s = summarize(all);
+    print("queries", s.count, "failed", failed, "in", seconds, "seconds,", s.count / seconds, "queries per second");
+    print("latency ms: median", s.median, "p99", s.p99, "mean", s.mean, "max", s.max);
+    print("cache hits", after.hits - before.hits, "misses", after.misses - before.misses);
+    return failed == 0 ? 0 : 1;
+}
@@ -0,0 +1,149 @@
+/**
+ * This program compares the work-stealing pool behind parallel.hpp with the ctpl_stl pool it replaced
+ * on parallel loops of different shapes.
+ *
+ * Usage:
+ *   PoolBench [--args]
+ *
+ * Optional arguments (specified with --args):
+ *   --threads     : Number of threads, the calling thread included (default all cores).
+ *   --n           : Indices per loop (default 1000000).
+ *   --grain       : Smallest chunk of the loops (default 1024).
+ *   --reps        : Timed runs of every loop (default 20).
+ *   --pin         : Pin the worker threads of the work-stealing pool to cores.
+ *
+ * Loops:
+ *   uniform       : y[i] = 2 * x[i] + 1, memory bound with little work per chunk.
+ *   small         : the uniform loop over n / 100 indices, dominated by scheduling overhead.
+ *   imbalanced    : index i costs about 64 * i / n iterations, so equal chunks take unequal time.
+ *   nested        : 64 outer iterations, each a parallel loop over n / 64 indices.
+ */
+
+#include <chrono>
+#include <cmath>
+#include <future>
+
+#include "benchmark.hpp"
+#include "convenientPrint.hpp"
+#include "multithread/ctpl_stl.h"
+#include "multithread/parallel.hpp"
+
+// the loop of parallel.hpp before the work-stealing pool: 4 chunks per thread on a ctpl pool, nested loops inline
+struct CtplLoops {
+    ctpl::thread_pool pool;
+    size_t threads;
+
+    CtplLoops(size_t threads) : pool(static_cast<int>(threads)), threads(threads) {}
+
+    static bool &in_worker() {
+        thread_local bool flag = false;
+        return flag;
+    }
+
+    template <typename F>
+    void for_chunks(size_t begin, size_t end, F &&f, size_t grain) {
+        size_t n = end - begin;
+        if (threads <= 1 || n <= grain || in_worker()) {
+            f(begin, end);
+            return;
+        }
+        size_t chunks = std::min(threads * 4, (n + grain - 1) / grain);
+        size_t step = (n + chunks - 1) / chunks;
+        std::vector<std::future<void>> futures;
+        for (size_t lo = begin + step; lo < end; lo += step) {
+            size_t hi = std::min(end, lo + step);
+            futures.emplace_back(pool.push([&f, lo, hi](int) {
+                in_worker() = true;
+                f(lo, hi);
+                in_worker() = false;
+            }));
+        }
+        in_worker() = true;
+        f(begin, std::min(end, begin + step));
+        in_worker() = false;
+        for (auto &fut : futures) fut.get();
+    }
+};
+
+// median milliseconds of reps runs of loop
+template <typename F>
+double time_loop(size_t reps, F &&loop) {
+    loop();
+    std::vector<double> samples;
+    for (size_t r = 0; r < reps; ++r) {
+        auto start = std::chrono::steady_clock::now();
+        loop();
+        samples.push_back(std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count());
+    }
+    return summarize(samples).median;
+}
+
+int main(int argc, char **argv) {
+    size_t threads = get_num_threads(), n = 1000000, grain = 1024, reps = 20;
+    bool pin = false;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--threads") {
+            threads = std::stoull(argv[++i]);
+        } else if (arg == "--n") {
+            n = std::stoull(argv[++i]);
+        } else if (arg == "--grain") {
+            grain = std::stoull(argv[++i]);
+        } else if (arg == "--reps") {
+            reps = std::stoull(argv[++i]);
+        } else if (arg == "--pin") {
+            pin = true;
+        } else {
+            print("Unknown argument: " + arg);
+            print("Usage: PoolBench [--args]");
+            print("Optional arguments (specified with --args):");
+            print("\t--threads");
+            print("\t--n");
+            print("\t--grain");
+            print("\t--reps");
+            print("\t--pin");
+            return -1;
+        }
+    }
+    set_num_threads(threads);
+    set_thread_pinning(pin);
+    // the old pool ran threads workers next to the calling thread
+    CtplLoops old(threads);
+
+    std::vector<double> x(n, 1.0), y(n);
+    auto uniform = [&](size_t lo, size_t hi) {
+        for (size_t i = lo; i < hi; ++i) y[i] = 2 * x[i] + 1;
+    };
+    auto imbalanced = [&](size_t lo, size_t hi) {
+        for (size_t i = lo; i < hi; ++i) {
+            double acc = x[i];
+            for (size_t k = 0; k < 64 * i / n; ++k) acc = std::sqrt(acc + k);
+            y[i] = acc;
+        }
+    };
+    size_t outer = 64, inner = n / outer;
+
+    print("threads", threads, "n", n, "grain", grain, "reps", reps, pin ? "pinned" : "");
+    auto report = [&](const std::string &name, double ctpl_ms, double ws_ms) {
+        print(name, ": ctpl", ctpl_ms, "ms, work-stealing", ws_ms, "ms, speedup", ctpl_ms / ws_ms);
+    };
+    report("uniform",
+           time_loop(reps, [&] { old.for_chunks(0, n, uniform, grain); }),
+           time_loop(reps, [&] { parallel_for_chunks(0, n, uniform, grain); }));
+    report("small",
+           time_loop(reps, [&] { old.for_chunks(0, n / 100, uniform, grain); }),
+           time_loop(reps, [&] { parallel_for_chunks(0, n / 100, uniform, grain); }));
+    report("imbalanced",
+           time_loop(reps, [&] { old.for_chunks(0, n, imbalanced, grain); }),
+           time_loop(reps, [&] { parallel_for_chunks(0, n, imbalanced, grain); }));
+    report("nested",
+           time_loop(reps, [&] {
+               old.for_chunks(0, outer, [&](size_t lo, size_t hi) {
+                   for (size_t o = lo; o < hi; ++o) old.for_chunks(o * inner, (o + 1) * inner, uniform, grain);
+               }, 1);
+           }),
+           time_loop(reps, [&] {
+               parallel_for(0, outer, [&](size_t o) { parallel_for_chunks(o * inner, (o + 1) * inner, uniform, grain); }, 1);
+           }));
+    return 0;
+}
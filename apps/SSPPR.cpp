@@ -5,11 +5,16 @@
  *   SSPPR <filename> <graph_type> <source> <alpha> <method> [--args]
  *
  * Arguments:
- *   <filename>    : Path to the input graph file.
- *   <graph_type>  : Type of the graph. Currently supported: "uwudgraph".
+ *   <filename>    : Path to the input graph file, or the socket of an SSPPRServer with graph type "server".
+ *   <graph_type>  : Type of the graph. Currently supported: "uwudgraph", "wudgraph", "uwdigraph", "wdigraph";
+ *                   "server" sends the query to a running SSPPRServer instead of loading the graph. The server
+ *                   takes --eps, --rmax, --rw_num and --deadline_ms and uses its own dangling policy; the other
+ *                   query arguments are rejected.
  *   <source>      : Source node for SSPPR computation.
  *   <alpha>       : Damping factor (teleport probability) for PageRank.
- *   <method>      : Method to compute SSPPR (e.g., "push", "rw", "fora", etc.).
+ *   <method>      : Method to compute SSPPR (e.g., "push", "rw", "fora", etc.); "auto" picks the method and rmax,
+ *                   "anytime" refines until --eps is reached or a budget runs out; push, rw, fora_skeleton, fora
+ *                   and speedppr with the suffix "_f32" keep their vectors as float.
  *
  * Optional arguments (specified with --args):
  *   --eps         : Convergence threshold for approximation methods.
@@ -20,14 +25,33 @@
  *   --pi_num      : Number of iterations for certain iterative methods.
  *   --sample_size : Sample size for probabilistic methods.
  *   --batch_size  : Batch size for batched processing methods.
+ *   --dangling    : [restart | uniform | selfloop], where walks go from nodes without out-edges
+ *                   (default restart on directed graphs, selfloop on undirected ones).
  *   --output      : [save | display | none] (default none).
  *   --save_path   : Path to save the output if --output is set to "save".
+ *   --stats       : Print the work counters and phase timers of the query; the kernels only count
+ *                   when built with make STATS=1, see uwudgraph/apps/ssppr/ssppr_stats.hpp.
+ *   --trace       : Path to write a Chrome trace (chrome://tracing, ui.perfetto.dev) of the load, the query
+ *                   phases and the thread pool chunks.
+ *   --deadline_ms : Wall-time budget of an "anytime" query (default none).
+ *   --work_budget : Edges scanned plus walk steps allowed to an "anytime" query (default none).
+ *   --topk        : With "server", display the k largest values only.
+ *   --target      : With "server", display the value of this node only.
+ *   --seeds       : File of seed nodes, one per line with an optional weight; personalizes over the seeds in one
+ *                   computation instead of <source> (push, rw, fora_skeleton and fora; other methods sum per seed).
  */
 
+#include <chrono>
+
 #include "convenientPrint.hpp"
 #include "serialize.hpp"
+#include "trace.hpp"
 
 #include "uwudgraph/apps/ssppr/ssppr.hpp"
+#include "wudgraph/apps/ssppr/ssppr.hpp"
+#include "uwdigraph/apps/ssppr/ssppr.hpp"
+#include "wdigraph/apps/ssppr/ssppr.hpp"
+#include "uwudgraph/apps/server/server.hpp"
 
 int main(int argc, char **argv) {
     if (argc < 5) {
@@ -41,6 +65,16 @@ int main(int argc, char **argv) {
         print("\t--pi_num");
         print("\t--sample_size");
         print("\t--batch_size");
+        print("\t--dangling [restart | uniform | selfloop]");
+        print("\t--output [save | display | none]");
+        print("\t--save_path");
+        print("\t--stats");
+        print("\t--trace");
+        print("\t--deadline_ms");
+        print("\t--work_budget");
+        print("\t--topk");
+        print("\t--target");
+        print("\t--seeds");
         return -1;
     }
 
@@ -58,8 +92,15 @@ int main(int argc, char **argv) {
     size_t pi_num = 0;
     size_t sample_size = 0;
     size_t batch_size = 0;
+    std::string dangling = "";
     std::string output = "";
     std::string save_path = "";
+    bool show_stats = false;
+    std::string trace = "";
+    uwudgraph::AnytimeControl anytime;
+    size_t topk = 0;
+    std::string target = "";
+    std::string seeds = "";
 
     for (int i = 6; i < argc; ++i) {
         std::string arg = argv[i];
@@ -79,29 +120,145 @@ int main(int argc, char **argv) {
             sample_size = std::stoull(argv[++i]);
         } else if (arg == "--batch_size") {
             batch_size = std::stoull(argv[++i]);
+        } else if (arg == "--dangling") {
+            dangling = argv[++i];
         } else if (arg == "--output") {
             output = argv[++i];
         } else if (arg == "--save_path") {
             save_path = argv[++i];
+        } else if (arg == "--stats") {
+            show_stats = true;
+        } else if (arg == "--trace") {
+            trace = argv[++i];
+        } else if (arg == "--deadline_ms") {
+            anytime.budget.seconds = std::stod(argv[++i]) / 1000;
+        } else if (arg == "--work_budget") {
+            anytime.budget.work = std::stoull(argv[++i]);
+        } else if (arg == "--topk") {
+            topk = std::stoull(argv[++i]);
+        } else if (arg == "--target") {
+            target = argv[++i];
+        } else if (arg == "--seeds") {
+            seeds = argv[++i];
         } else {
             print("Unknown argument: " + arg);
             return -1;
         }
     }
 
+    if (graph_type == "server") {
+        // the protocol carries none of these, so they would be ignored
+        std::vector<std::string> unsupported;
+        if (delta != 0) unsupported.push_back("--delta");
+        if (pf != 0) unsupported.push_back("--pf");
+        if (pi_num != 0) unsupported.push_back("--pi_num");
+        if (sample_size != 0) unsupported.push_back("--sample_size");
+        if (batch_size != 0) unsupported.push_back("--batch_size");
+        if (!dangling.empty()) unsupported.push_back("--dangling");
+        if (anytime.budget.work != uwudgraph::SSPPRBudget().work) unsupported.push_back("--work_budget");
+        if (!seeds.empty()) unsupported.push_back("--seeds");
+        if (!trace.empty()) unsupported.push_back("--trace");
+        if (!unsupported.empty()) {
+            print("Not supported with graph type server:", unsupported);
+            return -1;
+        }
+        uwudgraph::SSPPRClient client(filename);
+        uwudgraph::ServerRequest req;
+        req.source = std::stoull(source_str);
+        req.alpha = alpha;
+        req.method = method;
+        req.eps = eps;
+        req.rmax = rmax;
+        req.rw_num = rw_num;
+        if (anytime.budget.seconds < std::numeric_limits<double>::infinity()) req.deadline_ms = anytime.budget.seconds * 1000;
+        auto start = std::chrono::steady_clock::now();
+        if (topk > 0) {
+            for (const auto &entry : client.topk(req, topk)) print(entry.first, entry.second);
+        } else if (!target.empty()) {
+            print("PPR of", target, ":", client.pair(req, std::stoull(target)));
+        } else {
+            std::vector<double> ppr = client.ssppr(req);
+            if (output == "display") {
+                print("source:", source_str, "alpha:", alpha);
+                print("PPR:", ppr);
+            } else if (output == "save") {
+                save_file(save_path, ppr);
+            }
+        }
+        if (show_stats) {
+            print("round trip seconds:", std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+        }
+        return 0;
+    }
+
+    bool directed = graph_type == "uwdigraph" || graph_type == "wdigraph";
+    if (dangling.empty()) dangling = directed ? "restart" : "selfloop";
+    if (!trace.empty()) trace_enable(trace);
+
+    uwudgraph::SSPPRStats stats;
+    auto start = std::chrono::steady_clock::now();
     std::vector<double> ppr;
-    if (graph_type == "uwudgraph") {
-        ppr = uwudgraph::SSPPR(filename, source_str, alpha, method, eps, delta, pf, rmax, rw_num, pi_num, sample_size, batch_size);
+    if (!seeds.empty()) {
+        uwudgraph::SeedSet seed_set = uwudgraph::load_seeds(seeds);
+        auto run = [&](const auto *g) {
+            std::vector<double> res = uwudgraph::SSPPR(*g, seed_set, alpha, method, eps, delta, pf, rmax, rw_num, pi_num, sample_size, batch_size,
+                                                       uwudgraph::parse_dangling(dangling), &stats);
+            delete g;
+            return res;
+        };
+        if (graph_type == "uwudgraph") {
+            ppr = run(uwudgraph::load_graph(filename));
+        } else if (graph_type == "wudgraph") {
+            ppr = run(wudgraph::load_edgelist(filename));
+        } else if (graph_type == "uwdigraph") {
+            ppr = run(uwdigraph::load_edgelist(filename));
+        } else if (graph_type == "wdigraph") {
+            ppr = run(wdigraph::load_edgelist(filename));
+        } else {
+            throw std::invalid_argument("Unsupported graph type for SSPPR: " + graph_type);
+        }
+        source_str = seeds;
+    } else if (graph_type == "uwudgraph") {
+        ppr = uwudgraph::SSPPR(filename, source_str, alpha, method, eps, delta, pf, rmax, rw_num, pi_num, sample_size, batch_size, dangling, &stats, &anytime);
+    } else if (graph_type == "wudgraph") {
+        ppr = wudgraph::SSPPR(filename, source_str, alpha, method, eps, delta, pf, rmax, rw_num, pi_num, sample_size, batch_size, dangling, &stats, &anytime);
+    } else if (graph_type == "uwdigraph") {
+        ppr = uwdigraph::SSPPR(filename, source_str, alpha, method, eps, delta, pf, rmax, rw_num, pi_num, sample_size, batch_size, dangling, &stats, &anytime);
+    } else if (graph_type == "wdigraph") {
+        ppr = wdigraph::SSPPR(filename, source_str, alpha, method, eps, delta, pf, rmax, rw_num, pi_num, sample_size, batch_size, dangling, &stats, &anytime);
     } else {
         throw std::invalid_argument("Unsupported graph type for SSPPR: " + graph_type);
     }
 
+    double query_seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    start = std::chrono::steady_clock::now();
     if (output == "display") {
         print("source:", source_str, "alpha:", alpha);
         print("PPR:", ppr);
     } else if (output == "save") {
         save_file(save_path, ppr);
     }
+    double output_seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    if (method == "anytime") {
+        const uwudgraph::AnytimeResult &res = anytime.result;
+        print("anytime: stopped by", uwudgraph::anytime_stop_name(res.stop), "after", res.seconds, "seconds,", res.work, "work,",
+              res.rounds, "rounds; relative error bound", res.error_bound, "above delta, residual", res.residual, "walks", res.walks);
+    }
+
+    if (show_stats) {
+        print("load + query seconds:", query_seconds, "output seconds:", output_seconds);
+        if (!uwudgraph::ssppr_stats_enabled) {
+            print("Kernel counters are compiled out, rebuild with make clean && make STATS=1");
+        } else {
+            print("push seconds:", stats.push_seconds, "walk seconds:", stats.walk_seconds,
+                  "iterate seconds:", stats.iterate_seconds);
+            print("pushes:", stats.pushes, "edges scanned:", stats.edges_scanned,
+                  "queue high-water:", stats.queue_high_water, "scan epochs:", stats.scan_epochs);
+            print("walks:", stats.walks, "walk steps:", stats.walk_steps, "allocated bytes:", stats.alloc_bytes);
+        }
+    }
 
     return 0;
 }
\ No newline at end of file
@@ -0,0 +1,100 @@
+/**
+ * This program loads a graph once and answers SSPPR, top-k and pair queries over a Unix domain socket
+ * until a client sends a stop request. Clients are SSPPR with graph type "server" and LoadGen.
+ *
+ * Usage:
+ *   SSPPRServer <filename> <graph_type> [--args]
+ *
+ * Arguments:
+ *   <filename>    : Path to the input graph file.
+ *   <graph_type>  : Type of the graph. Currently supported: "uwudgraph", "wudgraph", "uwdigraph", "wdigraph".
+ *
+ * Optional arguments (specified with --args):
+ *   --socket      : Path of the Unix domain socket (default /tmp/ssppr.sock).
+ *   --threads     : Query threads (default all cores).
+ *   --max_pending : Queued queries before connections wait (default 1024).
+ *   --cache_mb    : Megabytes of cached PPR vectors (default 256).
+ *   --dangling    : [restart | uniform | selfloop] (default restart on directed graphs, selfloop on undirected ones).
+ */
+
+#include <chrono>
+
+#include "convenientPrint.hpp"
+
+#include "uwudgraph/graphio.hpp"
+#include "wudgraph/graphio.hpp"
+#include "uwdigraph/graphio.hpp"
+#include "wdigraph/graphio.hpp"
+#include "uwudgraph/apps/server/server.hpp"
+
+template <class G>
+void serve(G *g, const uwudgraph::ServerConfig &config, double load_seconds) {
+    {
+        uwudgraph::SSPPRServer<G> server(*g, config);
+        print("loaded", g->n, "nodes and", g->m, "edges in", load_seconds, "seconds, serving on", config.socket);
+        server.run();
+        uwudgraph::ServerCounters c = server.counters();
+        print("stopped; cache hits", c.hits, "misses", c.misses);
+    }
+    delete g;
+}
+
+int main(int argc, char **argv) {
+    if (argc < 3) {
+        print("Usage: SSPPRServer <filename> <graph_type> [--args]");
+        print("Optional arguments (specified with --args):");
+        print("\t--socket");
+        print("\t--threads");
+        print("\t--max_pending");
+        print("\t--cache_mb");
+        print("\t--dangling [restart | uniform | selfloop]");
+        return -1;
+    }
+
+    std::string filename = argv[1];
+    std::string graph_type = argv[2];
+
+    uwudgraph::ServerConfig config;
+    config.socket = "/tmp/ssppr.sock";
+    std::string dangling = "";
+
+    for (int i = 3; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--socket") {
+            config.socket = argv[++i];
+        } else if (arg == "--threads") {
+            config.threads = std::stoull(argv[++i]);
+        } else if (arg == "--max_pending") {
+            config.max_pending = std::stoull(argv[++i]);
+        } else if (arg == "--cache_mb") {
+            config.cache_bytes = static_cast<size_t>(std::stod(argv[++i]) * (1 << 20));
+        } else if (arg == "--dangling") {
+            dangling = argv[++i];
+        } else {
+            print("Unknown argument: " + arg);
+            return -1;
+        }
+    }
+
+    bool directed = graph_type == "uwdigraph" || graph_type == "wdigraph";
+    config.dangling = uwudgraph::parse_dangling(dangling.empty() ? (directed ? "restart" : "selfloop") : dangling);
+
+    auto start = std::chrono::steady_clock::now();
+    auto elapsed = [&] { return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count(); };
+    if (graph_type == "uwudgraph") {
+        uwudgraph::Graph *g = uwudgraph::load_graph(filename);
+        serve(g, config, elapsed());
+    } else if (graph_type == "wudgraph") {
+        wudgraph::Graph *g = wudgraph::load_edgelist(filename);
+        serve(g, config, elapsed());
+    } else if (graph_type == "uwdigraph") {
+        uwdigraph::Graph *g = uwdigraph::load_edgelist(filename);
+        serve(g, config, elapsed());
+    } else if (graph_type == "wdigraph") {
+        wdigraph::Graph *g = wdigraph::load_edgelist(filename);
+        serve(g, config, elapsed());
+    } else {
+        throw std::invalid_argument("Unsupported graph type for SSPPRServer: " + graph_type);
+    }
+    return 0;
+}
@@ -0,0 +1,109 @@
+/**
+ * This program computes a spectral sparsifier of a graph by sampling edges by importance and reweighting them.
+ *
+ * Usage:
+ *   Sparsify <filename> <graph_type> <method> [--args]
+ *
+ * Arguments:
+ *   <filename>    : Path to the input graph file.
+ *   <graph_type>  : Type of the graph. Currently supported: "uwudgraph".
+ *   <method>      : Edge importance: "resistance" (sketched effective resistance) or "degree" (1/d_u + 1/d_v).
+ *
+ * Optional arguments (specified with --args):
+ *   --eps         : Target relative error of quadratic forms (default 0.5).
+ *   --budget      : Expected number of edges to keep, overrides --eps.
+ *   --sketch_dim  : Dimension of the resistance sketch (default 24 ln(n)).
+ *   --seed        : Sampling seed (default 1).
+ *   --threads     : Number of threads (default all cores).
+ *   --verify      : Number of random test vectors for reporting quadratic-form distortion (default 0).
+ *   --output      : [save | display | none] (default none).
+ *   --format      : [text | bin] output format when saving (default text).
+ *   --save_path   : Path to save the output if --output is set to "save".
+ */
+
+#include <chrono>
+
+#include "convenientPrint.hpp"
+
+#include "uwudgraph/graphio.hpp"
+#include "uwudgraph/apps/sparsify/sparsify.hpp"
+
+int main(int argc, char **argv) {
+    if (argc < 4) {
+        print("Usage: Sparsify <filename> <graph_type> <method> [--args]");
+        print("Optional arguments (specified with --args):");
+        print("\t--eps");
+        print("\t--budget");
+        print("\t--sketch_dim");
+        print("\t--seed");
+        print("\t--threads");
+        print("\t--verify");
+        print("\t--output");
+        print("\t--format");
+        print("\t--save_path");
+        return -1;
+    }
+
+    std::string filename = argv[1];
+    std::string graph_type = argv[2];
+    std::string method = argv[3];
+
+    double eps = 0.5;
+    size_t budget = 0;
+    size_t sketch_dim = 0;
+    uint64_t seed = 1;
+    size_t verify = 0;
+    std::string output = "";
+    std::string format = "text";
+    std::string save_path = "";
+
+    for (int i = 4; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--eps") {
+            eps = std::stod(argv[++i]);
+        } else if (arg == "--budget") {
+            budget = std::stoull(argv[++i]);
+        } else if (arg == "--sketch_dim") {
+            sketch_dim = std::stoull(argv[++i]);
+        } else if (arg == "--seed") {
+            seed = std::stoull(argv[++i]);
+        } else if (arg == "--threads") {
+            set_num_threads(std::stoull(argv[++i]));
+        } else if (arg == "--verify") {
+            verify = std::stoull(argv[++i]);
+        } else if (arg == "--output") {
+            output = argv[++i];
+        } else if (arg == "--format") {
+            format = argv[++i];
+        } else if (arg == "--save_path") {
+            save_path = argv[++i];
+        } else {
+            print("Unknown argument: " + arg);
+            return -1;
+        }
+    }
+
+    if (graph_type != "uwudgraph") {
+        throw std::invalid_argument("Unsupported graph type for Sparsify: " + graph_type);
+    }
+    uwudgraph::Graph* g = uwudgraph::load_graph(filename);
+
+    auto start = std::chrono::steady_clock::now();
+    std::vector<uwudgraph::weighted_edge> sparse = uwudgraph::sparsify(*g, method, eps, budget, sketch_dim, seed);
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    print("nodes:", g->n, "edges:", g->m, "kept:", sparse.size(), "seconds:", seconds);
+
+    if (verify > 0) {
+        uwudgraph::DistortionReport report = uwudgraph::quadratic_form_distortion(*g, sparse, verify);
+        print("quadratic-form distortion over", report.trials, "vectors: mean", report.mean, "max", report.max);
+    }
+
+    if (output == "display") {
+        for (const auto& [u, v, w] : sparse) print(u, v, w);
+    } else if (output == "save") {
+        uwudgraph::save_sparsifier(save_path, g->n, sparse, format);
+    }
+
+    delete g;
+    return 0;
+}
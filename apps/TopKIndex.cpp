@@ -0,0 +1,134 @@
+/**
+ * This program builds the index of the approximate top-k PPR neighbors of every node, or looks nodes up in it
+ * (see uwudgraph/apps/topk_index/topk_index.hpp).
+ *
+ * Usage:
+ *   TopKIndex build <filename> <graph_type> <index_path> [--args]
+ *   TopKIndex lookup <index_path> <node> [<node> ...]
+ *
+ * Arguments:
+ *   <filename>    : Path to the input graph file.
+ *   <graph_type>  : Type of the graph. Currently supported: "uwudgraph", "wudgraph", "uwdigraph", "wdigraph".
+ *   <index_path>  : Path of the index; a build keeps its checkpoint in <index_path>.ckpt and <index_path>.part.
+ *   <node>        : Node to print the top-k neighbors and scores of.
+ *
+ * Optional arguments of build (specified with --args):
+ *   --k           : Neighbors per node (default 16).
+ *   --alpha       : Damping factor (default 0.2).
+ *   --rmax        : Residual threshold of the pushes (default 1e-5).
+ *   --chunk       : Sources between checkpoints (default 65536).
+ *   --threads     : Number of threads (default all cores).
+ *   --dangling    : [restart | selfloop] (default restart on directed graphs, selfloop on undirected ones); uniform
+ *                   is refused, its jump mass would touch every node from every source.
+ * SIGINT and SIGTERM stop a build after its current chunk; running build again resumes it.
+ */
+
+#include <atomic>
+#include <chrono>
+#include <csignal>
+
+#include "convenientPrint.hpp"
+#include "multithread/parallel.hpp"
+
+#include "uwudgraph/graphio.hpp"
+#include "wudgraph/graphio.hpp"
+#include "uwdigraph/graphio.hpp"
+#include "wdigraph/graphio.hpp"
+#include "uwudgraph/apps/topk_index/topk_index.hpp"
+
+std::atomic<bool> stop_requested(false);
+
+void request_stop(int) {
+    stop_requested = true;
+}
+
+template <class G>
+int build(const G *g, std::string index_path, const uwudgraph::TopKIndexConfig &config, double load_seconds) {
+    print("loaded", g->n, "nodes and", g->m, "edges in", load_seconds, "seconds");
+    auto start = std::chrono::steady_clock::now();
+    bool finished = uwudgraph::build_topk_index(*g, index_path, config, &stop_requested);
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    delete g;
+    if (!finished) {
+        print("stopped after", seconds, "seconds; run again to resume from", index_path + ".ckpt");
+        return 1;
+    }
+    print("built", index_path, "in", seconds, "seconds");
+    return 0;
+}
+
+int main(int argc, char **argv) {
+    std::string mode = argc > 1 ? argv[1] : "";
+    if ((mode != "build" || argc < 5) && (mode != "lookup" || argc < 4)) {
+        print("Usage: TopKIndex build <filename> <graph_type> <index_path> [--args]");
+        print("       TopKIndex lookup <index_path> <node> [<node> ...]");
+        print("Optional arguments of build (specified with --args):");
+        print("\t--k");
+        print("\t--alpha");
+        print("\t--rmax");
+        print("\t--chunk");
+        print("\t--threads");
+        print("\t--dangling [restart | selfloop]");
+        return -1;
+    }
+
+    if (mode == "lookup") {
+        uwudgraph::TopKIndex index(argv[2]);
+        std::vector<std::pair<uwudgraph::node_id, float>> top;
+        for (int i = 3; i < argc; ++i) {
+            index.lookup(std::stoull(argv[i]), top);
+            print("node", argv[i], ":");
+            for (const auto &entry : top) print(entry.first, entry.second);
+        }
+        return 0;
+    }
+
+    std::string filename = argv[2];
+    std::string graph_type = argv[3];
+    std::string index_path = argv[4];
+    uwudgraph::TopKIndexConfig config;
+    std::string dangling = "";
+
+    for (int i = 5; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--k") {
+            config.k = std::stoull(argv[++i]);
+        } else if (arg == "--alpha") {
+            config.alpha = std::stod(argv[++i]);
+        } else if (arg == "--rmax") {
+            config.rmax = std::stod(argv[++i]);
+        } else if (arg == "--chunk") {
+            config.chunk = std::stoull(argv[++i]);
+        } else if (arg == "--threads") {
+            set_num_threads(std::stoull(argv[++i]));
+        } else if (arg == "--dangling") {
+            dangling = argv[++i];
+        } else {
+            print("Unknown argument: " + arg);
+            return -1;
+        }
+    }
+
+    bool directed = graph_type == "uwdigraph" || graph_type == "wdigraph";
+    config.dangling = uwudgraph::parse_dangling(dangling.empty() ? (directed ? "restart" : "selfloop") : dangling);
+    std::signal(SIGINT, request_stop);
+    std::signal(SIGTERM, request_stop);
+
+    auto start = std::chrono::steady_clock::now();
+    auto elapsed = [&] { return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count(); };
+    if (graph_type == "uwudgraph") {
+        uwudgraph::Graph *g = uwudgraph::load_graph(filename);
+        return build(g, index_path, config, elapsed());
+    } else if (graph_type == "wudgraph") {
+        wudgraph::Graph *g = wudgraph::load_edgelist(filename);
+        return build(g, index_path, config, elapsed());
+    } else if (graph_type == "uwdigraph") {
+        uwdigraph::Graph *g = uwdigraph::load_edgelist(filename);
+        return build(g, index_path, config, elapsed());
+    } else if (graph_type == "wdigraph") {
+        wdigraph::Graph *g = wdigraph::load_edgelist(filename);
+        return build(g, index_path, config, elapsed());
+    } else {
+        throw std::invalid_argument("Unsupported graph type for TopKIndex: " + graph_type);
+    }
+}
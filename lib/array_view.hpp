@@ -0,0 +1,31 @@
+/*
+  array_view is a non-owning, read-only view of a contiguous array, used to expose
+  slices of flat (CSR) storage without copying. It supports range-for, size() and operator[].
+
+  Example usage:
+    std::vector<uint32_t> data = {1, 2, 3, 4};
+    array_view<uint32_t> v(data.data() + 1, 2);
+    for (uint32_t x : v) std::cout << x << " "; // Output: 2 3
+*/
+
+#pragma once
+
+#include <cstddef>
+
+template <typename T>
+class array_view {
+private:
+  const T* _data;
+  size_t _size;
+
+public:
+  array_view() : _data(nullptr), _size(0) { }
+  array_view(const T* data, size_t size) : _data(data), _size(size) { }
+
+  const T* begin() const noexcept { return _data; }
+  const T* end() const noexcept { return _data + _size; }
+  const T* data() const noexcept { return _data; }
+  size_t size() const noexcept { return _size; }
+  bool empty() const noexcept { return _size == 0; }
+  const T& operator[](size_t i) const { return _data[i]; }
+};
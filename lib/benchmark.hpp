@@ -0,0 +1,125 @@
+/*
+  This header file provides the measurement side of the benchmark harness: latency summaries,
+  the peak resident set size of the process, a graph wrapper that counts the work done by the
+  SSPPR kernels, and a CSV reader for comparing a run against a stored baseline.
+
+  Example usage:
+  - Summarize per-query latencies (in milliseconds):
+    LatencySummary s = summarize(latencies);   // s.median, s.p99, s.mean, s.count
+
+  - Count pushes and walk steps of a kernel without touching it:
+    CountingGraph<uwudgraph::Graph> cg(g);
+    ppr_fora(cg, source, alpha, eps, delta, pf);
+    print(cg.scans, cg.steps);
+
+  - Peak RSS of the process so far, in kilobytes:
+    size_t kb = peak_rss_kb();
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <sys/resource.h>
+
+struct LatencySummary {
+    size_t count = 0;
+    double median = 0;
+    double p99 = 0;
+    double mean = 0;
+    double min = 0;
+    double max = 0;
+};
+
+// nearest-rank percentiles of the samples
+inline LatencySummary summarize(std::vector<double> samples) {
+    LatencySummary s;
+    s.count = samples.size();
+    if (samples.empty()) return s;
+    std::sort(samples.begin(), samples.end());
+    auto rank = [&](double q) {
+        size_t i = static_cast<size_t>(std::ceil(q * samples.size()));
+        return samples[i ? i - 1 : 0];
+    };
+    s.median = rank(0.5);
+    s.p99 = rank(0.99);
+    s.min = samples.front();
+    s.max = samples.back();
+    for (double x : samples) s.mean += x / samples.size();
+    return s;
+}
+
+// peak resident set size of the process, never decreases
+inline size_t peak_rss_kb() {
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    return usage.ru_maxrss;
+}
+
+// Forwards the graph interface used by the SSPPR kernels and counts
+//     scans : rows scanned by for_each_neighbor, i.e. pushes (and rows of matrix products in ppw)
+//     edges : entries of those rows
+//     steps : random-walk steps taken by rand_neighbor
+template <class G>
+class CountingGraph {
+public:
+    const G &g;
+    decltype(G::n) n;
+    decltype(G::m) m;
+    mutable size_t scans = 0;
+    mutable size_t edges = 0;
+    mutable size_t steps = 0;
+
+    CountingGraph(const G &g) : g(g), n(g.n), m(g.m) {}
+
+    auto get_degree(decltype(G::n) u) const { return g.get_degree(u); }
+    auto get_neighbor_count(decltype(G::n) u) const { return g.get_neighbor_count(u); }
+    decltype(auto) get_neighbors(decltype(G::n) u) const { return g.get_neighbors(u); }
+    double get_total_weight() const { return g.get_total_weight(); }
+
+    template <typename F>
+    void for_each_neighbor(decltype(G::n) u, F &&f) const {
+        ++scans;
+        edges += g.get_neighbor_count(u);
+        g.for_each_neighbor(u, std::forward<F>(f));
+    }
+
+    auto rand_neighbor(decltype(G::n) u) const {
+        ++steps;
+        return g.rand_neighbor(u);
+    }
+};
+
+// Reads a CSV file with a header line into rows of column name -> value.
+inline std::vector<std::map<std::string, std::string>> read_csv(const std::string &filename) {
+    std::ifstream is(filename);
+    if (!is.is_open()) {
+        throw std::runtime_error("Could not open file: " + filename);
+    }
+    auto split = [](const std::string &line) {
+        std::vector<std::string> cells;
+        std::stringstream ss(line);
+        std::string cell;
+        while (std::getline(ss, cell, ',')) cells.push_back(cell);
+        return cells;
+    };
+    std::string line;
+    std::getline(is, line);
+    std::vector<std::string> header = split(line);
+    std::vector<std::map<std::string, std::string>> rows;
+    while (std::getline(is, line)) {
+        if (line.empty()) continue;
+        std::vector<std::string> cells = split(line);
+        std::map<std::string, std::string> row;
+        for (size_t i = 0; i < header.size() && i < cells.size(); ++i) row[header[i]] = cells[i];
+        rows.push_back(row);
+    }
+    return rows;
+}
@@ -0,0 +1,99 @@
+/*
+  This header file provides the dense linear algebra needed by the spectral solvers:
+  parallel level-1 operations on std::vector<double> and a Jacobi eigensolver for the
+  small symmetric matrices produced by Krylov methods.
+
+  Example usage:
+  - Level-1 operations:
+    double d = dot(x, y);        // <x, y>
+    double l = norm2(x);         // ||x||_2
+    axpy(0.5, x, y);             // y += 0.5 * x
+    scale(2.0, x);               // x *= 2
+
+  - Eigen-decomposition of a small symmetric matrix (row-major, m x m):
+    std::vector<double> evals, evecs;
+    sym_eig(A, m, evals, evecs); // A = evecs * diag(evals) * evecs^T, evecs column j is eigenvector j
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <vector>
+
+#include "multithread/parallel.hpp"
+
+inline double dot(const std::vector<double> &x, const std::vector<double> &y) {
+    return parallel_reduce(0, x.size(), 0.0, [&](size_t i) { return x[i] * y[i]; }, std::plus<double>(), 4096);
+}
+
+inline double norm2(const std::vector<double> &x) {
+    return std::sqrt(dot(x, x));
+}
+
+// y += a * x
+inline void axpy(double a, const std::vector<double> &x, std::vector<double> &y) {
+    parallel_for(0, x.size(), [&](size_t i) { y[i] += a * x[i]; }, 4096);
+}
+
+// x *= a
+inline void scale(double a, std::vector<double> &x) {
+    parallel_for(0, x.size(), [&](size_t i) { x[i] *= a; }, 4096);
+}
+
+// Cyclic Jacobi eigensolver for a symmetric m x m row-major matrix.
+// Eigenvalues are returned in descending order, evecs is row-major with eigenvector j in column j.
+inline void sym_eig(std::vector<double> a, size_t m, std::vector<double> &evals, std::vector<double> &evecs,
+                    size_t max_sweeps = 100) {
+    evecs.assign(m * m, 0.0);
+    for (size_t i = 0; i < m; ++i) evecs[i * m + i] = 1.0;
+
+    for (size_t sweep = 0; sweep < max_sweeps; ++sweep) {
+        double off = 0, total = 0;
+        for (size_t i = 0; i < m; ++i) {
+            for (size_t j = 0; j < m; ++j) {
+                total += a[i * m + j] * a[i * m + j];
+                if (i != j) off += a[i * m + j] * a[i * m + j];
+            }
+        }
+        if (off <= 1e-30 * total || off == 0) break;
+
+        for (size_t p = 0; p < m; ++p) {
+            for (size_t q = p + 1; q < m; ++q) {
+                double apq = a[p * m + q];
+                if (std::abs(apq) < 1e-300) continue;
+                double theta = (a[q * m + q] - a[p * m + p]) / (2 * apq);
+                double t = (theta >= 0 ? 1.0 : -1.0) / (std::abs(theta) + std::sqrt(theta * theta + 1));
+                double c = 1.0 / std::sqrt(t * t + 1), s = t * c;
+                for (size_t k = 0; k < m; ++k) {
+                    double akp = a[k * m + p], akq = a[k * m + q];
+                    a[k * m + p] = c * akp - s * akq;
+                    a[k * m + q] = s * akp + c * akq;
+                }
+                for (size_t k = 0; k < m; ++k) {
+                    double apk = a[p * m + k], aqk = a[q * m + k];
+                    a[p * m + k] = c * apk - s * aqk;
+                    a[q * m + k] = s * apk + c * aqk;
+                }
+                for (size_t k = 0; k < m; ++k) {
+                    double vkp = evecs[k * m + p], vkq = evecs[k * m + q];
+                    evecs[k * m + p] = c * vkp - s * vkq;
+                    evecs[k * m + q] = s * vkp + c * vkq;
+                }
+            }
+        }
+    }
+
+    // sort eigenpairs in descending order of eigenvalue
+    std::vector<size_t> order(m);
+    for (size_t i = 0; i < m; ++i) order[i] = i;
+    std::sort(order.begin(), order.end(), [&](size_t i, size_t j) { return a[i * m + i] > a[j * m + j]; });
+    std::vector<double> sorted(m * m);
+    evals.resize(m);
+    for (size_t j = 0; j < m; ++j) {
+        evals[j] = a[order[j] * m + order[j]];
+        for (size_t k = 0; k < m; ++k) sorted[k * m + j] = evecs[k * m + order[j]];
+    }
+    evecs.swap(sorted);
+}
@@ -0,0 +1,281 @@
+/*
+  This header file provides the allocation layer for large arrays: graph storage, per-query workspaces and
+  scratch memory. Arrays of 2MB and more are mapped with mmap, aligned to 2MB and advised for transparent
+  huge pages, so random accesses into large CSR arrays miss the TLB far less often. On machines with several
+  NUMA nodes the pages of such arrays are interleaved over all nodes (the default, for arrays every thread
+  reads), or left to first-touch placement, where a page lands on the node of the thread that first writes
+  it. Smaller arrays come from the ordinary heap, and on other systems than Linux everything does.
+  Workspaces stay std::vector: assign_workspace advises their storage before it is first written, which the
+  calling thread then does, so they are local to it. Arena hands out scratch memory from a bump pointer and
+  releases it all at once.
+
+  Example usage:
+  - A vector on huge pages, placed by the NUMA policy:
+    huge_vector<uint32_t> targets(m);
+
+  - Size a workspace so that it is written, and so placed, in huge pages by the calling thread:
+    assign_workspace(ppr, g.n, 0.0);
+
+  - Place large arrays allocated from now on by first touch instead of interleaving them:
+    set_numa_policy(NumaPolicy::first_touch);
+
+  - Turn huge pages off, e.g. to measure what they gain:
+    set_huge_pages(false);
+
+  - Scratch memory that lives until the next reset, one arena per thread:
+    Arena arena;
+    uint8_t* buf = arena.allocate<uint8_t>(64);
+    arena.reset();
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <new>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#ifdef __linux__
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+enum class NumaPolicy { first_touch, interleave };
+
+namespace __memory_detail {
+
+constexpr size_t huge_page = size_t(1) << 21;
+
+inline std::atomic<bool> &huge_pages_on() {
+    static std::atomic<bool> on(true);
+    return on;
+}
+
+inline std::atomic<int> &numa_policy_value() {
+    static std::atomic<int> policy(static_cast<int>(NumaPolicy::interleave));
+    return policy;
+}
+
+inline size_t round_up(size_t bytes) {
+    return (bytes + huge_page - 1) & ~(huge_page - 1);
+}
+
+// Node mask of the online NUMA nodes, read from a list like "0-1,3"; empty with a single node.
+inline const std::vector<unsigned long> &numa_nodes() {
+    static const std::vector<unsigned long> mask = [] {
+        constexpr size_t bits = 8 * sizeof(unsigned long);
+        std::vector<unsigned long> mask;
+        std::ifstream file("/sys/devices/system/node/online");
+        std::string list, range;
+        size_t count = 0;
+        if (!(file >> list)) return mask;
+        std::stringstream ss(list);
+        while (std::getline(ss, range, ',')) {
+            size_t dash = range.find('-');
+            size_t lo = std::stoul(range.substr(0, dash));
+            size_t hi = dash == std::string::npos ? lo : std::stoul(range.substr(dash + 1));
+            for (size_t node = lo; node <= hi; ++node, ++count) {
+                if (mask.size() <= node / bits) mask.resize(node / bits + 1, 0);
+                mask[node / bits] |= 1ul << (node % bits);
+            }
+        }
+        if (count < 2) mask.clear();
+        return mask;
+    }();
+    return mask;
+}
+
+#ifdef __linux__
+// Maps bytes at a 2MB boundary, so that every page of the range can be a huge page.
+inline void *map(size_t bytes, NumaPolicy policy) {
+    size_t len = round_up(bytes);
+    void *p = mmap(nullptr, len + huge_page, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (p == MAP_FAILED) throw std::bad_alloc();
+    char *base = static_cast<char *>(p);
+    char *aligned = reinterpret_cast<char *>(round_up(reinterpret_cast<uintptr_t>(base)));
+    if (aligned != base) munmap(base, aligned - base);
+    munmap(aligned + len, base + huge_page - aligned);
+    if (huge_pages_on()) madvise(aligned, len, MADV_HUGEPAGE);
+    const std::vector<unsigned long> &nodes = numa_nodes();
+    if (policy == NumaPolicy::interleave && !nodes.empty()) {
+        // MPOL_INTERLEAVE; where mbind is not permitted the pages simply stay first-touch
+        constexpr int mpol_interleave = 3;
+        syscall(SYS_mbind, aligned, len, mpol_interleave, nodes.data(), nodes.size() * 8 * sizeof(unsigned long) + 1, 0);
+    }
+    return aligned;
+}
+#endif
+
+}
+
+// whether large arrays allocated from now on are advised for huge pages (default true)
+inline void set_huge_pages(bool on) {
+    __memory_detail::huge_pages_on() = on;
+}
+
+inline bool huge_pages() {
+    return __memory_detail::huge_pages_on();
+}
+
+// NUMA placement of large arrays allocated from now on (default interleave); a no-op on a single node
+inline void set_numa_policy(NumaPolicy policy) {
+    __memory_detail::numa_policy_value() = static_cast<int>(policy);
+}
+
+inline NumaPolicy numa_policy() {
+    return static_cast<NumaPolicy>(__memory_detail::numa_policy_value().load());
+}
+
+inline NumaPolicy parse_numa_policy(const std::string &name) {
+    if (name == "first_touch") return NumaPolicy::first_touch;
+    if (name == "interleave") return NumaPolicy::interleave;
+    throw std::invalid_argument("Unknown NUMA policy: " + name + " (expected first_touch or interleave)");
+}
+
+// bytes of memory, mapped on huge pages from 2MB on and heap-allocated below; free with huge_free(p, bytes)
+inline void *huge_alloc(size_t bytes, NumaPolicy policy = numa_policy()) {
+#ifdef __linux__
+    if (bytes >= __memory_detail::huge_page) return __memory_detail::map(bytes, policy);
+#endif
+    (void)policy;
+    return ::operator new(bytes);
+}
+
+inline void huge_free(void *p, size_t bytes) noexcept {
+    if (p == nullptr) return;
+#ifdef __linux__
+    if (bytes >= __memory_detail::huge_page) {
+        munmap(p, __memory_detail::round_up(bytes));
+        return;
+    }
+#endif
+    (void)bytes;
+    ::operator delete(p);
+}
+
+// Advises the 2MB-aligned part of [p, p + bytes) for huge pages; pages already written keep their size.
+inline void advise_huge_pages(void *p, size_t bytes) {
+#ifdef __linux__
+    uintptr_t first = __memory_detail::round_up(reinterpret_cast<uintptr_t>(p));
+    uintptr_t last = (reinterpret_cast<uintptr_t>(p) + bytes) & ~(__memory_detail::huge_page - 1);
+    if (huge_pages() && last > first) madvise(reinterpret_cast<void *>(first), last - first, MADV_HUGEPAGE);
+#else
+    (void)p;
+    (void)bytes;
+#endif
+}
+
+// std::allocator replacement that takes its memory from huge_alloc
+template <typename T>
+struct huge_page_allocator {
+    using value_type = T;
+
+    huge_page_allocator() noexcept = default;
+    template <typename U>
+    huge_page_allocator(const huge_page_allocator<U> &) noexcept { }
+
+    T *allocate(size_t n) {
+        return static_cast<T *>(huge_alloc(n * sizeof(T)));
+    }
+
+    void deallocate(T *p, size_t n) noexcept {
+        huge_free(p, n * sizeof(T));
+    }
+};
+
+template <typename T, typename U>
+bool operator==(const huge_page_allocator<T> &, const huge_page_allocator<U> &) noexcept { return true; }
+
+template <typename T, typename U>
+bool operator!=(const huge_page_allocator<T> &, const huge_page_allocator<U> &) noexcept { return false; }
+
+template <typename T>
+using huge_vector = std::vector<T, huge_page_allocator<T>>;
+
+// Sets v to n copies of value. Storage that has to grow is advised for huge pages before the calling thread
+// first writes it, so a workspace is faulted in 2MB pages on that thread's node.
+template <typename T, typename A>
+void assign_workspace(std::vector<T, A> &v, size_t n, const T &value) {
+    if (v.capacity() < n) {
+        std::vector<T, A>().swap(v);
+        v.reserve(n);
+        advise_huge_pages(v.data(), n * sizeof(T));
+    }
+    v.assign(n, value);
+}
+
+// Bump-pointer allocator for scratch objects that need no destructor. allocate hands out uninitialized memory;
+// reset releases all of it at once and, if it took several blocks, replaces them by one of their total size, so
+// a steady workload allocates from a single block. Blocks are first-touch, local to the thread that uses the
+// arena, and an arena is not thread-safe: use one per thread.
+class Arena {
+public:
+    explicit Arena(size_t block_bytes = size_t(1) << 16) : block_bytes(block_bytes) { }
+    Arena(const Arena &) = delete;
+    Arena &operator=(const Arena &) = delete;
+
+    ~Arena() {
+        release();
+    }
+
+    template <typename T>
+    T *allocate(size_t n) {
+        static_assert(std::is_trivially_destructible<T>::value, "Arena objects are never destroyed");
+        size_t bytes = n * sizeof(T);
+        size_t at = (used + alignof(T) - 1) & ~(alignof(T) - 1);
+        if (blocks.empty() || at + bytes > blocks.back().second) {
+            size_t size = std::max(bytes, blocks.empty() ? block_bytes : 2 * blocks.back().second);
+            grow(size);
+            at = 0;
+        }
+        used = at + bytes;
+        return reinterpret_cast<T *>(blocks.back().first + at);
+    }
+
+    // copy of [first, first + n) in the arena
+    template <typename T>
+    T *copy(const T *first, size_t n) {
+        T *p = allocate<T>(n);
+        std::copy(first, first + n, p);
+        return p;
+    }
+
+    void reset() {
+        if (blocks.size() > 1) {
+            size_t size = capacity();
+            release();
+            grow(size);
+        }
+        used = 0;
+    }
+
+    // bytes held in blocks
+    size_t capacity() const {
+        size_t size = 0;
+        for (const auto &block : blocks) size += block.second;
+        return size;
+    }
+
+private:
+    size_t block_bytes;
+    size_t used = 0;
+    std::vector<std::pair<char *, size_t>> blocks;
+
+    void grow(size_t size) {
+        blocks.emplace_back(static_cast<char *>(huge_alloc(size, NumaPolicy::first_touch)), size);
+    }
+
+    void release() {
+        for (const auto &block : blocks) huge_free(block.first, block.second);
+        blocks.clear();
+    }
+};
@@ -0,0 +1,86 @@
+/*
+  This header file provides data-parallel loop helpers on top of a process-wide
+  work-stealing pool (pool.hpp). The loops split an index range into contiguous chunks,
+  run them on the pool and block the calling thread, which works on chunks itself, until
+  all chunks are done. Chunks are cut adaptively: about four per thread, cut finer where
+  threads run out of work. Loops nested in a loop body are scheduled on the same threads,
+  so they neither oversubscribe the machine nor deadlock. An exception thrown by a body is
+  rethrown by the loop after the other chunks finished.
+  While tracing is on (trace.hpp) every chunk and the wait for the pool are recorded as events.
+
+  Example usage:
+  - Run a loop body over [0, n) in parallel:
+    parallel_for(0, n, [&](size_t i){ y[i] = 2 * x[i]; });
+
+  - Run a chunked body, useful to keep per-chunk accumulators:
+    parallel_for_chunks(0, n, [&](size_t begin, size_t end){ ... });
+
+  - Reduce over [0, n):
+    double s = parallel_reduce(0, n, 0.0, [&](size_t i){ return x[i]; }, std::plus<double>());
+
+  - Change the number of threads used by subsequent loops, the calling thread included:
+    set_num_threads(8);
+
+  - Pin the worker threads to cores:
+    set_thread_pinning(true);
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "pool.hpp"
+
+// number of threads used by parallel loops, the calling thread included
+inline size_t get_num_threads() {
+    return WorkStealingPool::instance().size();
+}
+
+// set the number of threads used by parallel loops, 0 means hardware concurrency; not while a loop runs
+inline void set_num_threads(size_t n) {
+    WorkStealingPool &pool = WorkStealingPool::instance();
+    pool.restart(n, pool.pinned());
+}
+
+// pin worker i to core i (Linux only, a no-op elsewhere); not while a loop runs
+inline void set_thread_pinning(bool pin) {
+    WorkStealingPool &pool = WorkStealingPool::instance();
+    pool.restart(pool.size(), pin);
+}
+
+// run f(begin, end) over contiguous chunks of [begin, end), at least grain indices per chunk
+template <typename F>
+void parallel_for_chunks(size_t begin, size_t end, F &&f, size_t grain = 1024) {
+    if (end <= begin) return;
+    if (end - begin < 2 * grain || get_num_threads() <= 1) {
+        f(begin, end);
+        return;
+    }
+    WorkStealingPool::instance().run(begin, end, grain, f);
+}
+
+// run f(i) for every i in [begin, end)
+template <typename F>
+void parallel_for(size_t begin, size_t end, F &&f, size_t grain = 1024) {
+    parallel_for_chunks(begin, end, [&f](size_t lo, size_t hi) {
+        for (size_t i = lo; i < hi; ++i) f(i);
+    }, grain);
+}
+
+// combine map(i) for every i in [begin, end) with reduce, init must be the identity of reduce
+template <typename T, typename Map, typename Reduce>
+T parallel_reduce(size_t begin, size_t end, T init, Map &&map, Reduce &&reduce, size_t grain = 1024) {
+    std::mutex mutex;
+    T result = init;
+    parallel_for_chunks(begin, end, [&](size_t lo, size_t hi) {
+        T local = init;
+        for (size_t i = lo; i < hi; ++i) local = reduce(local, map(i));
+        std::lock_guard<std::mutex> lock(mutex);
+        result = reduce(result, local);
+    }, grain);
+    return result;
+}
@@ -0,0 +1,290 @@
+/*
+  This header file provides the work-stealing scheduler behind the parallel loops of parallel.hpp.
+  A pool of n - 1 worker threads and the calling thread share n task deques. The owner of a deque
+  pushes and pops at the back, idle threads steal from the front of a random victim, so a thread
+  works on its newest (smallest, cache-warm) ranges and thieves take the oldest (largest) ones.
+  Threads outside the pool share slot 0. A task is a range of a loop, a few words with no heap
+  allocation of its own.
+
+  Ranges are split adaptively: a loop starts with a split budget of about log2(n) + 2, i.e. four
+  ranges per thread, and every execution of a range halves it while the budget lasts and both
+  halves keep at least grain indices, pushing the upper half. A stolen range gets one more split,
+  so loops that turn out imbalanced are cut finer where the stealing happens.
+
+  A thread that waits for its loop keeps popping and stealing tasks until all ranges of the loop
+  are done, so nested loops run on the same threads without oversubscription or deadlock. Idle
+  workers spin on steals for a short while, then sleep until a task is pushed.
+
+  Example usage:
+  - Run f(lo, hi) over ranges of [begin, end) on the process-wide pool and wait for it:
+    WorkStealingPool::instance().run(begin, end, grain, f);
+
+  - Restart the pool with 8 threads in total, the calling thread included, pinned to cores:
+    WorkStealingPool::instance().restart(8, true);
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+#include "trace.hpp"
+
+namespace __pool_detail {
+    // one parallel loop; lives on the stack of the thread that runs it until all its ranges are done
+    struct Group {
+        void (*run)(void *body, size_t lo, size_t hi);
+        void *body;
+        size_t grain;
+        std::atomic<size_t> pending{0};     // ranges pushed and not finished yet
+        std::atomic<bool> failed{false};
+        std::exception_ptr error;           // first exception thrown by the body
+    };
+
+    struct Task {
+        Group *group;
+        size_t lo, hi;
+        int budget;                         // splits left
+    };
+
+    struct alignas(64) Slot {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+
+    inline unsigned hardware_threads() {
+        return std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    // xorshift state for picking victims
+    inline uint32_t next_random() {
+        thread_local uint32_t x = 2463534242u ^ static_cast<uint32_t>(std::hash<std::thread::id>()(std::this_thread::get_id()));
+        x ^= x << 13;
+        x ^= x >> 17;
+        x ^= x << 5;
+        return x;
+    }
+}
+
+class WorkStealingPool {
+public:
+    explicit WorkStealingPool(size_t threads = __pool_detail::hardware_threads(), bool pin = false) {
+        start(threads, pin);
+    }
+
+    ~WorkStealingPool() {
+        stop();
+    }
+
+    WorkStealingPool(const WorkStealingPool &) = delete;
+    WorkStealingPool &operator=(const WorkStealingPool &) = delete;
+
+    static WorkStealingPool &instance() {
+        static WorkStealingPool pool;
+        return pool;
+    }
+
+    // threads in total, the calling thread included
+    size_t size() const {
+        return slots.size();
+    }
+
+    bool pinned() const {
+        return pin;
+    }
+
+    // Stops the workers and starts threads - 1 new ones, 0 means hardware concurrency.
+    // No loop may run on the pool meanwhile.
+    void restart(size_t threads, bool pin) {
+        stop();
+        start(threads, pin);
+    }
+
+    // Runs f(lo, hi) over disjoint ranges covering [begin, end) with at least grain indices each (unless the
+    // whole range is smaller) and returns when all are done. The first exception thrown by f is rethrown.
+    template <typename F>
+    void run(size_t begin, size_t end, size_t grain, F &f) {
+        if (end <= begin) return;
+        __pool_detail::Group group;
+        group.run = [](void *body, size_t lo, size_t hi) { (*static_cast<F *>(body))(lo, hi); };
+        group.body = static_cast<void *>(&f);
+        group.grain = std::max<size_t>(grain, 1);
+        int budget = 2;
+        for (size_t t = 1; t < size(); t *= 2) ++budget;
+        size_t self = current_slot();
+        execute({&group, begin, end, budget}, self);
+        wait(group, self);
+        if (group.error) std::rethrow_exception(group.error);
+    }
+
+private:
+    std::vector<std::unique_ptr<__pool_detail::Slot>> slots;
+    std::vector<std::thread> workers;
+    bool pin = false;
+    std::atomic<bool> stopping{false};
+    std::atomic<uint64_t> epoch{0};         // bumped on every push, sleeping workers wait for a change
+    std::atomic<size_t> sleepers{0};
+    std::mutex sleep_mutex;
+    std::condition_variable wakeup;
+
+    // slot of the calling thread in this pool, 0 for threads outside it
+    struct Worker {
+        const WorkStealingPool *pool = nullptr;
+        size_t slot = 0;
+    };
+
+    static Worker &worker() {
+        thread_local Worker w;
+        return w;
+    }
+
+    size_t current_slot() const {
+        return worker().pool == this ? worker().slot : 0;
+    }
+
+    void start(size_t threads, bool pin_threads) {
+        if (threads == 0) threads = __pool_detail::hardware_threads();
+        pin = pin_threads;
+        stopping.store(false);
+        slots.clear();
+        for (size_t i = 0; i < threads; ++i) slots.emplace_back(new __pool_detail::Slot());
+        for (size_t i = 1; i < threads; ++i) {
+            workers.emplace_back([this, i] { worker_loop(i); });
+        }
+    }
+
+    void stop() {
+        {
+            std::lock_guard<std::mutex> lock(sleep_mutex);
+            stopping.store(true);
+        }
+        wakeup.notify_all();
+        for (std::thread &t : workers) t.join();
+        workers.clear();
+    }
+
+    void push(size_t self, const __pool_detail::Task &task) {
+        task.group->pending.fetch_add(1);
+        {
+            __pool_detail::Slot &s = *slots[self];
+            std::lock_guard<std::mutex> lock(s.mutex);
+            s.tasks.push_back(task);
+        }
+        epoch.fetch_add(1);
+        if (sleepers.load() > 0) {
+            std::lock_guard<std::mutex> lock(sleep_mutex);
+            wakeup.notify_one();
+        }
+    }
+
+    bool pop(size_t self, __pool_detail::Task &task) {
+        __pool_detail::Slot &s = *slots[self];
+        std::lock_guard<std::mutex> lock(s.mutex);
+        if (s.tasks.empty()) return false;
+        task = s.tasks.back();
+        s.tasks.pop_back();
+        return true;
+    }
+
+    bool steal(size_t self, __pool_detail::Task &task) {
+        size_t n = slots.size();
+        size_t first = __pool_detail::next_random() % n;
+        for (size_t k = 0; k < n; ++k) {
+            size_t victim = (first + k) % n;
+            if (victim == self) continue;
+            __pool_detail::Slot &s = *slots[victim];
+            std::unique_lock<std::mutex> lock(s.mutex, std::try_to_lock);
+            if (!lock.owns_lock() || s.tasks.empty()) continue;
+            task = s.tasks.front();
+            s.tasks.pop_front();
+            ++task.budget;
+            return true;
+        }
+        return false;
+    }
+
+    bool find(size_t self, __pool_detail::Task &task) {
+        return pop(self, task) || steal(self, task);
+    }
+
+    // splits the range while the budget lasts, then runs the body on what is left
+    void execute(__pool_detail::Task task, size_t self) {
+        __pool_detail::Group &g = *task.group;
+        while (task.budget > 0 && task.hi - task.lo >= 2 * g.grain) {
+            size_t mid = task.lo + (task.hi - task.lo) / 2;
+            --task.budget;
+            push(self, {task.group, mid, task.hi, task.budget});
+            task.hi = mid;
+        }
+        if (g.failed.load(std::memory_order_relaxed)) return;
+        try {
+            TRACE_SCOPE("chunk", "pool");
+            g.run(g.body, task.lo, task.hi);
+        } catch (...) {
+            if (!g.failed.exchange(true)) g.error = std::current_exception();
+        }
+    }
+
+    // pushed ranges count as pending until they finished, the group must not be touched after that
+    void execute_pushed(const __pool_detail::Task &task, size_t self) {
+        execute(task, self);
+        task.group->pending.fetch_sub(1);
+    }
+
+    // helps with any task until the group is done
+    void wait(__pool_detail::Group &group, size_t self) {
+        if (group.pending.load() == 0) return;
+        TRACE_SCOPE("wait", "pool");
+        __pool_detail::Task task;
+        while (group.pending.load() > 0) {
+            if (find(self, task)) execute_pushed(task, self);
+            else std::this_thread::yield();
+        }
+    }
+
+    void worker_loop(size_t self) {
+        worker() = {this, self};
+#ifdef __linux__
+        if (pin) {
+            cpu_set_t set;
+            CPU_ZERO(&set);
+            CPU_SET(self % __pool_detail::hardware_threads(), &set);
+            pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+        }
+#endif
+        __pool_detail::Task task;
+        while (!stopping.load()) {
+            uint64_t seen = epoch.load();
+            bool found = false;
+            for (int spin = 0; spin < 64 && !found; ++spin) {
+                found = find(self, task);
+                if (!found) std::this_thread::yield();
+            }
+            if (found) {
+                execute_pushed(task, self);
+                continue;
+            }
+            sleepers.fetch_add(1);
+            if (epoch.load() == seen) {
+                std::unique_lock<std::mutex> lock(sleep_mutex);
+                wakeup.wait(lock, [&] { return epoch.load() != seen || stopping.load(); });
+            }
+            sleepers.fetch_sub(1);
+        }
+        worker() = {};
+    }
+};
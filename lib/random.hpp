@@ -21,6 +21,13 @@
     std::vector<double> weights = {0.1, 0.3, 0.6};
     AliasSampler sampler(weights);
     uint32_t sample = sampler.sample();
+
+  - Hash a counter to 64 random bits, for streams that must not depend on the thread count:
+    uint64_t x = splitmix64(seed ^ i);
+
+  - Build many small alias tables into flat arrays (e.g. one per node of a graph):
+    build_alias_table(&weights[0], weights.size(), &prob[0], &alias[0]);
+    uint32_t sample = sample_alias_table(&prob[0], &alias[0], weights.size());
 */
 
 
@@ -30,8 +37,10 @@
 #include <cstdint>
 #include <random>
 #include <stack>
+#include <vector>
 
-std::mt19937 rand_uint{(std::random_device())()};
+// one engine per thread, so walks can run concurrently without sharing state
+thread_local std::mt19937 rand_uint{(std::random_device())()};
 
 // uniform random double in [0, 1)
 double rand_uniformf() {
@@ -51,6 +60,14 @@ uint32_t rand_uniform(uint32_t n) {
   return m >> 32;
 }
 
+// stateless 64-bit mixer, consecutive inputs give independent-looking outputs
+inline uint64_t splitmix64(uint64_t x) {
+  x += 0x9E3779B97F4A7C15ull;
+  x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ull;
+  x = (x ^ (x >> 27)) * 0x94D049BB133111EBull;
+  return x ^ (x >> 31);
+}
+
 // geometric random uint32 with p(x=k) = (1-p)^k * p
 uint32_t rand_geometric(double p) {
   if (p == 1) return 1;
@@ -136,3 +153,53 @@ public:
     return u < prob[i] ? i : alias[i];
   }
 };
+
+// Alias table of k weights written to prob[0, k) and alias[0, k), without heap allocation per table
+// beyond the reusable work buffers.
+template <typename W, typename P>
+void build_alias_table(const W* weights, uint32_t k, P* prob, uint32_t* alias,
+                       std::vector<double>& scaled, std::vector<uint32_t>& small, std::vector<uint32_t>& large) {
+  if (k == 0) return;
+  double sum = 0;
+  for (uint32_t i = 0; i < k; ++i) sum += weights[i];
+  scaled.resize(k);
+  small.clear();
+  large.clear();
+  for (uint32_t i = 0; i < k; ++i) {
+    scaled[i] = sum > 0 ? weights[i] * k / sum : 1.0;
+    alias[i] = i;
+    if (scaled[i] < 1.0)
+      small.push_back(i);
+    else
+      large.push_back(i);
+  }
+  while (!small.empty() && !large.empty()) {
+    uint32_t s = small.back();
+    small.pop_back();
+    uint32_t l = large.back();
+    large.pop_back();
+    prob[s] = static_cast<P>(scaled[s]);
+    alias[s] = l;
+    scaled[l] = scaled[l] + scaled[s] - 1.0;
+    if (scaled[l] < 1.0)
+      small.push_back(l);
+    else
+      large.push_back(l);
+  }
+  for (uint32_t l : large) prob[l] = 1;
+  for (uint32_t s : small) prob[s] = 1;
+}
+
+template <typename W, typename P>
+void build_alias_table(const W* weights, uint32_t k, P* prob, uint32_t* alias) {
+  std::vector<double> scaled;
+  std::vector<uint32_t> small, large;
+  build_alias_table(weights, k, prob, alias, scaled, small, large);
+}
+
+// sample an index in [0, k) from a table built by build_alias_table
+template <typename P>
+uint32_t sample_alias_table(const P* prob, const uint32_t* alias, uint32_t k) {
+  uint32_t i = rand_uniform(k);
+  return rand_uniformf() < prob[i] ? i : alias[i];
+}
@@ -23,7 +23,9 @@
 #include <cstdlib>
 #include <fstream>
 #include <iostream>
+#include <iterator>
 #include <numeric>
+#include <stdexcept>
 #include <string>
 #include <tuple>
 #include <vector>
@@ -309,4 +311,21 @@ T load_file(const std::string &filename) {
     T ret = deserialize<T>(res);
     res.clear();
     return ret;
-}
\ No newline at end of file
+}
+
+// write an already serialized stream to filename, throwing std::runtime_error on failure
+inline void save_stream(const std::string &filename, const __serialize_detail::stream &res) {
+    std::ofstream file(filename, std::ios::binary);
+    if (!file.write(reinterpret_cast<const char *>(res.data()), res.size())) {
+        throw std::runtime_error("Could not write to file: " + filename);
+    }
+}
+
+// the bytes of filename, for a deserializer that checks them; throws std::runtime_error if it cannot be opened
+inline __serialize_detail::stream load_stream(const std::string &filename) {
+    std::ifstream file(filename, std::ios::binary);
+    if (!file.is_open()) {
+        throw std::runtime_error("Could not open file: " + filename);
+    }
+    return __serialize_detail::stream((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+}
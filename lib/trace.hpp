@@ -0,0 +1,183 @@
+/*
+  This header file provides a timeline tracer that writes Chrome trace JSON, readable by
+  chrome://tracing and ui.perfetto.dev. Every thread appends complete events ("ph": "X") to
+  its own buffer, so recording takes no lock; a thread registers its buffer once, on its first
+  event. While tracing is off a scope costs one branch on a global flag.
+
+  Example usage:
+  - Write the trace of the whole run to a file when the process exits:
+    trace_enable("trace.json");
+
+  - Record a scope as one event on the calling thread (name and category must be string literals
+    or otherwise outlive the process):
+    {
+        TRACE_SCOPE("push", "ssppr");
+        ...
+    }
+
+  - Write the events recorded so far, or stop recording without writing at exit:
+    trace_dump("trace.json");
+    trace_disable();
+*/
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace __trace_detail {
+    struct Event {
+        const char *name;
+        const char *category;
+        double start_us;
+        double duration_us;
+    };
+
+    struct ThreadBuffer {
+        uint32_t tid;
+        std::vector<Event> events;
+    };
+
+    inline std::atomic<bool> &enabled() {
+        static std::atomic<bool> flag(false);
+        return flag;
+    }
+
+    inline std::chrono::steady_clock::time_point epoch() {
+        static const std::chrono::steady_clock::time_point t = std::chrono::steady_clock::now();
+        return t;
+    }
+
+    inline double now_us() {
+        return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - epoch()).count();
+    }
+
+    // buffers of all threads that recorded events; they outlive their threads until the dump
+    struct Registry {
+        std::mutex mutex;
+        std::vector<std::unique_ptr<ThreadBuffer>> buffers;
+        std::string filename;       // written at exit unless empty
+        bool exit_hook = false;
+    };
+
+    inline Registry &registry() {
+        static Registry r;
+        return r;
+    }
+
+    inline ThreadBuffer &local_buffer() {
+        thread_local ThreadBuffer *buffer = nullptr;
+        if (buffer == nullptr) {
+            Registry &r = registry();
+            std::lock_guard<std::mutex> lock(r.mutex);
+            r.buffers.emplace_back(new ThreadBuffer{static_cast<uint32_t>(r.buffers.size()), {}});
+            buffer = r.buffers.back().get();
+        }
+        return *buffer;
+    }
+
+    inline void escape(std::ostream &os, const char *s) {
+        for (; *s; ++s) {
+            if (*s == '"' || *s == '\\') os << '\\';
+            os << *s;
+        }
+    }
+}
+
+inline bool trace_enabled() {
+    return __trace_detail::enabled().load(std::memory_order_relaxed);
+}
+
+// Writes all recorded events as a Chrome trace. Threads must not record while it runs.
+inline void trace_dump(const std::string &filename) {
+    std::ofstream os(filename);
+    if (!os.is_open()) {
+        throw std::runtime_error("Could not write to file: " + filename);
+    }
+    __trace_detail::Registry &r = __trace_detail::registry();
+    std::lock_guard<std::mutex> lock(r.mutex);
+    os << "{\"traceEvents\": [\n";
+    bool first = true;
+    for (const auto &buffer : r.buffers) {
+        os << (first ? "" : ",\n") << "{\"name\": \"thread_name\", \"ph\": \"M\", \"pid\": 1, \"tid\": " << buffer->tid
+           << ", \"args\": {\"name\": \"" << (buffer->tid == 0 ? "main" : "thread " + std::to_string(buffer->tid)) << "\"}}";
+        first = false;
+        for (const __trace_detail::Event &e : buffer->events) {
+            os << ",\n{\"name\": \"";
+            __trace_detail::escape(os, e.name);
+            os << "\", \"cat\": \"";
+            __trace_detail::escape(os, e.category);
+            os << "\", \"ph\": \"X\", \"pid\": 1, \"tid\": " << buffer->tid << ", \"ts\": " << e.start_us
+               << ", \"dur\": " << e.duration_us << "}";
+        }
+    }
+    os << "\n], \"displayTimeUnit\": \"ms\"}\n";
+}
+
+// Starts recording on all threads; the trace is written to filename when the process exits.
+inline void trace_enable(const std::string &filename) {
+    __trace_detail::Registry &r = __trace_detail::registry();
+    __trace_detail::epoch();
+    __trace_detail::local_buffer();     // the calling thread becomes tid 0
+    {
+        std::lock_guard<std::mutex> lock(r.mutex);
+        r.filename = filename;
+        if (!r.exit_hook) {
+            r.exit_hook = true;
+            std::atexit([] {
+                __trace_detail::enabled().store(false);
+                std::string filename = __trace_detail::registry().filename;
+                if (filename.empty()) return;
+                try {
+                    trace_dump(filename);
+                } catch (const std::exception &e) {
+                    std::cerr << e.what() << std::endl;
+                }
+            });
+        }
+    }
+    __trace_detail::enabled().store(true);
+}
+
+// Stops recording and cancels the dump at exit; recorded events stay available to trace_dump.
+inline void trace_disable() {
+    __trace_detail::enabled().store(false);
+    __trace_detail::Registry &r = __trace_detail::registry();
+    std::lock_guard<std::mutex> lock(r.mutex);
+    r.filename.clear();
+}
+
+// records its lifetime as one event on the calling thread if tracing is on
+class TraceScope {
+public:
+    TraceScope(const char *name, const char *category) : name(name), category(category) {
+        if (trace_enabled()) start = __trace_detail::now_us();
+    }
+
+    ~TraceScope() {
+        if (start < 0) return;
+        double end = __trace_detail::now_us();
+        __trace_detail::local_buffer().events.push_back({name, category, start, end - start});
+    }
+
+    TraceScope(const TraceScope &) = delete;
+    TraceScope &operator=(const TraceScope &) = delete;
+
+private:
+    const char *name;
+    const char *category;
+    double start = -1;
+};
+
+#define TRACE_CONCAT_INNER(a, b) a##b
+#define TRACE_CONCAT(a, b) TRACE_CONCAT_INNER(a, b)
+#define TRACE_SCOPE(name, category) TraceScope TRACE_CONCAT(__trace_scope_, __LINE__)(name, category)
@@ -0,0 +1,81 @@
+#include <iostream>
+#include <cmath>
+#include "convenientPrint.hpp"
+
+#include "uwdigraph/graph.hpp"
+#include "uwdigraph/graph_types.hpp"
+#include "uwdigraph/graphio.hpp"
+
+#include "uwudgraph/apps/ssppr/ssppr.hpp"
+
+std::string test_file = "test/uwdigraph/data/demo.txt";
+
+using uwudgraph::Dangling;
+
+
+// exact PPR by power iteration on the transition matrix completed by the dangling policy
+std::vector<double> power_iteration(const uwdigraph::Graph& g, uwdigraph::node_id source, double alpha, Dangling dangling) {
+    std::vector<double> ppr(g.n, 0.0), next(g.n);
+    ppr[source] = 1.0;
+    for (int it = 0; it < 1000; ++it) {
+        std::fill(next.begin(), next.end(), 0.0);
+        next[source] = alpha;
+        for (uwdigraph::node_id u = 0; u < g.n; ++u) {
+            double mass = (1 - alpha) * ppr[u];
+            if (g.get_degree(u) == 0) {
+                if (dangling == Dangling::selfloop) next[u] += mass;
+                else if (dangling == Dangling::restart) next[source] += mass;
+                else for (double& x : next) x += mass / g.n;
+                continue;
+            }
+            for (uwdigraph::node_id v : g.get_neighbors(u)) next[v] += mass / g.get_degree(u);
+        }
+        ppr.swap(next);
+    }
+    return ppr;
+}
+
+bool close(const std::vector<double>& a, const std::vector<double>& b, double tol) {
+    for (size_t u = 0; u < a.size(); ++u) {
+        if (std::abs(a[u] - b[u]) > tol) return false;
+    }
+    return true;
+}
+
+
+int main() {
+    std::cout << "Loading graph from edgelist file: " << test_file << std::endl;
+    uwdigraph::Graph* g = uwdigraph::load_edgelist(test_file);
+    std::cout << "Number of nodes: " << g->n << std::endl;
+    std::cout << "Number of edges: " << g->m << std::endl;
+
+    for (std::string name : {"restart", "uniform", "selfloop"}) {
+        Dangling dangling = uwudgraph::parse_dangling(name);
+        std::vector<double> exact = power_iteration(*g, 0, 0.2, dangling);
+        print("Dangling policy:", name);
+        print("PPR vector by power iteration: ", exact);
+
+        std::vector<double> ppr = uwudgraph::ppr_forwardpush(*g, 0, 0.2, 1e-12, dangling).first;
+        print("PPR vector by forwardpush: ", ppr);
+        if (!close(ppr, exact, 1e-8)) {
+            print("Directed forward push does not match power iteration");
+            return 1;
+        }
+        ppr = uwudgraph::ppr_powerpush(*g, 0, 0.2, 1e-10, dangling).first;
+        print("PPR vector by powerpush: ", ppr);
+        if (!close(ppr, exact, 1e-6)) {
+            print("Directed power push does not match power iteration");
+            return 1;
+        }
+        for (std::string method : {"rw", "fora", "speedppr", "ppw"}) {
+            ppr = uwudgraph::SSPPR(*g, 0, 0.2, method, 0.01, 0, 0, 0, 200000, 0, 0, 0, dangling);
+            print("PPR vector by", method, ": ", ppr);
+            if (!close(ppr, exact, 0.02)) {
+                print("Directed", method, "is too far from power iteration");
+                return 1;
+            }
+        }
+    }
+    delete g;
+    return 0;
+}
@@ -0,0 +1,106 @@
+#include <cstdio>
+#include <iostream>
+#include "convenientPrint.hpp"
+
+#include "uwudgraph/graph.hpp"
+#include "uwudgraph/apps/generate/generate.hpp"
+#include "uwudgraph/apps/accuracy/accuracy.hpp"
+
+std::string truth_file = "test/uwudgraph/data/truth.bin";
+
+
+int main() {
+    uwudgraph::GeneratorParams p;
+    p.n = 500;
+    p.m = 3000;
+    uwudgraph::Graph* g = uwudgraph::generate_graph("er", p);
+    std::vector<uint64_t> sources = uwudgraph::sample_sources(*g, 3, 1);
+
+    std::remove(truth_file.c_str());
+    uwudgraph::GroundTruth truth = uwudgraph::ground_truth(*g, sources, 0.2, 1e-12, uwudgraph::Dangling::selfloop, truth_file);
+    for (size_t i = 0; i < sources.size(); ++i) {
+        double sum = std::accumulate(truth.ppr[i].begin(), truth.ppr[i].end(), 0.0);
+        if (std::abs(sum - 1) > 1e-11) {
+            print("Ground truth of source", sources[i], "sums to", sum);
+            return 1;
+        }
+        // a converged push agrees with the ground truth
+        std::vector<double> push = uwudgraph::ppr_forwardpush(*g, sources[i], 0.2, 1e-12).first;
+        uwudgraph::AccuracyMetrics mt = uwudgraph::accuracy_metrics(truth.ppr[i], push, 10, 1.0 / g->n);
+        print("Source", sources[i], "push max relative error", mt.max_rel_err, "l1", mt.l1);
+        if (mt.max_rel_err > 1e-6 || mt.precision < 1 || mt.ndcg < 1 - 1e-9) {
+            print("Push does not match the ground truth");
+            return 1;
+        }
+    }
+
+    // the cache is reused for the same query and recomputed for another one
+    uwudgraph::GroundTruth cached = uwudgraph::load_ground_truth(truth_file);
+    if (cached.sources != truth.sources || cached.ppr != truth.ppr) {
+        print("Cached ground truth differs");
+        return 1;
+    }
+    uwudgraph::GroundTruth other = uwudgraph::ground_truth(*g, sources, 0.3, 1e-12, uwudgraph::Dangling::selfloop, truth_file);
+    if (other.alpha != 0.3 || other.ppr == truth.ppr || uwudgraph::load_ground_truth(truth_file).alpha != 0.3) {
+        print("Ground truth cache ignores alpha");
+        return 1;
+    }
+    std::remove(truth_file.c_str());
+
+    // more work lowers the error, and the front holds the cheapest setting and the most accurate one
+    uwudgraph::AccuracyConfig config;
+    config.methods = {"push", "fora"};
+    config.rmaxs = {1e-2, 1e-6};
+    config.epss = {0.5};
+    config.reps = 1;
+    config.k = 10;
+    std::vector<uwudgraph::AccuracyRecord> records = uwudgraph::accuracy_sweep(*g, truth, config);
+    if (records.size() != 3 || records[1].metrics.l1 >= records[0].metrics.l1) {
+        print("Push error does not drop with rmax");
+        return 1;
+    }
+    uwudgraph::mark_pareto(records, "l1");
+    const uwudgraph::AccuracyRecord* cheapest = &records[0];
+    const uwudgraph::AccuracyRecord* exactest = &records[0];
+    for (const uwudgraph::AccuracyRecord& r : records) {
+        print(r.method, "rmax", r.rmax, "eps", r.eps, ": median", r.latency.median, "ms l1", r.metrics.l1, "pareto", r.pareto);
+        if (r.latency.median < cheapest->latency.median) cheapest = &r;
+        if (r.metrics.l1 < exactest->metrics.l1) exactest = &r;
+    }
+    if (!cheapest->pareto || !exactest->pareto) {
+        print("Pareto front misses an extreme setting");
+        return 1;
+    }
+    if (uwudgraph::best_under_budget(records, "l1", 1e9) != exactest) {
+        print("Unlimited budget does not pick the most accurate setting");
+        return 1;
+    }
+
+    // float storage keeps the error bound of the default eps, and a float push stays within float rounding of double
+    config.methods = {"fora", "fora_f32", "speedppr_f32", "rw_f32"};
+    config.epss = {0.1};
+    config.rw_nums = {100000};
+    records = uwudgraph::accuracy_sweep(*g, truth, config);
+    for (const uwudgraph::AccuracyRecord& r : records) {
+        print(r.method, "eps", r.eps, ": max relative error", r.metrics.max_rel_err, "l1", r.metrics.l1);
+        if (r.method != "rw_f32" && r.metrics.max_rel_err > 0.1) {
+            print("Float storage breaks the error bound of", r.method);
+            return 1;
+        }
+    }
+    if (records.back().metrics.l1 > 0.05) {
+        print("Float walks lose mass");
+        return 1;
+    }
+    std::vector<double> push64 = uwudgraph::ppr_forwardpush(*g, sources[0], 0.2, 1e-8).first;
+    std::vector<float> push32 = uwudgraph::ppr_forwardpush<float>(*g, sources[0], 0.2, 1e-8).first;
+    std::vector<double> widened(push32.begin(), push32.end());
+    double drift = uwudgraph::accuracy_metrics(push64, widened, 10, 1.0 / g->n).max_rel_err;
+    print("float push drift from double", drift);
+    if (drift > 1e-5) {
+        print("Float push drifts from double");
+        return 1;
+    }
+    delete g;
+    return 0;
+}
@@ -0,0 +1,84 @@
+#include <atomic>
+#include <iostream>
+#include <thread>
+#include "convenientPrint.hpp"
+
+#include "uwudgraph/graph.hpp"
+#include "uwudgraph/apps/generate/generate.hpp"
+#include "uwudgraph/apps/ssppr/ssppr.hpp"
+#include "uwudgraph/apps/accuracy/accuracy.hpp"
+
+
+double sum(const std::vector<double>& x) {
+    double s = 0;
+    for (double v : x) s += v;
+    return s;
+}
+
+int main() {
+    uwudgraph::GeneratorParams p;
+    p.n = 2000;
+    p.m = 20000;
+    uwudgraph::Graph* g = uwudgraph::generate_graph("er", p);
+    double alpha = 0.2, eps = 0.1, delta = 1.0 / g->n, pf = 1.0 / g->n;
+    std::vector<double> exact = uwudgraph::ppr_power_iteration(*g, 0, alpha, 1e-12);
+
+    // without a budget the query runs until FORA's guarantee holds
+    uwudgraph::AnytimeResult full = uwudgraph::ppr_anytime(*g, 0, alpha, eps, delta, pf);
+    double err = uwudgraph::accuracy_metrics(exact, full.ppr, 0, delta).max_rel_err;
+    print("unbounded: stop", uwudgraph::anytime_stop_name(full.stop), "bound", full.error_bound, "error", err, "work", full.work);
+    if (full.stop != uwudgraph::AnytimeStop::converged || full.error_bound > eps || err > 2 * eps) {
+        print("Unbounded query did not converge");
+        return 1;
+    }
+
+    // a small work budget stops early with an honest bound and all the probability mass accounted for
+    uwudgraph::SSPPRBudget budget;
+    budget.work = full.work / 20;
+    uwudgraph::AnytimeResult cut = uwudgraph::ppr_anytime(*g, 0, alpha, eps, delta, pf, budget);
+    err = uwudgraph::accuracy_metrics(exact, cut.ppr, 0, delta).max_rel_err;
+    double mass = sum(cut.ppr) + (cut.walks == 0 ? cut.residual : 0);
+    print("work budget", budget.work, ": stop", uwudgraph::anytime_stop_name(cut.stop), "bound", cut.error_bound, "error", err,
+          "work", cut.work);
+    if (cut.stop != uwudgraph::AnytimeStop::work || cut.error_bound <= eps || err > cut.error_bound ||
+        std::abs(mass - 1) > 1e-9 || cut.work > budget.work + 100000) {
+        print("Wrong result under a work budget");
+        return 1;
+    }
+
+    // a deadline and a cancel flag set from another thread both end a query that would run much longer
+    budget = uwudgraph::SSPPRBudget();
+    budget.seconds = 0.005;
+    uwudgraph::AnytimeResult timed = uwudgraph::ppr_anytime(*g, 0, alpha, 0.001, delta, pf, budget);
+    print("deadline: stop", uwudgraph::anytime_stop_name(timed.stop), "seconds", timed.seconds, "bound", timed.error_bound);
+    if (timed.stop != uwudgraph::AnytimeStop::deadline || timed.seconds > 0.1 || timed.ppr.size() != g->n) {
+        print("Deadline was not kept");
+        return 1;
+    }
+    std::atomic<bool> cancel{false};
+    budget = uwudgraph::SSPPRBudget();
+    budget.cancel = &cancel;
+    std::thread canceller([&]{
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        cancel = true;
+    });
+    uwudgraph::AnytimeResult cancelled = uwudgraph::ppr_anytime(*g, 0, alpha, 0.001, delta, pf, budget);
+    canceller.join();
+    print("cancel: stop", uwudgraph::anytime_stop_name(cancelled.stop), "seconds", cancelled.seconds);
+    if (cancelled.stop != uwudgraph::AnytimeStop::cancelled || cancelled.ppr.size() != g->n) {
+        print("Cancel flag was ignored");
+        return 1;
+    }
+
+    // through the dispatcher
+    uwudgraph::AnytimeControl control;
+    control.budget.work = 50000;
+    std::vector<double> ppr = uwudgraph::SSPPR(*g, 0, alpha, "anytime", eps, delta, pf, 0, 0, 0, 0, 0,
+                                               uwudgraph::Dangling::selfloop, nullptr, &control);
+    if (ppr.size() != g->n || control.result.stop != uwudgraph::AnytimeStop::work || !control.result.ppr.empty()) {
+        print("Wrong anytime query through SSPPR");
+        return 1;
+    }
+    delete g;
+    return 0;
+}
@@ -0,0 +1,60 @@
+#include <iostream>
+#include "convenientPrint.hpp"
+
+#include "uwudgraph/graph.hpp"
+#include "uwudgraph/apps/generate/generate.hpp"
+#include "uwudgraph/apps/ssppr/ssppr.hpp"
+
+
+int main() {
+    uwudgraph::GeneratorParams p;
+    p.n = 2000;
+    p.m = 20000;
+    uwudgraph::Graph* g = uwudgraph::generate_graph("er", p);
+    double alpha = 0.2, eps = 0.2, delta = 1.0 / g->n, pf = 1.0 / g->n;
+
+    uwudgraph::AutoSSPPR<uwudgraph::Graph> tuner(*g, alpha, eps, delta, pf);
+    print("probe: seconds per edge", tuner.get_edge_cost(), "per walk", tuner.get_walk_cost(), "rmax", tuner.get_rmax());
+    if (tuner.get_edge_cost() <= 0 || tuner.get_walk_cost() <= 0) {
+        print("Probe did not measure the costs");
+        return 1;
+    }
+
+    // both methods serve queries, and every answer keeps the guarantee of FORA
+    bool fora = false, speedppr = false;
+    double worst = 0;
+    for (uwudgraph::node_id s = 0; s < 32; ++s) {
+        std::vector<double> ppr = tuner.query(s);
+        fora |= tuner.get_method() == "fora";
+        speedppr |= tuner.get_method() == "speedppr";
+        std::vector<double> exact = uwudgraph::ppr_power_iteration(*g, s, alpha, 1e-12, uwudgraph::Dangling::selfloop);
+        for (size_t v = 0; v < g->n; ++v) {
+            if (exact[v] >= delta) worst = std::max(worst, std::abs(ppr[v] - exact[v]) / exact[v]);
+        }
+    }
+    print("after", tuner.get_queries(), "queries: rmax", tuner.get_rmax(), "max relative error", worst);
+    if (!fora || !speedppr) {
+        print("A method was never tried");
+        return 1;
+    }
+    if (!(tuner.get_rmax() >= 1e-12 && tuner.get_rmax() <= 1)) {
+        print("rmax out of range");
+        return 1;
+    }
+    if (worst > 3 * eps) {
+        print("Relative error too large");
+        return 1;
+    }
+
+    // the dispatcher keeps one tuner per thread and parameters
+    std::vector<double> a = uwudgraph::SSPPR(*g, 0, alpha, "auto", eps, delta, pf, 0, 0, 0, 0, 0);
+    std::vector<double> b = uwudgraph::SSPPR(*g, 1, alpha, "auto", eps, delta, pf, 0, 0, 0, 0, 0);
+    double sum = 0;
+    for (double x : a) sum += x;
+    if (a.size() != g->n || b.size() != g->n || std::abs(sum - 1) > 0.1) {
+        print("Wrong auto answer from SSPPR");
+        return 1;
+    }
+    delete g;
+    return 0;
+}
@@ -0,0 +1,79 @@
+#include <iostream>
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <random>
+#include "convenientPrint.hpp"
+
+#include "benchmark.hpp"
+#include "uwudgraph/apps/bench/bench.hpp"
+
+std::string baseline_file = "test/uwudgraph/data/baseline.csv";
+
+
+uwudgraph::BenchRecord record(std::string graph, std::string method, double median) {
+    uwudgraph::BenchRecord r;
+    r.graph = graph;
+    r.method = method;
+    r.alpha = 0.2;
+    r.eps = 0.1;
+    r.latency.median = median;
+    return r;
+}
+
+
+int main() {
+    // nearest-rank percentiles of 1..100 in shuffled order
+    std::vector<double> samples;
+    for (int i = 1; i <= 100; ++i) samples.push_back(i);
+    std::shuffle(samples.begin(), samples.end(), std::mt19937(1));
+    LatencySummary s = summarize(samples);
+    print("count", s.count, "median", s.median, "p99", s.p99, "mean", s.mean, "min", s.min, "max", s.max);
+    if (s.count != 100 || s.median != 50 || s.p99 != 99 || std::abs(s.mean - 50.5) > 1e-12 || s.min != 1 || s.max != 100) {
+        print("Wrong summary of 1..100");
+        return 1;
+    }
+    // with three samples the median is the middle one and p99 the largest
+    s = summarize({5, 1, 3});
+    if (s.count != 3 || s.median != 3 || s.p99 != 5 || std::abs(s.mean - 3) > 1e-12) {
+        print("Wrong summary of three samples");
+        return 1;
+    }
+    s = summarize({});
+    if (s.count != 0 || s.median != 0 || s.p99 != 0) {
+        print("Wrong summary of no samples");
+        return 1;
+    }
+
+    // a hand-written baseline; tolerance 25% and noise 0.05 ms
+    std::ofstream os(baseline_file);
+    os << "graph,method,alpha,eps,queries,median_ms,p99_ms,mean_ms,pushes,walk_steps,peak_rss_kb\n"
+       << "demo,push,0.2,0.1,10,10,12,10,0,0,0\n"
+       << "demo,fora,0.2,0.1,10,10,12,10,0,0,0\n"
+       << "demo,speedppr,0.2,0.1,10,10,12,10,0,0,0\n"
+       << "demo,rw,0.2,0.1,10,0.02,0.03,0.02,0,0,0\n"
+       << "other,ppw,0.2,0.1,10,1,1,1,0,0,0\n";
+    os.close();
+    std::vector<uwudgraph::BenchRecord> records = {
+        record("demo", "push", 9),          // faster
+        record("demo", "fora", 12),         // 20% slower, within the tolerance
+        record("demo", "speedppr", 20),     // twice as slow: the one regression
+        record("demo", "rw", 0.05),         // 150% slower but only 0.03 ms, within the noise
+        record("demo", "ppw", 5),           // the baseline has ppw for another graph only
+    };
+    size_t regressions = uwudgraph::compare_baseline(records, baseline_file, 0.25, 0.05);
+    // just past the tolerance
+    size_t past = uwudgraph::compare_baseline({record("demo", "fora", 12.6)}, baseline_file, 0.25, 0.05);
+    std::remove(baseline_file.c_str());
+    if (regressions != 1 || past != 1) {
+        print("Wrong number of regressions:", regressions, past);
+        return 1;
+    }
+    try {
+        uwudgraph::compare_baseline(records, baseline_file, 0.25, 0.05);
+        print("A missing baseline must throw");
+        return 1;
+    } catch (const std::runtime_error&) {
+    }
+    return 0;
+}
@@ -0,0 +1,124 @@
+#include <iostream>
+#include <cstdio>
+#include <fstream>
+#include <random>
+#include "convenientPrint.hpp"
+#include "benchmark.hpp"
+
+#include "uwudgraph/graph.hpp"
+#include "uwudgraph/graphio.hpp"
+#include "uwudgraph/apps/component/compact.hpp"
+#include "uwudgraph/apps/component/component.hpp"
+
+std::string test_file = "test/uwudgraph/data/raw.txt";
+std::string bin_file = "test/uwudgraph/data/raw.bin";
+
+
+// position-dependent hash of the CSR arrays, so that two builds compare without keeping a copy of either
+size_t checksum(const uwudgraph::Graph& g) {
+    size_t h = 0;
+    for (size_t x : g.offsets) h = h * 1000003 + x;
+    for (uwudgraph::node_id x : g.targets) h = h * 1000003 + x;
+    return h;
+}
+
+int main() {
+    std::cout << "Loading raw edge list: " << test_file << std::endl;
+    uwudgraph::IdMap ids;
+    std::vector<uwudgraph::edge> edges = uwudgraph::read_raw_edgelist(test_file, ids);
+    uwudgraph::Graph* g = uwudgraph::build_graph(ids.size(), edges);
+    std::cout << "Number of nodes: " << g->n << std::endl;
+    std::cout << "Number of edges: " << g->m << std::endl;
+    // the self-loop and the repeated alice-bob edge are dropped
+    if (g->n != 8 || g->m != 6) {
+        print("Wrong size after id compaction");
+        return 1;
+    }
+
+    uwudgraph::node_id num_components = 0;
+    std::vector<uwudgraph::node_id> label = uwudgraph::connected_components(*g, num_components);
+    print("Component labels: ", label);
+    std::vector<uwudgraph::node_id> expected = {0, 0, 0, 0, 1, 1, 2, 2};
+    if (num_components != 3 || label != expected) {
+        print("Wrong connected components");
+        return 1;
+    }
+
+    std::vector<uwudgraph::node_id> new_id;
+    uwudgraph::Graph* sub = uwudgraph::extract_component(*g, label, uwudgraph::largest_component(label, num_components), new_id);
+    if (sub->n != 4 || sub->m != 4 || new_id[ids.get("dave")] != 3 || new_id[ids.get("eve")] != static_cast<uwudgraph::node_id>(-1)) {
+        print("Wrong largest component");
+        return 1;
+    }
+
+    uwudgraph::save_binary(bin_file, *sub);
+    uwudgraph::Graph* loaded = uwudgraph::load_graph(bin_file);
+    std::remove(bin_file.c_str());
+    if (loaded->n != sub->n || loaded->m != sub->m || loaded->offsets != sub->offsets || loaded->targets != sub->targets) {
+        print("Binary graph does not round-trip");
+        return 1;
+    }
+
+    // a wrong edge count, offsets that decrease, a target out of range and an edge count too large for
+    // edge_id (2^63 + m, whose doubled value still matches the offsets) are all rejected
+    int rejected = 0;
+    for (int corruption = 0; corruption < 4; ++corruption) {
+        uwudgraph::Graph bad = *sub;
+        if (corruption == 0) bad.m += 1;
+        if (corruption == 1) std::swap(bad.offsets[1], bad.offsets[2]);
+        if (corruption == 2) bad.targets[0] = bad.n;
+        uwudgraph::save_binary(bin_file, bad);
+        if (corruption == 3) {
+            uint64_t m = (uint64_t(1) << 63) + bad.m;
+            std::fstream fs(bin_file, std::ios::binary | std::ios::in | std::ios::out);
+            fs.seekp(sizeof(uwudgraph::binary_magic) + sizeof(uint64_t));
+            fs.write(reinterpret_cast<const char*>(&m), sizeof(m));
+        }
+        try {
+            delete uwudgraph::load_binary(bin_file);
+        } catch (const std::runtime_error& e) {
+            ++rejected;
+        }
+    }
+    std::remove(bin_file.c_str());
+    if (rejected != 4) {
+        print("Corrupt binary graph accepted");
+        return 1;
+    }
+
+    // integer ids are kept as 64-bit values
+    uwudgraph::IdMap int_ids("int");
+    if (int_ids.get("18446744073709551615") != 0 || int_ids.get("35") != 1 || int_ids.name(0) != "18446744073709551615") {
+        print("Wrong 64-bit id mapping");
+        return 1;
+    }
+
+    // build_graph needs O(n) extra memory whatever the thread count: after a build on one thread, a build on 16
+    // threads of many nodes and few edges raises the peak by far less than one n-sized array per thread
+    uwudgraph::node_id n = 2 << 20;
+    std::mt19937 gen(3);
+    std::uniform_int_distribution<uwudgraph::node_id> node(0, n - 1);
+    std::vector<uwudgraph::edge> random_edges(1 << 18);
+    for (auto& e : random_edges) e = {node(gen), node(gen)};
+    size_t threads = get_num_threads();
+    set_num_threads(1);
+    uwudgraph::Graph* one = uwudgraph::build_graph(n, random_edges);
+    size_t sum = checksum(*one);
+    delete one;
+    size_t peak = peak_rss_kb();
+    set_num_threads(16);
+    uwudgraph::Graph* many = uwudgraph::build_graph(n, random_edges);
+    size_t growth = peak_rss_kb() - peak;
+    set_num_threads(threads);
+    print("peak growth from 1 to 16 threads:", growth, "kB, one array of n counters:", n * sizeof(uwudgraph::edge_id) / 1024, "kB");
+    if (checksum(*many) != sum || growth > n * sizeof(uwudgraph::edge_id) / 1024) {
+        print("build_graph depends on the thread count");
+        return 1;
+    }
+    delete many;
+
+    delete g;
+    delete sub;
+    delete loaded;
+    return 0;
+}
@@ -0,0 +1,78 @@
+#include <iostream>
+#include <cmath>
+#include "convenientPrint.hpp"
+#include "random.hpp"
+
+#include "uwudgraph/dynamic_graph.hpp"
+#include "uwudgraph/apps/ssppr/ssppr_dynamic.hpp"
+
+using uwudgraph::Dangling;
+using uwudgraph::node_id;
+
+
+// exact PPR by power iteration, isolated nodes follow the dangling policy
+std::vector<double> power_iteration(const uwudgraph::DynamicGraph& g, node_id source, double alpha, Dangling dangling) {
+    std::vector<double> ppr(g.n, 0.0), next(g.n);
+    ppr[source] = 1.0;
+    for (int it = 0; it < 300; ++it) {
+        std::fill(next.begin(), next.end(), 0.0);
+        next[source] = alpha;
+        for (node_id u = 0; u < g.n; ++u) {
+            double mass = (1 - alpha) * ppr[u];
+            if (g.get_degree(u) == 0) {
+                if (dangling == Dangling::selfloop) next[u] += mass;
+                else if (dangling == Dangling::restart) next[source] += mass;
+                else for (double& x : next) x += mass / g.n;
+                continue;
+            }
+            for (node_id v : g.get_neighbors(u)) next[v] += mass / g.get_degree(u);
+        }
+        ppr.swap(next);
+    }
+    return ppr;
+}
+
+
+int main() {
+    node_id n = 300;
+    double alpha = 0.2, rmax = 1e-10;
+    for (std::string name : {"selfloop", "restart", "uniform"}) {
+        Dangling dangling = uwudgraph::parse_dangling(name);
+        uwudgraph::DynamicGraph g(n);
+        // a sparse random graph, leaving some nodes isolated for the dangling policy
+        while (g.m < 600) g.insert_edge(rand_uniform(n - 10), rand_uniform(n - 10));
+
+        uwudgraph::DynamicPPR dppr(g, alpha, rmax, dangling);
+        size_t full = dppr.track(0) + dppr.track(7);
+        for (int b = 0; b < 20; ++b) {
+            std::vector<uwudgraph::EdgeUpdate> batch;
+            for (int i = 0; i < 10; ++i) {
+                node_id u = rand_uniform(n), v = rand_uniform(n);
+                batch.push_back({u, v, i % 3 != 0 || !g.has_edge(u, v) ? true : false});
+                if (i % 3 == 0 && g.get_degree(u) > 0) batch.push_back({u, g.get_neighbors(u)[0], false});
+            }
+            dppr.update(batch);
+        }
+        print("Dangling policy:", name, "edges:", g.m);
+        print("Pushes to track two sources:", full, "to repair 20 batches:", dppr.pushes);
+
+        for (node_id s : {0, 7}) {
+            std::vector<double> exact = power_iteration(g, s, alpha, dangling);
+            const std::vector<double>& ppr = dppr.get_ppr(s);
+            double err = 0;
+            for (node_id u = 0; u < n; ++u) err = std::max(err, std::abs(ppr[u] - exact[u]));
+            print("Source", s, "max error against power iteration:", err);
+            if (err > 1e-6) {
+                print("Maintained PPR does not match power iteration");
+                return 1;
+            }
+            for (node_id u = 0; u < n; ++u) {
+                if (std::abs(dppr.get_residual(s)[u]) > std::max<node_id>(g.get_degree(u), 1) * rmax) {
+                    print("Residual above rmax after repair at node", u);
+                    return 1;
+                }
+            }
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,89 @@
+#include <iostream>
+#include <algorithm>
+#include <cmath>
+#include "convenientPrint.hpp"
+
+#include "uwudgraph/graph.hpp"
+#include "uwudgraph/graph_types.hpp"
+#include "uwudgraph/graphio.hpp"
+
+#include "uwudgraph/apps/generate/generate.hpp"
+#include "uwudgraph/apps/eigen/lanczos.hpp"
+
+std::string test_file = "test/uwudgraph/data/demo.txt";
+
+
+int main() {
+    std::cout << "Loading graph from edgelist file: " << test_file << std::endl;
+    uwudgraph::Graph* g = uwudgraph::load_edgelist(test_file);
+    std::cout << "Number of nodes: " << g->n << std::endl;
+    std::cout << "Number of edges: " << g->m << std::endl;
+
+    // The Laplacian spectrum of the demo graph is {0, 2, 4, 4}.
+    uwudgraph::EigenResult lap = uwudgraph::laplacian_smallest(*g, g->n, 1e-10, 100);
+    print("Laplacian eigenvalues: ", lap.values);
+    std::vector<double> expected = {0, 2, 4, 4};
+    for (size_t i = 0; i < expected.size(); ++i) {
+        if (std::abs(lap.values[i] - expected[i]) > 1e-8) {
+            print("Wrong Laplacian eigenvalue", i);
+            return 1;
+        }
+    }
+
+    // The largest eigenvalue of the normalized adjacency of a connected graph is 1,
+    // with eigenvector proportional to D^{1/2} 1.
+    uwudgraph::EigenResult adj = uwudgraph::normalized_adjacency_largest(*g, 2, 1e-10, 100, 1);
+    print("Normalized adjacency eigenvalues: ", adj.values);
+    print("Top eigenvector: ", adj.vectors[0]);
+    double d_sum = 2.0 * g->m;
+    for (uwudgraph::node_id u = 0; u < g->n; ++u) {
+        if (std::abs(adj.values[0] - 1.0) > 1e-8 || std::abs(adj.vectors[0][u] - std::sqrt(g->get_degree(u) / d_sum)) > 1e-6) {
+            print("Wrong top eigenpair of the normalized adjacency");
+            return 1;
+        }
+    }
+
+    // k < n on a 12 x 17 grid, whose Laplacian eigenvalues are (2 - 2 cos(pi i / 12)) + (2 - 2 cos(pi j / 17)):
+    // the eigenpairs must match them, satisfy L x = lambda x and be orthonormal
+    uwudgraph::GeneratorParams p;
+    p.rows = 12;
+    p.cols = 17;
+    uwudgraph::Graph* grid = uwudgraph::generate_graph("grid", p);
+    std::vector<double> spectrum;
+    for (size_t i = 0; i < p.rows; ++i) {
+        for (size_t j = 0; j < p.cols; ++j) {
+            spectrum.push_back(4.0 - 2.0 * std::cos(M_PI * i / p.rows) - 2.0 * std::cos(M_PI * j / p.cols));
+        }
+    }
+    std::sort(spectrum.begin(), spectrum.end());
+    size_t k = 8;
+    uwudgraph::EigenResult small = uwudgraph::laplacian_smallest(*grid, k, 1e-10, 200, 2);
+    print("Grid Laplacian eigenvalues: ", small.values, "spmv", small.spmv, "restarts", small.restarts);
+    if (!small.converged || small.values.size() != k || small.vectors.size() != k) {
+        print("Grid eigensolve did not converge");
+        return 1;
+    }
+    std::vector<double> lx(grid->n);
+    for (size_t i = 0; i < k; ++i) {
+        const std::vector<double>& x = small.vectors[i];
+        uwudgraph::laplacian_spmv(*grid, x, lx);
+        double residual = 0;
+        for (uwudgraph::node_id u = 0; u < grid->n; ++u) residual += std::pow(lx[u] - small.values[i] * x[u], 2);
+        if (std::abs(small.values[i] - spectrum[i]) > 1e-8 || std::sqrt(residual) > 1e-6) {
+            print("Wrong grid eigenpair", i, "residual", std::sqrt(residual));
+            return 1;
+        }
+        for (size_t j = 0; j <= i; ++j) {
+            double dot = 0;
+            for (uwudgraph::node_id u = 0; u < grid->n; ++u) dot += x[u] * small.vectors[j][u];
+            if (std::abs(dot - (i == j ? 1.0 : 0.0)) > 1e-8) {
+                print("Grid eigenvectors", i, j, "not orthonormal:", dot);
+                return 1;
+            }
+        }
+    }
+
+    delete grid;
+    delete g;
+    return 0;
+}
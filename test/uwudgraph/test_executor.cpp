@@ -0,0 +1,124 @@
+#include <atomic>
+#include <iostream>
+#include <mutex>
+#include "convenientPrint.hpp"
+
+#include "uwudgraph/graph.hpp"
+#include "uwudgraph/apps/generate/generate.hpp"
+#include "uwudgraph/apps/ssppr/ssppr_executor.hpp"
+
+
+int main() {
+    uwudgraph::GeneratorParams p;
+    p.n = 2000;
+    p.m = 20000;
+    uwudgraph::Graph* g = uwudgraph::generate_graph("er", p);
+
+    // answers match the blocking call
+    {
+        uwudgraph::ExecutorConfig config;
+        config.threads = 3;
+        config.max_pending = 4;
+        uwudgraph::SSPPRExecutor<uwudgraph::Graph> executor(*g, config);
+        std::vector<std::future<uwudgraph::SSPPRAnswer>> answers;
+        for (uwudgraph::node_id s = 0; s < 20; ++s) {
+            uwudgraph::SSPPRQuery q;
+            q.source = s;
+            q.method = "push";
+            answers.push_back(executor.submit(q));
+        }
+        for (uwudgraph::node_id s = 0; s < 20; ++s) {
+            std::vector<double> expected = uwudgraph::SSPPR(*g, s, 0.2, "push", 0, 0, 0, 0, 0, 0, 0, 0);
+            if (answers[s].get().ppr != expected) {
+                print("Wrong answer for source", s);
+                return 1;
+            }
+        }
+    }
+
+    // one thread kept busy by an anytime query until it is cancelled
+    uwudgraph::ExecutorConfig config;
+    config.threads = 1;
+    config.max_pending = 2;
+    uwudgraph::SSPPRExecutor<uwudgraph::Graph> executor(*g, config);
+    std::atomic<bool> cancel{false};
+    uwudgraph::SSPPRQuery blocker;
+    blocker.method = "anytime";
+    blocker.eps = 1e-4;
+    blocker.budget.cancel = &cancel;
+    std::future<uwudgraph::SSPPRAnswer> blocked = executor.submit(blocker);
+    while (executor.running() == 0) std::this_thread::yield();
+
+    // waiting queries run by priority, and the queue refuses a third one
+    std::mutex mutex;
+    std::vector<int> order;
+    auto record = [&](int tag) {
+        return [&, tag](uwudgraph::SSPPRAnswer* answer, std::exception_ptr error) {
+            std::lock_guard<std::mutex> lock(mutex);
+            order.push_back(answer != nullptr && !error ? tag : -1);
+        };
+    };
+    uwudgraph::SSPPRQuery low, high;
+    low.method = high.method = "push";
+    low.priority = 0;
+    high.priority = 5;
+    executor.submit(low, record(0));
+    executor.submit(high, record(5));
+    std::future<uwudgraph::SSPPRAnswer> rejected;
+    if (executor.try_submit(low, rejected) || rejected.valid() || executor.pending() != 2) {
+        print("Full queue accepted a query");
+        return 1;
+    }
+    cancel = true;
+    uwudgraph::SSPPRAnswer answer = blocked.get();
+    print("cancelled query: stop", uwudgraph::anytime_stop_name(answer.anytime.stop), "run seconds", answer.run_seconds);
+    if (answer.anytime.stop != uwudgraph::AnytimeStop::cancelled || answer.ppr.size() != g->n) {
+        print("Wrong answer of the cancelled query");
+        return 1;
+    }
+
+    // errors reach the future
+    uwudgraph::SSPPRQuery bad;
+    bad.method = "nonexistent";
+    std::future<uwudgraph::SSPPRAnswer> failed = executor.submit(bad);
+    bool threw = false;
+    try {
+        failed.get();
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    executor.shutdown();
+    print("completion order:", order);
+    if (!threw || order != std::vector<int>{5, 0}) {
+        print("Wrong priority order or error handling");
+        return 1;
+    }
+    std::future<uwudgraph::SSPPRAnswer> late;
+    if (executor.try_submit(low, late)) {
+        print("Shut down executor accepted a query");
+        return 1;
+    }
+
+    // a throwing callback is dropped and its thread serves on; shutdown() from a callback stops the executor
+    // without joining the calling thread, which the destructor does afterwards
+    {
+        uwudgraph::ExecutorConfig one;
+        one.threads = 1;
+        uwudgraph::SSPPRExecutor<uwudgraph::Graph> stopper(*g, one);
+        uwudgraph::SSPPRQuery q;
+        q.method = "push";
+        stopper.submit(q, [](uwudgraph::SSPPRAnswer*, std::exception_ptr) { throw std::runtime_error("callback failed"); });
+        std::promise<bool> stopped;
+        stopper.submit(q, [&](uwudgraph::SSPPRAnswer* answer, std::exception_ptr) {
+            stopper.shutdown();
+            stopped.set_value(answer != nullptr);
+        });
+        std::future<uwudgraph::SSPPRAnswer> after;
+        if (!stopped.get_future().get() || stopper.try_submit(q, after)) {
+            print("Callback exception or shutdown from a callback mishandled");
+            return 1;
+        }
+    }
+    delete g;
+    return 0;
+}
@@ -0,0 +1,70 @@
+#include <iostream>
+#include "convenientPrint.hpp"
+#include "multithread/parallel.hpp"
+
+#include "uwudgraph/graph.hpp"
+#include "uwudgraph/apps/generate/generate.hpp"
+
+
+int main() {
+    uwudgraph::GeneratorParams p;
+    p.scale = 12;
+    p.n = 5000;
+    p.m = 80000;
+    p.k = 4;
+    p.blocks = 5;
+    p.rows = 60;
+    p.cols = 70;
+    p.seed = 7;
+
+    for (std::string model : {"rmat", "er", "ba", "sbm", "grid"}) {
+        set_num_threads(1);
+        uwudgraph::Graph* g1 = uwudgraph::generate_graph(model, p);
+        set_num_threads(4);
+        uwudgraph::Graph* g4 = uwudgraph::generate_graph(model, p);
+        print(model, "nodes:", g1->n, "edges:", g1->m);
+        // the graph depends on the seed only, not on the number of threads
+        if (g1->n != g4->n || g1->m != g4->m || g1->offsets != g4->offsets || g1->targets != g4->targets) {
+            print("Generator", model, "is not deterministic across thread counts");
+            return 1;
+        }
+        if (g1->m == 0) {
+            print("Generator", model, "produced no edges");
+            return 1;
+        }
+        delete g1;
+        delete g4;
+    }
+
+    // a full lattice has rows * (cols - 1) + cols * (rows - 1) edges
+    uwudgraph::Graph* grid = uwudgraph::generate_graph("grid", p);
+    if (grid->m != p.rows * (p.cols - 1) + p.cols * (p.rows - 1)) {
+        print("Wrong number of grid edges");
+        return 1;
+    }
+    // every Barabasi-Albert node after the first attaches with up to k edges, node 0 becomes a hub
+    uwudgraph::Graph* ba = uwudgraph::generate_graph("ba", p);
+    if (ba->get_degree(0) < 10 * p.k) {
+        print("Barabasi-Albert graph has no early hub");
+        return 1;
+    }
+    // most sbm edges stay inside a block
+    p.mu = 0.1;
+    uwudgraph::Graph* sbm = uwudgraph::generate_graph("sbm", p);
+    size_t inside = 0, arcs = 0;
+    for (uwudgraph::node_id u = 0; u < sbm->n; ++u) {
+        for (uwudgraph::node_id v : sbm->get_neighbors(u)) {
+            inside += u / (p.n / p.blocks) == v / (p.n / p.blocks);
+            ++arcs;
+        }
+    }
+    print("sbm edges inside blocks:", static_cast<double>(inside) / arcs);
+    if (inside < 0.85 * arcs) {
+        print("Stochastic block model does not respect its blocks");
+        return 1;
+    }
+    delete grid;
+    delete ba;
+    delete sbm;
+    return 0;
+}
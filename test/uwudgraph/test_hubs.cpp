@@ -0,0 +1,150 @@
+#define SSPPR_STATS
+
+#include <cstdio>
+#include <iostream>
+#include "benchmark.hpp"
+#include "convenientPrint.hpp"
+
+#include "uwudgraph/graph.hpp"
+#include "uwdigraph/graph.hpp"
+#include "uwudgraph/apps/generate/generate.hpp"
+#include "uwudgraph/apps/ssppr/ssppr.hpp"
+#include "uwudgraph/apps/ssppr/ssppr_hubs.hpp"
+#include "uwudgraph/apps/accuracy/accuracy.hpp"
+
+
+// edges scanned by a push, hub entries added in place of pushes included
+template <class F>
+size_t work_of(F&& push) {
+    uwudgraph::__ssppr_detail::stats() = uwudgraph::SSPPRStats();
+    push();
+    return uwudgraph::__ssppr_detail::stats().edges_scanned;
+}
+
+int main() {
+    uwudgraph::GeneratorParams p;
+    p.scale = 12;
+    p.m = 16 << 12;
+    uwudgraph::Graph* g = uwudgraph::generate_graph("rmat", p);
+    double alpha = 0.2, rmax = 1e-6, eps = 0.3, delta = 1.0 / g->n, pf = 1.0 / g->n;
+    uwudgraph::HubIndex index = uwudgraph::build_hub_index(*g, alpha, rmax, 8 << 20);
+    print("hubs", index.hubs().size(), "entries", index.entries(), "bytes", index.bytes());
+    if (index.hubs().empty() || index.bytes() > (8 << 20)) {
+        print("Hub index ignores its budget");
+        return 1;
+    }
+    for (size_t i = 1; i < index.hubs().size(); ++i) {
+        if (g->get_neighbor_count(index.hubs()[i]) > g->get_neighbor_count(index.hubs()[i - 1])) {
+            print("Hubs not taken by decreasing degree");
+            return 1;
+        }
+    }
+
+    // pushing through the hubs keeps the invariant and the rmax bound, and from a node next to the largest hub, which
+    // gets much of its mass, costs less work: edges scanned plus the entries of the hub vectors added
+    uwudgraph::node_id source = index.hubs()[0];
+    g->for_each_neighbor(index.hubs()[0], [&](uwudgraph::node_id v, double) {
+        if (index.find(v) == uwudgraph::HubIndex::none && (source == index.hubs()[0] || g->get_neighbor_count(v) < g->get_neighbor_count(source))) source = v;
+    });
+    std::vector<double> exact = uwudgraph::ppr_power_iteration(*g, source, alpha, 1e-12);
+    std::vector<double> ppr, r;
+    size_t hub_work = work_of([&] { std::tie(ppr, r) = uwudgraph::ppr_forwardpush(*g, index, source, alpha, rmax); });
+    size_t plain_work = work_of([&] { uwudgraph::ppr_forwardpush(*g, source, alpha, rmax); });
+    double l1 = 0, residual = 0;
+    for (uwudgraph::node_id v = 0; v < g->n; ++v) {
+        l1 += std::abs(exact[v] - ppr[v]);
+        residual += r[v];
+        if (r[v] > std::max<double>(g->get_degree(v), 1) * rmax) {
+            print("Residual above rmax at", v);
+            return 1;
+        }
+    }
+    print("work: with hubs", hub_work, "without", plain_work, "l1", l1, "residual", residual);
+    if (std::abs(l1 - residual) > 1e-6 || hub_work >= plain_work) {
+        print("Hub push lost its invariant or is not cheaper");
+        return 1;
+    }
+    std::vector<double> fora = uwudgraph::ppr_fora(*g, index, source, alpha, eps, delta, pf);
+    double fora_err = uwudgraph::accuracy_metrics(exact, fora, 0, delta).max_rel_err;
+    print("fora error", fora_err);
+    if (fora_err > eps) {
+        print("FORA through the hubs too far off");
+        return 1;
+    }
+
+    // a saved index answers like the original
+    std::string path = "test/uwudgraph/data/test_hubs.bin";
+    uwudgraph::save_hub_index(path, index);
+    uwudgraph::HubIndex loaded = uwudgraph::load_hub_index(path);
+    std::remove(path.c_str());
+    if (loaded.hubs() != index.hubs() || uwudgraph::ppr_forwardpush(*g, loaded, source, alpha, rmax).first != ppr) {
+        print("Loaded hub index differs");
+        return 1;
+    }
+
+    // on a directed graph under the uniform policy the hubs park mass at dangling nodes as a scalar, which a query
+    // adds to its own: the push through the hubs still keeps the invariant
+    uwdigraph::Graph dag;
+    dag.n = g->n;
+    dag.offsets.assign(g->n + 1, 0);
+    for (uwudgraph::node_id u = 0; u < g->n; ++u) {
+        for (uwudgraph::node_id v : g->get_neighbors(u)) {
+            if (u < v) dag.targets.push_back(v);
+        }
+        dag.offsets[u + 1] = dag.targets.size();
+    }
+    dag.m = dag.targets.size();
+    uwudgraph::HubIndex uniform = uwudgraph::build_hub_index(dag, alpha, rmax, 8 << 20, 0, uwudgraph::Dangling::uniform);
+    double jumps = 0;
+    for (uint32_t i = 0; i < uniform.hubs().size(); ++i) jumps += uniform.jump(i);
+    uwudgraph::node_id dag_source = 0;
+    while (dag.get_neighbor_count(dag_source) == 0 || uniform.find(dag_source) != uwudgraph::HubIndex::none) ++dag_source;
+    exact = uwudgraph::ppr_power_iteration(dag, dag_source, alpha, 1e-12, uwudgraph::Dangling::uniform);
+    std::tie(ppr, r) = uwudgraph::ppr_forwardpush(dag, uniform, dag_source, alpha, rmax);
+    l1 = residual = 0;
+    for (uwudgraph::node_id v = 0; v < dag.n; ++v) {
+        l1 += std::abs(exact[v] - ppr[v]);
+        residual += r[v];
+    }
+    print("uniform: hubs", uniform.hubs().size(), "jump mass", jumps, "l1", l1, "residual", residual);
+    if (jumps <= 0 || std::abs(l1 - residual) > 1e-6) {
+        print("Hub push lost the uniform mass");
+        return 1;
+    }
+
+    // corrupt files, other alphas and graphs, and the restart policy are rejected
+    int rejected = 0;
+    std::vector<uint8_t> stream;
+    uwudgraph::serialize_hub_index(index, stream);
+    stream.pop_back();
+    try {
+        uwudgraph::deserialize_hub_index(stream);
+    } catch (const std::invalid_argument& e) {
+        ++rejected;
+    }
+    try {
+        uwudgraph::ppr_forwardpush(*g, index, source, 0.15, rmax);
+    } catch (const std::invalid_argument& e) {
+        ++rejected;
+    }
+    p.m += 10;
+    uwudgraph::Graph* other = uwudgraph::generate_graph("rmat", p);
+    try {
+        uwudgraph::ppr_forwardpush(*other, index, source, alpha, rmax);
+    } catch (const std::invalid_argument& e) {
+        ++rejected;
+    }
+    try {
+        uwudgraph::build_hub_index(*g, alpha, rmax, 8 << 20, 0, uwudgraph::Dangling::restart);
+    } catch (const std::invalid_argument& e) {
+        ++rejected;
+    }
+    if (rejected != 4) {
+        print("Bad hub index, alpha, graph or policy accepted");
+        return 1;
+    }
+
+    delete other;
+    delete g;
+    return 0;
+}
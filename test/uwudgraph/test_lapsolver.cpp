@@ -0,0 +1,44 @@
+#include <iostream>
+#include <cmath>
+#include "convenientPrint.hpp"
+
+#include "uwudgraph/graph.hpp"
+#include "uwudgraph/graph_types.hpp"
+#include "uwudgraph/graphio.hpp"
+
+#include "uwudgraph/apps/lapsolver/lapsolver.hpp"
+
+std::string test_file = "test/uwudgraph/data/demo.txt";
+
+
+int main() {
+    std::cout << "Loading graph from edgelist file: " << test_file << std::endl;
+    uwudgraph::Graph* g = uwudgraph::load_edgelist(test_file);
+    std::cout << "Number of nodes: " << g->n << std::endl;
+    std::cout << "Number of edges: " << g->m << std::endl;
+
+    // The effective resistance between 0 and 3 of the demo graph is 1: two disjoint 2-hop paths,
+    // and the edge 1-2 carries no current by symmetry.
+    std::vector<double> b(g->n, 0.0);
+    b[0] = 1.0;
+    b[3] = -1.0;
+    for (std::string preconditioner : {"jacobi", "ic"}) {
+        uwudgraph::LaplacianSolver solver(*g, preconditioner);
+        std::vector<double> x;
+        uwudgraph::CGStats stats = solver.solve(b, x, 1e-12, 100);
+        print("Solution by", preconditioner, ":", x);
+        print("Iterations:", stats.iterations, "residuals:", stats.residual_norms);
+        if (!stats.converged || std::abs(x[0] - x[3] - 1.0) > 1e-9) {
+            print("Wrong Laplacian solution with preconditioner", preconditioner);
+            return 1;
+        }
+
+        // warm start from the solution converges immediately
+        stats = solver.solve(b, x, 1e-10, 100);
+        if (stats.iterations != 0) {
+            print("Warm start did not reuse the solution with preconditioner", preconditioner);
+            return 1;
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,120 @@
+#include <cstdint>
+#include <iostream>
+#include "convenientPrint.hpp"
+#include "memory.hpp"
+
+#include "uwudgraph/graph.hpp"
+#include "uwudgraph/apps/generate/generate.hpp"
+#include "uwudgraph/apps/ssppr/ssppr.hpp"
+
+
+// huge_vector, assign_workspace and Arena behave the same whether huge pages are advised or not
+bool check_allocation() {
+    // large arrays start at a huge page boundary, small ones come from the heap, and both keep their values
+    huge_vector<uint32_t> large(3 << 20), small(100);
+    for (size_t i = 0; i < large.size(); ++i) large[i] = static_cast<uint32_t>(i);
+    if (reinterpret_cast<uintptr_t>(large.data()) % (2 << 20) != 0 || large[12345] != 12345 || small[99] != 0) {
+        print("Huge page allocation misplaced or lost values");
+        return false;
+    }
+    large.resize(5 << 20, 7);
+    if (large[(3 << 20) - 1] != (3u << 20) - 1 || large.back() != 7) {
+        print("Growing a huge_vector lost values");
+        return false;
+    }
+
+    // a workspace keeps its storage when it does not grow and is refilled with the value
+    std::vector<double> ws;
+    assign_workspace(ws, 1 << 20, 1.5);
+    double* storage = ws.data();
+    ws[7] = 2.0;
+    assign_workspace(ws, 1 << 19, 0.0);
+    if (ws.data() != storage || ws.size() != (1u << 19) || ws[7] != 0.0) {
+        print("Workspace reallocated or not refilled");
+        return false;
+    }
+
+    // the arena aligns its objects and after a reset serves the same load from a single block
+    Arena arena(256);
+    std::vector<uint64_t*> objects;
+    for (size_t i = 0; i < 100; ++i) {
+        arena.allocate<uint8_t>(i % 3 + 1);
+        uint64_t* p = arena.allocate<uint64_t>(i + 1);
+        p[i] = i;
+        objects.push_back(p);
+        if (reinterpret_cast<uintptr_t>(p) % alignof(uint64_t) != 0) {
+            print("Arena object misaligned");
+            return 1;
+        }
+    }
+    for (size_t i = 0; i < 100; ++i) {
+        if (objects[i][i] != i) {
+            print("Arena objects overlap");
+            return 1;
+        }
+    }
+    size_t capacity = arena.capacity();
+    arena.reset();
+    uint8_t* first = arena.allocate<uint8_t>(capacity);
+    if (arena.capacity() != capacity || arena.allocate<uint8_t>(1) == first) {
+        print("Arena reset does not keep one block of its capacity");
+        return false;
+    }
+    // a block of 2MB and more is mapped rather than taken from the heap
+    uint64_t* big = arena.allocate<uint64_t>(1 << 19);
+    big[0] = 1;
+    big[(1 << 19) - 1] = 2;
+    if (arena.capacity() < capacity + (4u << 20) || big[0] != 1 || big[(1 << 19) - 1] != 2) {
+        print("Large arena block lost values");
+        return false;
+    }
+    return true;
+}
+
+
+int main() {
+    for (bool on : {true, false}) {
+        set_huge_pages(on);
+        if (!check_allocation()) {
+            print("Allocation checks failed with huge pages", on ? "on" : "off");
+            return 1;
+        }
+    }
+    set_huge_pages(true);
+
+    // the placement switches work and a bad policy name is rejected
+    set_huge_pages(false);
+    set_numa_policy(NumaPolicy::first_touch);
+    huge_vector<double> plain(1 << 20, 1.0);
+    set_huge_pages(true);
+    set_numa_policy(parse_numa_policy("interleave"));
+    if (plain[12345] != 1.0 || numa_policy() != NumaPolicy::interleave || !huge_pages()) {
+        print("Memory switches broken");
+        return 1;
+    }
+    try {
+        parse_numa_policy("remote");
+        print("Unknown NUMA policy accepted");
+        return 1;
+    } catch (const std::invalid_argument& e) {
+    }
+
+    // a graph on huge pages gives the same PPR with huge pages off
+    uwudgraph::GeneratorParams p;
+    p.scale = 15;
+    p.m = 16 << 15;
+    uwudgraph::Graph* g = uwudgraph::generate_graph("rmat", p);
+    std::vector<double> ppr = uwudgraph::ppr_forwardpush(*g, 0, 0.2, 1e-7).first;
+    set_huge_pages(false);
+    uwudgraph::Graph* h = uwudgraph::generate_graph("rmat", p);
+    set_huge_pages(true);
+    if (h->targets != g->targets || uwudgraph::ppr_forwardpush(*h, 0, 0.2, 1e-7).first != ppr) {
+        print("Graph depends on huge pages");
+        return 1;
+    }
+    print("graph offsets", g->offsets.size() * sizeof(size_t), "bytes, targets", g->targets.size() * sizeof(uwudgraph::node_id), "bytes");
+
+    delete h;
+    delete g;
+    return 0;
+}
@@ -0,0 +1,74 @@
+#include <iostream>
+#include "benchmark.hpp"
+#include "convenientPrint.hpp"
+
+#include "uwudgraph/graph.hpp"
+#include "uwudgraph/apps/generate/generate.hpp"
+#include "uwudgraph/apps/ssppr/ssppr.hpp"
+#include "uwudgraph/apps/accuracy/accuracy.hpp"
+
+
+int main() {
+    uwudgraph::GeneratorParams p;
+    p.n = 2000;
+    p.m = 20000;
+    uwudgraph::Graph* g = uwudgraph::generate_graph("er", p);
+    std::vector<double> alphas = {0.2, 0.1, 0.3, 0.15};
+    double eps = 0.3, delta = 1.0 / g->n, pf = 1.0 / g->n, rmax = 1e-5;
+    std::vector<std::vector<double>> exact;
+    for (double alpha : alphas) exact.push_back(uwudgraph::ppr_power_iteration(*g, 0, alpha, 1e-12));
+
+    // every push lane keeps its invariant: the L1 error is the residual left, and no residual is above rmax
+    std::vector<double> sorted = {0.3, 0.2, 0.15, 0.1};
+    CountingGraph<uwudgraph::Graph> counted(*g);
+    uwudgraph::__ssppr_detail::Lanes lanes = uwudgraph::__ssppr_detail::forwardpush_multi(counted, 0, sorted, rmax, uwudgraph::Dangling::selfloop);
+    for (size_t i = 0; i < sorted.size(); ++i) {
+        std::vector<double> truth = uwudgraph::ppr_power_iteration(*g, 0, sorted[i], 1e-12);
+        double l1 = 0, residual = 0;
+        for (uwudgraph::node_id v = 0; v < g->n; ++v) {
+            l1 += std::abs(truth[v] - lanes.ppr[v * lanes.k + i]);
+            residual += lanes.r[v * lanes.k + i];
+            if (lanes.r[v * lanes.k + i] > g->get_degree(v) * rmax) {
+                print("Residual above rmax in lane", i);
+                return 1;
+            }
+        }
+        if (std::abs(l1 - residual) > 1e-6) {
+            print("Push lane", i, "lost its invariant", l1, residual);
+            return 1;
+        }
+    }
+
+    // and the shared push costs about the push of the smallest alpha, not the sum over all alphas
+    size_t shared = counted.edges, separate = 0, smallest = 0;
+    for (double alpha : sorted) {
+        CountingGraph<uwudgraph::Graph> one(*g);
+        uwudgraph::ppr_forwardpush(one, 0, alpha, rmax);
+        separate += one.edges;
+        smallest = one.edges;
+    }
+    print("edges scanned: shared", shared, "smallest alpha", smallest, "all alphas", separate);
+    if (shared > 1.5 * smallest || shared >= separate) {
+        print("Shared push is not cheaper than separate ones");
+        return 1;
+    }
+
+    // results come back in the order of alphas, with the accuracy of the single-alpha methods
+    std::vector<std::vector<double>> fora = uwudgraph::SSPPR(*g, 0, alphas, "fora", eps, delta, pf, 0, 0, 0, 0, 0);
+    std::vector<std::vector<double>> rw = uwudgraph::SSPPR(*g, 0, alphas, "rw", 0, 0, 0, 0, 100000, 0, 0, 0);
+    std::vector<std::vector<double>> speedppr = uwudgraph::SSPPR(*g, 0, alphas, "speedppr", eps, delta, pf, 0, 0, 0, 0, 0);
+    for (size_t i = 0; i < alphas.size(); ++i) {
+        double fora_err = uwudgraph::accuracy_metrics(exact[i], fora[i], 0, delta).max_rel_err;
+        double speedppr_err = uwudgraph::accuracy_metrics(exact[i], speedppr[i], 0, delta).max_rel_err;
+        double rw_err = 0;
+        for (uwudgraph::node_id v = 0; v < g->n; ++v) rw_err = std::max(rw_err, std::abs(rw[i][v] - exact[i][v]));
+        print("alpha", alphas[i], ": fora error", fora_err, "speedppr error", speedppr_err, "rw max abs error", rw_err);
+        if (fora_err > eps || speedppr_err > eps || rw_err > 0.01) {
+            print("Multi-alpha estimate too far off for alpha", alphas[i]);
+            return 1;
+        }
+    }
+
+    delete g;
+    return 0;
+}
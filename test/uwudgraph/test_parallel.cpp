@@ -0,0 +1,86 @@
+#include <atomic>
+#include <iostream>
+#include <stdexcept>
+#include <thread>
+#include "convenientPrint.hpp"
+#include "multithread/parallel.hpp"
+
+
+// every index of [0, n) is visited exactly once
+bool covers(size_t n, size_t grain) {
+    std::vector<std::atomic<int>> hits(n);
+    parallel_for(0, n, [&](size_t i){ hits[i].fetch_add(1, std::memory_order_relaxed); }, grain);
+    for (auto &h : hits) {
+        if (h.load() != 1) return false;
+    }
+    return true;
+}
+
+int main() {
+    for (size_t threads : {1, 2, 4, 7}) {
+        set_num_threads(threads);
+        for (size_t grain : {1, 3, 100, 1024}) {
+            for (size_t n : {0, 1, 5, 1000, 100003}) {
+                if (!covers(n, grain)) {
+                    print("Wrong coverage with threads", threads, "grain", grain, "n", n);
+                    return 1;
+                }
+            }
+        }
+        // chunks keep at least grain indices
+        std::atomic<size_t> smallest{1 << 30};
+        parallel_for_chunks(0, 100000, [&](size_t lo, size_t hi){
+            size_t s = smallest.load();
+            while (hi - lo < s && !smallest.compare_exchange_weak(s, hi - lo)) {}
+        }, 1000);
+        double sum = parallel_reduce(0, 1000000, 0.0, [](size_t i){ return static_cast<double>(i); }, std::plus<double>(), 64);
+        if (smallest.load() < 1000 || sum != 499999500000.0) {
+            print("Wrong chunks or reduction with threads", threads);
+            return 1;
+        }
+    }
+
+    // nested loops run on the same pool and finish
+    set_num_threads(4);
+    std::atomic<size_t> inner{0};
+    parallel_for(0, 64, [&](size_t){
+        parallel_for(0, 5000, [&](size_t j){ inner.fetch_add(j, std::memory_order_relaxed); }, 16);
+    }, 1);
+    if (inner.load() != 64ull * 5000 * 4999 / 2) {
+        print("Wrong nested loops");
+        return 1;
+    }
+
+    // loops from threads outside the pool share it
+    std::vector<std::thread> callers;
+    std::atomic<bool> ok{true};
+    for (int t = 0; t < 3; ++t) {
+        callers.emplace_back([&]{
+            for (int rep = 0; rep < 20; ++rep) ok = ok && covers(20000, 10);
+        });
+    }
+    for (auto &t : callers) t.join();
+    if (!ok) {
+        print("Wrong coverage from concurrent callers");
+        return 1;
+    }
+
+    // an exception in a body reaches the caller after the loop
+    bool caught = false;
+    try {
+        parallel_for(0, 100000, [&](size_t i){ if (i == 77777) throw std::runtime_error("body failed"); }, 100);
+    } catch (const std::runtime_error &e) {
+        caught = std::string(e.what()) == "body failed";
+    }
+    if (!caught) {
+        print("Exception was not rethrown");
+        return 1;
+    }
+
+    set_thread_pinning(true);
+    if (!covers(100000, 100)) {
+        print("Wrong coverage with pinned threads");
+        return 1;
+    }
+    return 0;
+}
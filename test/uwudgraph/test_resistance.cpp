@@ -0,0 +1,116 @@
+#include <iostream>
+#include <cmath>
+#include "convenientPrint.hpp"
+
+#include "uwudgraph/graph.hpp"
+#include "uwudgraph/graph_types.hpp"
+
+#include "uwudgraph/apps/component/compact.hpp"
+#include "uwudgraph/apps/resistance/resistance.hpp"
+
+
+// exact R_alpha(s, t) = b^T (D - (1 - alpha) A)^{-1} b, b = e_s - e_t, by Jacobi iteration (a contraction by 1 - alpha)
+double exact_resistance_alpha(const uwudgraph::Graph& g, uwudgraph::node_id s, uwudgraph::node_id t, double alpha) {
+    std::vector<double> x(g.n, 0.0), next(g.n);
+    for (int it = 0; it < 2000; ++it) {
+        for (uwudgraph::node_id u = 0; u < g.n; ++u) {
+            double acc = (u == s) - (u == t);
+            for (uwudgraph::node_id v : g.get_neighbors(u)) acc += (1 - alpha) * x[v];
+            next[u] = acc / g.get_degree(u);
+        }
+        x.swap(next);
+    }
+    return x[s] - x[t];
+}
+
+
+int main() {
+    double eps = 0.3;
+
+    // a complete binary tree: every edge is a bridge with R = 1, and R between two nodes is their distance
+    std::vector<uwudgraph::edge> edges;
+    for (uwudgraph::node_id u = 1; u < 15; ++u) edges.emplace_back((u - 1) / 2, u);
+    uwudgraph::Graph* tree = uwudgraph::build_graph(15, edges);
+    uwudgraph::ResistanceSketch tree_sketch(*tree, eps, 0, "jacobi", 1e-10);
+    std::cout << "Sketch dimension: " << tree_sketch.dim() << std::endl;
+    auto tree_edges = tree_sketch.all_edges();
+    print("Tree edge resistances: ", tree_edges.second);
+    if (tree_edges.first.size() != 14) {
+        print("Wrong number of edges from all_edges");
+        return 1;
+    }
+    for (double r : tree_edges.second) {
+        if (std::abs(r - 1.0) > eps) {
+            print("Wrong resistance of a tree edge");
+            return 1;
+        }
+    }
+    // leaves 7 and 14 are 6 hops apart through the root
+    if (std::abs(tree_sketch.query(7, 14) - 6.0) > eps * 6.0 || tree_sketch.query(3, 3) != 0.0) {
+        print("Wrong resistance between tree nodes");
+        return 1;
+    }
+
+    // a cycle of n nodes: R(0, k) = k (n - k) / n, checked against the sketch and an exact Laplacian solve
+    uwudgraph::node_id n = 12;
+    edges.clear();
+    for (uwudgraph::node_id u = 0; u < n; ++u) edges.emplace_back(u, (u + 1) % n);
+    uwudgraph::Graph* cycle = uwudgraph::build_graph(n, edges);
+    uwudgraph::ResistanceSketch cycle_sketch(*cycle, eps, 0, "jacobi", 1e-10);
+    uwudgraph::LaplacianSolver solver(*cycle, "jacobi");
+    std::vector<uwudgraph::edge> pairs;
+    for (uwudgraph::node_id k = 1; k < n; ++k) pairs.emplace_back(0, k);
+    std::vector<double> sketched = cycle_sketch.query_batch(pairs);
+    print("Cycle resistances R(0, k): ", sketched);
+    for (uwudgraph::node_id k = 1; k < n; ++k) {
+        double expected = static_cast<double>(k) * (n - k) / n;
+        std::vector<double> b(n, 0.0), x;
+        b[0] = 1.0;
+        b[k] = -1.0;
+        solver.solve(b, x, 1e-12, 1000);
+        if (std::abs(x[0] - x[k] - expected) > 1e-8) {
+            print("Wrong exact resistance on the cycle at k =", k);
+            return 1;
+        }
+        if (std::abs(sketched[k - 1] - expected) > eps * expected) {
+            print("Sketched resistance off by more than eps on the cycle at k =", k);
+            return 1;
+        }
+    }
+
+    // a path of n nodes: R(0, k) = k. The local estimator returns R_alpha, which must match the exact R_alpha and
+    // lie within the bias bound R / (1 - alpha + alpha / lambda_2) <= R_alpha <= R / (1 - alpha / 2) of the header.
+    edges.clear();
+    for (uwudgraph::node_id u = 0; u + 1 < n; ++u) edges.emplace_back(u, u + 1);
+    uwudgraph::Graph* path = uwudgraph::build_graph(n, edges);
+    struct Case { const uwudgraph::Graph* g; double lambda2; };
+    std::vector<Case> cases = {{path, 1 - std::cos(M_PI / (n - 1))}, {cycle, 1 - std::cos(2 * M_PI / n)}};
+    for (const Case& c : cases) {
+        for (double alpha : {0.01, 0.2}) {
+            for (uwudgraph::node_id k : {1, 3, 6}) {
+                double r = c.g == path ? k : static_cast<double>(k) * (n - k) / n;
+                double r_alpha = exact_resistance_alpha(*c.g, 0, k, alpha);
+                double local = uwudgraph::resistance_alpha_local(*c.g, 0, k, alpha, 1e-12, 10);
+                print("alpha", alpha, "k", k, "R", r, "R_alpha", r_alpha, "local", local);
+                if (std::abs(local - r_alpha) > 1e-4 * r_alpha) {
+                    print("Local estimate does not match R_alpha");
+                    return 1;
+                }
+                if (r_alpha < r / (1 - alpha + alpha / c.lambda2) - 1e-9 || r_alpha > r / (1 - alpha / 2) + 1e-9) {
+                    print("R_alpha outside the bias bound");
+                    return 1;
+                }
+            }
+        }
+    }
+    if (uwudgraph::resistance_alpha_local(*path, 4, 4, 0.2, 1e-6, 10) != 0.0) {
+        print("Local resistance of a node to itself is not 0");
+        return 1;
+    }
+
+    delete tree;
+    delete cycle;
+    delete path;
+    std::cout << "Test successfully." << std::endl;
+    return 0;
+}
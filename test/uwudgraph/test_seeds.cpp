@@ -0,0 +1,124 @@
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include "benchmark.hpp"
+#include "convenientPrint.hpp"
+
+#include "uwudgraph/graph.hpp"
+#include "uwudgraph/apps/generate/generate.hpp"
+#include "uwudgraph/apps/ssppr/ssppr.hpp"
+#include "uwudgraph/apps/accuracy/accuracy.hpp"
+
+
+// power iteration of PageRank personalized by seeds, dangling nodes jumping back to the seeds
+std::vector<double> seeded_power_iteration(const uwudgraph::Graph& g, const uwudgraph::SeedSet& seeds, double alpha) {
+    std::vector<double> ppr(g.n, 0.0), x(g.n, 0.0), y(g.n);
+    for (size_t i = 0; i < seeds.nodes.size(); ++i) x[seeds.nodes[i]] += seeds.weights[i];
+    for (int it = 0; it < 200; ++it) {
+        std::fill(y.begin(), y.end(), 0.0);
+        for (uwudgraph::node_id u = 0; u < g.n; ++u) {
+            ppr[u] += alpha * x[u];
+            double rest = (1 - alpha) * x[u];
+            if (g.get_neighbor_count(u) == 0) {
+                for (size_t i = 0; i < seeds.nodes.size(); ++i) y[seeds.nodes[i]] += rest * seeds.weights[i];
+            } else {
+                g.for_each_neighbor(u, [&](uwudgraph::node_id v, double w) { y[v] += rest * w / g.get_degree(u); });
+            }
+        }
+        x.swap(y);
+    }
+    return ppr;
+}
+
+int main() {
+    uwudgraph::GeneratorParams p;
+    p.n = 2000;
+    p.m = 20000;
+    uwudgraph::Graph* g = uwudgraph::generate_graph("er", p);
+    double alpha = 0.2, eps = 0.3, delta = 1.0 / g->n, pf = 1.0 / g->n;
+    uwudgraph::SeedSet seeds({3, 7, 11, 19, 42}, {1, 2, 1, 0.5, 0.5});
+    std::vector<double> exact(g->n, 0.0);
+    for (size_t i = 0; i < seeds.nodes.size(); ++i) {
+        std::vector<double> single = uwudgraph::ppr_power_iteration(*g, seeds.nodes[i], alpha, 1e-12);
+        for (uwudgraph::node_id v = 0; v < g->n; ++v) exact[v] += seeds.weights[i] * single[v];
+    }
+
+    // one push from all seeds keeps the invariant and scans fewer edges than a push per seed
+    CountingGraph<uwudgraph::Graph> counted(*g);
+    auto [ppr, r] = uwudgraph::ppr_forwardpush(counted, seeds, alpha, 1e-5);
+    double residual = 0;
+    for (double x : r) residual += x;
+    size_t separate = 0;
+    for (uwudgraph::node_id s : seeds.nodes) {
+        CountingGraph<uwudgraph::Graph> one(*g);
+        uwudgraph::ppr_forwardpush(one, s, alpha, 1e-5);
+        separate += one.edges;
+    }
+    print("edges scanned: seed set", counted.edges, "one push per seed", separate, "residual", residual);
+    if (std::abs(uwudgraph::accuracy_metrics(exact, ppr, 0, 1).l1 - residual) > 1e-6 || counted.edges >= separate) {
+        print("Seed-set push is wrong or not cheaper");
+        return 1;
+    }
+
+    // the sampling methods reach the accuracy of single-source queries, the others sum one query per seed
+    std::vector<double> fora = uwudgraph::SSPPR(*g, seeds, alpha, "fora", eps, delta, pf, 0, 0, 0, 0, 0);
+    std::vector<double> rw = uwudgraph::SSPPR(*g, seeds, alpha, "rw", 0, 0, 0, 0, 100000, 0, 0, 0);
+    std::vector<double> speedppr = uwudgraph::SSPPR(*g, seeds, alpha, "speedppr", eps, delta, pf, 0, 0, 0, 0, 0);
+    double rw_err = 0;
+    for (uwudgraph::node_id v = 0; v < g->n; ++v) rw_err = std::max(rw_err, std::abs(rw[v] - exact[v]));
+    double fora_err = uwudgraph::accuracy_metrics(exact, fora, 0, delta).max_rel_err;
+    double speedppr_err = uwudgraph::accuracy_metrics(exact, speedppr, 0, delta).max_rel_err;
+    print("fora error", fora_err, "speedppr error", speedppr_err, "rw max abs error", rw_err);
+    if (fora_err > eps || speedppr_err > eps || rw_err > 0.01) {
+        print("Seed-set estimate too far off");
+        return 1;
+    }
+
+    // under restart, walks and pushed mass return to the seed distribution
+    p.m = 1500;
+    uwudgraph::Graph* sparse = uwudgraph::generate_graph("er", p);
+    uwudgraph::node_id isolated = 0;
+    while (sparse->get_neighbor_count(isolated) != 0) ++isolated;
+    uwudgraph::SeedSet with_dangling({isolated, 5, 9}, {2, 1, 1});
+    std::vector<double> truth = seeded_power_iteration(*sparse, with_dangling, alpha);
+    std::vector<double> pushed = uwudgraph::SSPPR(*sparse, with_dangling, alpha, "push", 0, 0, 0, 1e-8, 0, 0, 0, 0, uwudgraph::Dangling::restart);
+    std::vector<double> walked = uwudgraph::SSPPR(*sparse, with_dangling, alpha, "fora", eps, 1.0 / sparse->n, pf, 0, 0, 0, 0, 0, uwudgraph::Dangling::restart);
+    double push_l1 = uwudgraph::accuracy_metrics(truth, pushed, 0, 1).l1;
+    double walk_err = uwudgraph::accuracy_metrics(truth, walked, 0, 1.0 / sparse->n).max_rel_err;
+    print("restart: push l1 error", push_l1, "fora error", walk_err);
+    if (push_l1 > 1e-4 || walk_err > eps) {
+        print("Restart to the seed distribution is wrong");
+        return 1;
+    }
+    bool refused = false;
+    try {
+        uwudgraph::SSPPR(*sparse, with_dangling, alpha, "speedppr", eps, 0, 0, 0, 0, 0, 0, 0, uwudgraph::Dangling::restart);
+    } catch (const std::invalid_argument& e) {
+        refused = true;
+    }
+    if (!refused) {
+        print("Per-seed sum accepted under restart");
+        return 1;
+    }
+
+    // seed files take an optional weight per line
+    std::string path = "test/uwudgraph/data/test_seeds.txt";
+    std::ofstream(path) << "# seeds\n3 1\n7 2\n\n11\n19 0.5\n42 0.5\n";
+    uwudgraph::SeedSet loaded = uwudgraph::load_seeds(path);
+    std::ofstream(path) << "3 x\n";
+    bool invalid = false;
+    try {
+        uwudgraph::load_seeds(path);
+    } catch (const std::invalid_argument& e) {
+        invalid = true;
+    }
+    std::remove(path.c_str());
+    if (loaded.nodes != seeds.nodes || loaded.weights != seeds.weights || !invalid) {
+        print("Seed file not read correctly");
+        return 1;
+    }
+
+    delete sparse;
+    delete g;
+    return 0;
+}
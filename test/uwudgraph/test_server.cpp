@@ -0,0 +1,135 @@
+#include <chrono>
+#include <thread>
+#include <unistd.h>
+#include "convenientPrint.hpp"
+
+#include "uwudgraph/graph.hpp"
+#include "uwudgraph/apps/generate/generate.hpp"
+#include "uwudgraph/apps/server/server.hpp"
+
+
+int main() {
+    uwudgraph::GeneratorParams p;
+    p.n = 2000;
+    p.m = 20000;
+    uwudgraph::Graph* g = uwudgraph::generate_graph("er", p);
+
+    // the cache keeps the most recently used vectors within its byte capacity
+    {
+        uwudgraph::PPRCache cache(2 * 10 * sizeof(double));
+        auto vec = std::make_shared<const std::vector<double>>(10, 1.0);
+        cache.put(uwudgraph::PPRCache::Key(0, 0.2, "push", 0, 0, 0), vec);
+        cache.put(uwudgraph::PPRCache::Key(1, 0.2, "push", 0, 0, 0), vec);
+        cache.get(uwudgraph::PPRCache::Key(0, 0.2, "push", 0, 0, 0));
+        cache.put(uwudgraph::PPRCache::Key(2, 0.2, "push", 0, 0, 0), vec);
+        if (cache.size() != 2 || !cache.get(uwudgraph::PPRCache::Key(0, 0.2, "push", 0, 0, 0)) ||
+            cache.get(uwudgraph::PPRCache::Key(1, 0.2, "push", 0, 0, 0))) {
+            print("Cache did not evict the least recently used vector");
+            return 1;
+        }
+    }
+
+    uwudgraph::ServerConfig config;
+    config.socket = "test/uwudgraph/data/test_server.sock";
+    config.threads = 2;
+    uwudgraph::SSPPRServer<uwudgraph::Graph> server(*g, config);
+    std::thread serving([&] { server.run(); });
+    while (!server.ready()) std::this_thread::yield();
+
+    {
+        uwudgraph::SSPPRClient client(config.socket);
+        uwudgraph::ServerCounters info = client.info();
+        if (info.n != g->n || info.m != g->m) {
+            print("Wrong graph info", info.n, info.m);
+            return 1;
+        }
+
+        // answers match the local call, and repeated queries come from the cache
+        uwudgraph::ServerRequest req;
+        req.method = "push";
+        req.source = 7;
+        std::vector<double> expected = uwudgraph::SSPPR(*g, 7, 0.2, "push", 0, 0, 0, 0, 0, 0, 0, 0);
+        if (client.ssppr(req) != expected) {
+            print("Server answer differs from SSPPR");
+            return 1;
+        }
+        std::vector<std::pair<uint64_t, double>> top = client.topk(req, 5);
+        if (top.size() != 5 || top[0].first != 7 || top[0].second != expected[7]) {
+            print("Wrong top-k answer");
+            return 1;
+        }
+        for (size_t i = 1; i < top.size(); ++i) {
+            if (top[i].second > top[i - 1].second || top[i].second != expected[top[i].first]) {
+                print("Top-k answer not sorted or not matching", i);
+                return 1;
+            }
+        }
+        if (client.pair(req, 42) != expected[42]) {
+            print("Wrong pair answer");
+            return 1;
+        }
+        uwudgraph::ServerCounters after = client.info();
+        if (after.misses != 1 || after.hits != 2) {
+            print("Unexpected cache counters", after.hits, after.misses);
+            return 1;
+        }
+
+        // errors come back as exceptions and keep the connection usable
+        req.source = g->n;
+        bool failed = false;
+        try {
+            client.ssppr(req);
+        } catch (const std::runtime_error &e) {
+            failed = true;
+        }
+        if (!failed || client.info().n != g->n) {
+            print("Out-of-range source was not reported");
+            return 1;
+        }
+
+        // connections are served concurrently
+        std::vector<std::thread> others;
+        std::vector<int> ok(4, 0);
+        for (int c = 0; c < 4; ++c) {
+            others.emplace_back([&, c] {
+                uwudgraph::SSPPRClient other(config.socket);
+                uwudgraph::ServerRequest q;
+                q.method = "push";
+                q.source = c;
+                ok[c] = other.ssppr(q) == uwudgraph::SSPPR(*g, c, 0.2, "push", 0, 0, 0, 0, 0, 0, 0, 0);
+            });
+        }
+        for (std::thread &t : others) t.join();
+        for (int c = 0; c < 4; ++c) {
+            if (!ok[c]) {
+                print("Wrong answer on concurrent connection", c);
+                return 1;
+            }
+        }
+
+        // threads of closed connections are joined as the next connection is accepted; a thread may still be
+        // finishing when its successor arrives, so connections go on for a while until the count settles
+        for (int c = 0; c < 20; ++c) uwudgraph::SSPPRClient(config.socket).info();
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+        size_t connections = 25;
+        do {
+            uwudgraph::SSPPRClient(config.socket).info();
+            ++connections;
+        } while (server.connection_threads() > 2 && std::chrono::steady_clock::now() < deadline);
+        print("connection threads after", connections, "connections:", server.connection_threads());
+        if (server.connection_threads() > 2) {
+            print("Threads of closed connections were not joined");
+            return 1;
+        }
+
+        client.stop_server();
+    }
+    serving.join();
+    if (access(config.socket.c_str(), F_OK) == 0) {
+        print("Server left its socket behind");
+        return 1;
+    }
+
+    delete g;
+    return 0;
+}
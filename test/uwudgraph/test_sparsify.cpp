@@ -0,0 +1,71 @@
+#include <iostream>
+#include <cmath>
+#include <random>
+#include "convenientPrint.hpp"
+
+#include "uwudgraph/graph.hpp"
+#include "uwudgraph/graph_types.hpp"
+
+#include "uwudgraph/apps/generate/generate.hpp"
+#include "uwudgraph/apps/sparsify/sparsify.hpp"
+
+
+int main() {
+    // a dense Erdos-Renyi graph, average degree about 100
+    uwudgraph::GeneratorParams p;
+    p.n = 300;
+    p.m = 15000;
+    uwudgraph::Graph* g = uwudgraph::generate_graph("er", p);
+    std::cout << "Number of nodes: " << g->n << std::endl;
+    std::cout << "Number of edges: " << g->m << std::endl;
+
+    for (std::string method : {"resistance", "degree"}) {
+        // the edge budget is met in expectation: the kept count is a sum of independent coins with mean budget
+        size_t budget = 3000;
+        std::vector<uwudgraph::weighted_edge> sparse = uwudgraph::sparsify(*g, method, 0.5, budget);
+        print(method, "kept", sparse.size(), "edges for a budget of", budget);
+        if (std::abs(static_cast<double>(sparse.size()) - budget) > 5 * std::sqrt(static_cast<double>(budget))) {
+            print("Edge budget not respected by", method);
+            return 1;
+        }
+
+        // weights are unbiased: averaged over seeds, x^T L_H x converges to x^T L_G x. This holds for any
+        // importance, so a small sketch keeps the 200 runs fast.
+        std::mt19937 gen(7);
+        std::normal_distribution<double> normal;
+        std::vector<double> x(g->n);
+        for (double& xi : x) xi = normal(gen);
+        double qg = 0;
+        for (uwudgraph::node_id u = 0; u < g->n; ++u) {
+            for (uwudgraph::node_id v : g->get_neighbors(u)) {
+                if (u < v) qg += (x[u] - x[v]) * (x[u] - x[v]);
+            }
+        }
+        size_t seeds = 200;
+        double qh_mean = 0;
+        for (size_t seed = 1; seed <= seeds; ++seed) {
+            for (const auto& [u, v, w] : uwudgraph::sparsify(*g, method, 0.5, budget, 16, seed)) {
+                qh_mean += w * (x[u] - x[v]) * (x[u] - x[v]) / seeds;
+            }
+        }
+        print(method, "mean x^T L_H x", qh_mean, "x^T L_G x", qg);
+        if (std::abs(qh_mean / qg - 1.0) > 0.01) {
+            print("Sparsifier weights are biased with", method);
+            return 1;
+        }
+
+        // sampling for a target eps keeps the quadratic forms within eps
+        double eps = 0.5;
+        sparse = uwudgraph::sparsify(*g, method, eps, 0);
+        uwudgraph::DistortionReport report = uwudgraph::quadratic_form_distortion(*g, sparse, 30);
+        print(method, "eps", eps, "kept", sparse.size(), "edges, distortion mean", report.mean, "max", report.max);
+        if (sparse.size() >= g->m || report.trials != 30 || report.max > eps) {
+            print("Quadratic-form distortion above eps with", method);
+            return 1;
+        }
+    }
+
+    delete g;
+    std::cout << "Test successfully." << std::endl;
+    return 0;
+}
@@ -0,0 +1,93 @@
+#include <cstdio>
+#include <iostream>
+#include "convenientPrint.hpp"
+
+#include "uwudgraph/graph.hpp"
+#include "uwudgraph/apps/generate/generate.hpp"
+#include "uwudgraph/apps/ssppr/ssppr.hpp"
+#include "uwudgraph/apps/ssppr/ssppr_state.hpp"
+#include "uwudgraph/apps/accuracy/accuracy.hpp"
+
+
+int main() {
+    uwudgraph::GeneratorParams p;
+    p.n = 2000;
+    p.m = 20000;
+    uwudgraph::Graph* g = uwudgraph::generate_graph("er", p);
+    double alpha = 0.2, eps = 0.3, delta = 1.0 / g->n, pf = 1.0 / g->n;
+    std::vector<double> exact = uwudgraph::ppr_power_iteration(*g, 0, alpha, 1e-12);
+
+    // refining a coarse push costs less than pushing from scratch and reaches the same threshold
+    uwudgraph::PushState state(*g, 0, alpha);
+    state.refine(*g, 1e-2);
+    size_t resumed = state.refine(*g, 1e-4);
+    uwudgraph::PushState fresh(*g, 0, alpha);
+    size_t scratch = fresh.refine(*g, 1e-4);
+    double mass = state.residual();
+    for (double x : state.ppr()) mass += x;
+    print("pushes resumed", resumed, "from scratch", scratch, "residual", state.residual(), "fresh residual", fresh.residual());
+    if (resumed >= scratch || std::abs(mass - 1) > 1e-9 || state.refine(*g, 1e-3) != 0) {
+        print("Refining did not resume the push");
+        return 1;
+    }
+    for (uwudgraph::node_id u = 0; u < g->n; ++u) {
+        if (state.r()[u] > g->get_degree(u) * 1e-4) {
+            print("Residual above rmax at", u);
+            return 1;
+        }
+    }
+
+    // walks added in batches reach FORA's guarantee
+    state.add_walks(*g, 100);
+    size_t added = state.walk_to(*g, eps, delta, pf);
+    double err = uwudgraph::accuracy_metrics(exact, state.estimate(), 0, delta).max_rel_err;
+    print("walks", state.walks(), "bound", state.error_bound(delta, pf), "error", err);
+    if (state.walks() != 100 + added || state.error_bound(delta, pf) > eps + 1e-9 || err > eps) {
+        print("Walks did not reach the requested accuracy");
+        return 1;
+    }
+
+    // a checkpoint restores the state and refines exactly like the original
+    std::vector<uint8_t> stream;
+    uwudgraph::serialize_push_state(state, stream);
+    uwudgraph::PushState restored = uwudgraph::deserialize_push_state(stream);
+    if (restored.estimate() != state.estimate() || restored.walks() != state.walks() || restored.rmax() != state.rmax() ||
+        restored.source() != 0 || restored.alpha() != alpha) {
+        print("Deserialized state differs");
+        return 1;
+    }
+    std::string path = "test/uwudgraph/data/test_state.bin";
+    uwudgraph::save_push_state(path, state);
+    uwudgraph::PushState loaded = uwudgraph::load_push_state(path);
+    std::remove(path.c_str());
+    state.refine(*g, 1e-5);
+    loaded.refine(*g, 1e-5);
+    if (loaded.ppr() != state.ppr() || loaded.r() != state.r()) {
+        print("Loaded state refines differently");
+        return 1;
+    }
+
+    // corrupt checkpoints and other graphs are rejected
+    int rejected = 0;
+    stream.pop_back();
+    try {
+        uwudgraph::deserialize_push_state(stream);
+    } catch (const std::invalid_argument& e) {
+        ++rejected;
+    }
+    p.m = g->m + 10;
+    uwudgraph::Graph* other = uwudgraph::generate_graph("er", p);
+    try {
+        restored.refine(*other, 1e-5);
+    } catch (const std::invalid_argument& e) {
+        ++rejected;
+    }
+    if (rejected != 2) {
+        print("Bad checkpoint or graph accepted");
+        return 1;
+    }
+
+    delete other;
+    delete g;
+    return 0;
+}
@@ -0,0 +1,86 @@
+#define SSPPR_STATS
+
+#include <iostream>
+#include "convenientPrint.hpp"
+
+#include "uwudgraph/graph.hpp"
+#include "uwudgraph/apps/generate/generate.hpp"
+#include "uwudgraph/apps/ssppr/ssppr.hpp"
+
+
+int main() {
+    uwudgraph::GeneratorParams p;
+    p.n = 2000;
+    p.m = 20000;
+    uwudgraph::Graph* g = uwudgraph::generate_graph("er", p);
+    double alpha = 0.2;
+
+    // push counters match the kernel and are reset between queries
+    uwudgraph::SSPPRStats push, again;
+    uwudgraph::SSPPR(*g, 0, alpha, "push", 0, 0, 0, 1e-6, 0, 0, 0, 0, uwudgraph::Dangling::selfloop, &push);
+    uwudgraph::SSPPR(*g, 0, alpha, "push", 0, 0, 0, 1e-6, 0, 0, 0, 0, uwudgraph::Dangling::selfloop, &again);
+    std::vector<double> ppr(g->n, 0), r(g->n, 0);
+    r[0] = 1;
+    uniqueue<uwudgraph::node_id> queue(g->n);
+    queue.push(0);
+    size_t pushes = uwudgraph::forwardpush_resume(*g, 0, alpha, 1e-6, ppr, r, queue);
+    print("push: pushes", push.pushes, "edges scanned", push.edges_scanned, "queue high-water", push.queue_high_water,
+          "allocated bytes", push.alloc_bytes, "seconds", push.push_seconds);
+    if (push.pushes != pushes || again.pushes != pushes || push.edges_scanned < pushes || push.queue_high_water == 0 ||
+        push.alloc_bytes < 2 * g->n * sizeof(double) || push.walks != 0) {
+        print("Wrong push counters");
+        return 1;
+    }
+
+    // a walk takes (1 - alpha) / alpha steps on average
+    uwudgraph::SSPPRStats rw;
+    uwudgraph::SSPPR(*g, 0, alpha, "rw", 0, 0, 0, 0, 100000, 0, 0, 0, uwudgraph::Dangling::selfloop, &rw);
+    double steps = static_cast<double>(rw.walk_steps) / rw.walks;
+    print("rw: walks", rw.walks, "steps per walk", steps);
+    if (rw.walks != 100000 || std::abs(steps - (1 - alpha) / alpha) > 0.2) {
+        print("Wrong walk counters");
+        return 1;
+    }
+
+    // a small lambda sends power push into its sequential scans
+    uwudgraph::SSPPRStats speedppr;
+    uwudgraph::SSPPR(*g, 0, alpha, "speedppr", 0.05, 0, 0, 0, 0, 0, 0, 0, uwudgraph::Dangling::selfloop, &speedppr);
+    print("speedppr: pushes", speedppr.pushes, "scan epochs", speedppr.scan_epochs, "walks", speedppr.walks);
+    if (speedppr.scan_epochs == 0 || speedppr.pushes == 0) {
+        print("Power push did not count its scans");
+        return 1;
+    }
+
+    // under the uniform policy the jump mass left by the push is refined with walks from uniformly sampled nodes:
+    // from an isolated source 1 - alpha of the mass jumps, and FORA and SpeedPPR need about (1 - alpha) * w walks
+    // for it instead of at least one walk from each of the n nodes
+    uwudgraph::GeneratorParams sparse_p;
+    sparse_p.n = 20000;
+    sparse_p.m = 2000;
+    uwudgraph::Graph* sparse = uwudgraph::generate_graph("er", sparse_p);
+    uwudgraph::node_id isolated = 0;
+    while (sparse->get_degree(isolated) != 0) ++isolated;
+    for (std::string method : {"fora", "speedppr"}) {
+        uwudgraph::SSPPRStats jump;
+        std::vector<double> est = uwudgraph::SSPPR(*sparse, isolated, alpha, method, 0.5, 0.01, 0.01, 0, 0, 0, 0, 0,
+                                                   uwudgraph::Dangling::uniform, &jump);
+        double sum = 0;
+        for (double x : est) sum += x;
+        print(method, "from an isolated source: walks", jump.walks, "PPR sum", sum, "at source", est[isolated]);
+        if (jump.walks == 0 || jump.walks >= sparse->n || std::abs(sum - 1) > 1e-9 || est[isolated] < alpha) {
+            print("Uniform jump mass not refined by a batch of walks in", method);
+            return 1;
+        }
+    }
+    delete sparse;
+
+    uwudgraph::SSPPRStats ppw;
+    uwudgraph::SSPPR(*g, 0, alpha, "ppw", 0, 0, 0, 0, 0, 0, 0, 0, uwudgraph::Dangling::selfloop, &ppw);
+    print("ppw: edges scanned", ppw.edges_scanned, "iterate seconds", ppw.iterate_seconds, "walks", ppw.walks);
+    if (ppw.edges_scanned == 0 || ppw.iterate_seconds <= 0 || ppw.walks == 0) {
+        print("Wrong ppw counters");
+        return 1;
+    }
+    delete g;
+    return 0;
+}
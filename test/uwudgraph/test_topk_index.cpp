@@ -0,0 +1,110 @@
+#include <atomic>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include "convenientPrint.hpp"
+
+#include "uwudgraph/graph.hpp"
+#include "uwudgraph/apps/generate/generate.hpp"
+#include "uwudgraph/apps/ssppr/ssppr.hpp"
+#include "uwudgraph/apps/topk_index/topk_index.hpp"
+
+
+std::vector<char> read_bytes(std::string path) {
+    std::ifstream file(path, std::ios::binary);
+    return std::vector<char>((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+}
+
+int main() {
+    uwudgraph::GeneratorParams p;
+    p.n = 2000;
+    p.m = 20000;
+    uwudgraph::Graph* g = uwudgraph::generate_graph("er", p);
+    uwudgraph::TopKIndexConfig config;
+    config.k = 10;
+    config.rmax = 1e-5;
+    config.chunk = 300;
+    std::string path = "test/uwudgraph/data/test_topk.idx", resumed = "test/uwudgraph/data/test_topk_resumed.idx";
+    uwudgraph::build_topk_index(*g, path, config);
+
+    // every record holds the k largest push estimates but the source, the scores within the quantization error
+    uwudgraph::TopKIndex index(path);
+    if (index.n() != g->n || index.k() != config.k) {
+        print("Top-k index header is wrong");
+        return 1;
+    }
+    std::vector<std::pair<uwudgraph::node_id, float>> top;
+    for (uwudgraph::node_id u = 0; u < g->n; u += 97) {
+        auto [ppr, r] = uwudgraph::ppr_forwardpush(*g, u, config.alpha, config.rmax);
+        ppr[u] = 0;
+        std::vector<double> sorted = ppr;
+        std::sort(sorted.begin(), sorted.end(), std::greater<double>());
+        index.lookup(u, top);
+        if (top.size() != config.k) {
+            print("Record of", u, "has", top.size(), "entries");
+            return 1;
+        }
+        for (size_t i = 0; i < top.size(); ++i) {
+            double est = ppr[top[i].first];
+            if (top[i].first == u || std::abs(top[i].second - est) > 5e-4 * est || std::abs(sorted[i] - est) > 1e-3 * est) {
+                print("Entry", i, "of", u, "is", top[i].first, top[i].second, "but the push has", est, "and rank", i, "holds", sorted[i]);
+                return 1;
+            }
+        }
+    }
+    // and the top-k of the push agrees with that of the exact PPR
+    std::vector<double> exact = uwudgraph::ppr_power_iteration(*g, 5, config.alpha, 1e-12);
+    exact[5] = 0;
+    std::vector<double> sorted = exact;
+    std::sort(sorted.begin(), sorted.end(), std::greater<double>());
+    size_t hits = 0;
+    for (const auto& entry : index.lookup(5)) hits += exact[entry.first] >= sorted[config.k - 1];
+    print("precision at", config.k, ":", double(hits) / config.k);
+    if (hits < config.k - 1) {
+        print("Top-k index misses exact neighbors");
+        return 1;
+    }
+
+    // a cancelled build resumes from its checkpoint into the same file
+    std::atomic<bool> cancel(true);
+    bool finished = uwudgraph::build_topk_index(*g, resumed, config, &cancel);
+    std::ofstream(resumed + ".part", std::ios::binary | std::ios::app) << "records after the checkpoint";
+    bool checkpointed = std::filesystem::exists(resumed + ".ckpt");
+    finished = !finished && checkpointed && uwudgraph::build_topk_index(*g, resumed, config);
+    if (!finished || read_bytes(resumed) != read_bytes(path) || std::filesystem::exists(resumed + ".ckpt")) {
+        print("Resumed build differs from a full one");
+        return 1;
+    }
+
+    // truncated files, nodes out of range and the uniform policy are rejected
+    int rejected = 0;
+    std::vector<char> bytes = read_bytes(path);
+    std::ofstream(resumed, std::ios::binary).write(bytes.data(), bytes.size() - 1);
+    try {
+        uwudgraph::TopKIndex truncated(resumed);
+    } catch (const std::runtime_error& e) {
+        ++rejected;
+    }
+    try {
+        index.lookup(g->n);
+    } catch (const std::invalid_argument& e) {
+        ++rejected;
+    }
+    uwudgraph::TopKIndexConfig uniform = config;
+    uniform.dangling = uwudgraph::Dangling::uniform;
+    try {
+        uwudgraph::build_topk_index(*g, resumed, uniform);
+    } catch (const std::invalid_argument& e) {
+        ++rejected;
+    }
+    std::remove(path.c_str());
+    std::remove(resumed.c_str());
+    if (rejected != 3) {
+        print("Bad top-k index, node or dangling policy accepted");
+        return 1;
+    }
+
+    delete g;
+    return 0;
+}
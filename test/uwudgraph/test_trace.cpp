@@ -0,0 +1,77 @@
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <thread>
+#include "convenientPrint.hpp"
+#include "multithread/parallel.hpp"
+#include "trace.hpp"
+
+#include "uwudgraph/graph.hpp"
+#include "uwudgraph/apps/generate/generate.hpp"
+#include "uwudgraph/apps/ssppr/ssppr.hpp"
+
+std::string trace_file = "test/uwudgraph/data/trace.json";
+
+
+size_t count(const std::string& text, const std::string& pattern) {
+    size_t c = 0;
+    for (size_t pos = text.find(pattern); pos != std::string::npos; pos = text.find(pattern, pos + 1)) ++c;
+    return c;
+}
+
+int main() {
+    uwudgraph::GeneratorParams p;
+    p.n = 2000;
+    p.m = 20000;
+    uwudgraph::Graph* g = uwudgraph::generate_graph("er", p);
+
+    // nothing is recorded while tracing is off
+    uwudgraph::SSPPR(*g, 0, 0.2, "fora", 0, 0, 0, 0, 0, 0, 0, 0);
+    trace_dump(trace_file);
+
+    trace_enable(trace_file);
+    set_num_threads(4);
+    std::vector<double> x(1 << 20);
+    // ranges below twice the grain are not split, so the loop runs as 16 chunks however they are stolen;
+    // the sleep hands the core to the other threads even on a single-core machine
+    parallel_for_chunks(0, x.size(), [&](size_t lo, size_t hi){
+        for (size_t i = lo; i < hi; ++i) x[i] = std::sqrt(i);
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }, 1 << 16);
+    uwudgraph::SSPPR(*g, 0, 0.2, "fora", 0, 0, 0, 0, 0, 0, 0, 0);
+    trace_disable();
+    uwudgraph::SSPPR(*g, 0, 0.2, "push", 0, 0, 0, 0, 0, 0, 0, 0);
+
+    std::ifstream is(trace_file);
+    std::stringstream before;
+    before << is.rdbuf();
+    if (count(before.str(), "\"ph\": \"X\"") != 0) {
+        print("Events recorded while tracing was off");
+        return 1;
+    }
+    is.close();
+
+    trace_dump(trace_file);
+    std::ifstream is2(trace_file);
+    std::stringstream after;
+    after << is2.rdbuf();
+    std::string text = after.str();
+    std::remove(trace_file.c_str());
+    size_t chunks = count(text, "\"name\": \"chunk\"");
+    size_t threads = count(text, "\"thread_name\"");
+    print("chunks:", chunks, "threads:", threads, "queries:", count(text, "\"name\": \"SSPPR\""));
+    // 16 chunks on more than one thread, and one query with its push and walk phases
+    if (chunks != 16 || threads < 2 || count(text, "\"name\": \"SSPPR\"") != 1 ||
+        count(text, "\"name\": \"push\"") != 1 || count(text, "\"name\": \"walk\"") != 1) {
+        print("Wrong trace events");
+        return 1;
+    }
+    if (text.substr(0, 16) != "{\"traceEvents\": " || text.find("\"displayTimeUnit\"") == std::string::npos) {
+        print("Trace is not in Chrome trace format");
+        return 1;
+    }
+    delete g;
+    return 0;
+}
@@ -0,0 +1,89 @@
+#include <iostream>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include "convenientPrint.hpp"
+
+#include "wudgraph/graph.hpp"
+#include "wudgraph/graph_types.hpp"
+#include "wudgraph/graphio.hpp"
+
+#include "uwudgraph/apps/ssppr/ssppr.hpp"
+
+std::string test_file = "test/wudgraph/data/demo.txt";
+std::string bad_file = "test/wudgraph/data/bad.txt";
+
+
+// exact PPR by power iteration on the weighted transition matrix
+std::vector<double> power_iteration(const wudgraph::Graph& g, wudgraph::node_id source, double alpha) {
+    std::vector<double> ppr(g.n, 0.0), next(g.n);
+    ppr[source] = 1.0;
+    for (int it = 0; it < 1000; ++it) {
+        std::fill(next.begin(), next.end(), 0.0);
+        next[source] = alpha;
+        for (wudgraph::node_id u = 0; u < g.n; ++u) {
+            g.for_each_neighbor(u, [&](wudgraph::node_id v, double w) {
+                next[v] += (1 - alpha) * ppr[u] * w / g.get_degree(u);
+            });
+        }
+        ppr.swap(next);
+    }
+    return ppr;
+}
+
+
+int main() {
+    std::cout << "Loading graph from edgelist file: " << test_file << std::endl;
+    wudgraph::Graph* g = wudgraph::load_edgelist(test_file);
+    std::cout << "Number of nodes: " << g->n << std::endl;
+    std::cout << "Number of edges: " << g->m << std::endl;
+
+    // rand_neighbor(1) draws 0, 2, 3 with probabilities 1/5, 1/5, 3/5
+    std::vector<double> freq(g->n, 0.0);
+    size_t draws = 100000;
+    for (size_t i = 0; i < draws; ++i) freq[g->rand_neighbor(1)] += 1.0 / draws;
+    print("Neighbor frequencies of node 1: ", freq);
+    if (std::abs(freq[3] - 0.6) > 0.01 || std::abs(freq[0] - 0.2) > 0.01 || freq[1] != 0) {
+        print("Alias sampling does not follow the edge weights");
+        return 1;
+    }
+
+    std::vector<double> exact = power_iteration(*g, 0, 0.2);
+    print("PPR vector by power iteration: ", exact);
+    std::vector<double> ppr = uwudgraph::ppr_forwardpush(*g, 0, 0.2, 1e-10).first;
+    print("PPR vector by forwardpush: ", ppr);
+    for (wudgraph::node_id u = 0; u < g->n; ++u) {
+        if (std::abs(ppr[u] - exact[u]) > 1e-8) {
+            print("Weighted forward push does not match power iteration");
+            return 1;
+        }
+    }
+    for (std::string method : {"rw", "fora", "speedppr", "ppw"}) {
+        ppr = uwudgraph::SSPPR(*g, 0, 0.2, method, 0.01, 0, 0, 0, 100000, 0, 0, 0);
+        print("PPR vector by", method, ": ", ppr);
+    }
+
+    // a zero weight and a .meta file that disagrees with the edge list are rejected
+    int rejected = 0;
+    std::ofstream(bad_file) << "0 1 1\n1 2 0\n";
+    try {
+        delete wudgraph::load_edgelist(bad_file);
+    } catch (const std::runtime_error& e) {
+        ++rejected;
+    }
+    std::ofstream(bad_file) << "0 1 1\n1 2 2\n";
+    std::ofstream(bad_file + ".meta") << "3 3\n";
+    try {
+        delete wudgraph::load_edgelist(bad_file);
+    } catch (const std::runtime_error& e) {
+        ++rejected;
+    }
+    std::remove(bad_file.c_str());
+    std::remove((bad_file + ".meta").c_str());
+    if (rejected != 2) {
+        print("Zero weight or wrong meta edge count accepted");
+        return 1;
+    }
+    delete g;
+    return 0;
+}
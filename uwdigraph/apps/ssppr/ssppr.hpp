@@ -0,0 +1,27 @@
+# pragma once
+
+#include "uwdigraph/graph.hpp"
+#include "uwdigraph/graph_types.hpp"
+#include "uwdigraph/graphio.hpp"
+
+#include "uwudgraph/apps/ssppr/ssppr.hpp"
+
+
+namespace uwdigraph{
+
+
+// SSPPR on an unweighted directed graph, sharing the kernels of uwudgraph.
+// Walks follow out-edges; sinks jump back to the source unless another dangling policy is given.
+std::vector<double> SSPPR(std::string filename, std::string source_str, double alpha, std::string method, double eps, double delta, double pf, double rmax, size_t rw_num, size_t pi_num, size_t sample_size, size_t batch_size, std::string dangling = "restart", uwudgraph::SSPPRStats* stats = nullptr, uwudgraph::AnytimeControl* anytime = nullptr){
+    Graph* g;
+    {
+        TRACE_SCOPE("load", "io");
+        g = load_edgelist(filename);
+    }
+    node_id source = static_cast<node_id>(std::stoul(source_str));
+    std::vector<double> ppr = uwudgraph::SSPPR(*g, source, alpha, method, eps, delta, pf, rmax, rw_num, pi_num, sample_size, batch_size, uwudgraph::parse_dangling(dangling), stats, anytime);
+    delete g;
+    return ppr;
+}
+
+};
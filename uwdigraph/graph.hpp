@@ -2,33 +2,54 @@
 
 #include <vector>
 #include <stdexcept>
+#include <string>
 
 #include "graph_types.hpp"
+#include "array_view.hpp"
+#include "memory.hpp"
 #include "random.hpp"
 
 
 namespace uwdigraph{
+// Unweighted directed graph in CSR form, row u holding the out-neighbors of u, on huge pages (memory.hpp).
 class Graph{
 public:
     node_id n = 0;
     edge_id m = 0;
 
-    std::vector<std::vector<node_id>> adj = {};
+    huge_vector<size_t> offsets = {};      // row u is [offsets[u], offsets[u+1])
+    huge_vector<node_id> targets = {};
     Graph(){};
 
     node_id get_degree(node_id u) const{
-        return adj[u].size();
+        return static_cast<node_id>(offsets[u+1] - offsets[u]);
     }
 
-    std::vector<node_id> get_neighbors(node_id u) const{
-        return adj[u];
+    array_view<node_id> get_neighbors(node_id u) const{
+        return array_view<node_id>(targets.data() + offsets[u], offsets[u+1] - offsets[u]);
+    }
+
+    node_id get_neighbor_count(node_id u) const{
+        return static_cast<node_id>(offsets[u+1] - offsets[u]);
+    }
+
+    // f(v, w) for every edge (u, v), w = 1 in an unweighted graph
+    template <typename F>
+    void for_each_neighbor(node_id u, F&& f) const{
+        for(size_t e=offsets[u]; e<offsets[u+1]; ++e) f(targets[e], 1.0);
+    }
+
+    double get_total_weight() const{
+        return m;
     }
 
     node_id rand_neighbor(node_id u) const{
-        if (adj[u].size() == 0){
+        size_t first = offsets[u];
+        size_t k = offsets[u+1] - first;
+        if (k == 0){
             throw std::runtime_error("No neighbors for node " + std::to_string(u));
         }
-        return adj[u][rand_uniform(adj[u].size())];
+        return targets[first + rand_uniform(k)];
     }
 };
 
@@ -114,20 +114,27 @@ Graph* load_edgelist(std::string filename) {
     }
   }
 
-  // Resize the adjacency list to the number of vertices
-  graph->adj.resize(graph->n);
+  std::vector<edge> edges;
+  edges.reserve(graph->m);
   while (std::getline(is, line)) {
     if (line[0] != '#' && line[0] != '/' && line.length() > 0) {
       try {
         // This line of the input file isn't a comment, parse it.
-        edge this_edge = parse_edgelist_content_line(line);
-        graph->adj[this_edge.first].emplace_back(this_edge.second);
+        edges.push_back(parse_edgelist_content_line(line));
       } catch (std::invalid_argument &e) {
         throw(std::runtime_error(e.what()));
       }
     }
   }
   is.close();
+
+  // Count the out-degrees, then fill every row in file order
+  graph->offsets.assign(graph->n + 1, 0);
+  for (const auto &[u, v] : edges) ++graph->offsets[u + 1];
+  for (node_id u = 0; u < graph->n; ++u) graph->offsets[u + 1] += graph->offsets[u];
+  graph->targets.resize(graph->offsets[graph->n]);
+  std::vector<size_t> pos(graph->offsets.begin(), graph->offsets.end() - 1);
+  for (const auto &[u, v] : edges) graph->targets[pos[u]++] = v;
   return graph;
 }
 
@@ -0,0 +1,283 @@
+/*
+// This header file implements the accuracy-versus-cost harness of the SSPPR methods.
+// Ground truth is ppr_power_iteration to an L1 error of tol (default 1e-12) for sampled sources. It is cached
+// with save_file as one tuple and reused while the graph size, alpha, tol, dangling policy and sources match.
+// Every method is swept over the parameters it reads:
+//     push          : rmax                 rw            : rw_num
+//     fora_skeleton : rmax x rw_num        fora, speedppr, auto: eps
+//     ppw           : pi_num
+// A method with the suffix _f32 (fora_f32, ...) is the same method with float storage, swept like it.
+// and every setting records its median latency and the mean over sources and reps of
+//     max_rel_err   : max |est - exact| / exact over nodes with exact >= delta (default 1/n)
+//     l1            : sum |est - exact|
+//     precision     : |top-k of est ∩ top-k of exact| / k
+//     ndcg          : DCG of the top-k of est with the exact values as gains, over the ideal DCG
+// mark_pareto flags the settings that no other setting beats in both latency and the chosen metric;
+// best_under_budget picks the most accurate one whose median latency fits a budget.
+*/
+
+
+# pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "benchmark.hpp"
+#include "convenientPrint.hpp"
+#include "multithread/parallel.hpp"
+#include "serialize.hpp"
+
+#include "uwudgraph/apps/ssppr/ssppr.hpp"
+#include "uwudgraph/apps/bench/bench.hpp"
+
+
+namespace uwudgraph{
+
+
+struct GroundTruth{
+    uint64_t n = 0, m = 0;
+    double alpha = 0, tol = 0;
+    int dangling = 0;
+    std::vector<uint64_t> sources;
+    std::vector<std::vector<double>> ppr;   // exact vector of sources[i]
+};
+
+struct AccuracyMetrics{
+    double max_rel_err = 0, l1 = 0, precision = 0, ndcg = 0;
+};
+
+struct AccuracyConfig{
+    std::string graph;                      // label written into the records
+    std::vector<std::string> methods = {"push", "fora", "speedppr", "ppw"};
+    double alpha = 0.2;
+    std::vector<double> epss = {0.5, 0.2, 0.1, 0.05};
+    std::vector<double> rmaxs = {1e-3, 1e-4, 1e-5, 1e-6};
+    std::vector<size_t> rw_nums = {100, 1000, 10000};
+    std::vector<size_t> pi_nums = {2, 5, 10};
+    size_t num_sources = 10;
+    std::vector<uint64_t> sources;          // used instead of sampling when not empty
+    size_t reps = 3;                        // timed runs per source and setting
+    size_t k = 100;                         // of precision@k and NDCG@k
+    double delta = 0;                       // 0 means 1/n
+    double tol = 1e-12;                     // L1 error of the ground truth
+    Dangling dangling = Dangling::selfloop;
+    uint32_t seed = 1;
+    std::string cache;                      // ground truth file, none if empty
+};
+
+struct AccuracyRecord{
+    std::string graph, method;
+    double eps = 0, rmax = 0;               // 0: not read by the method
+    size_t rw_num = 0, pi_num = 0;
+    LatencySummary latency;                 // milliseconds per query
+    AccuracyMetrics metrics;                // mean over sources and reps
+    bool pareto = false;
+};
+
+
+namespace __accuracy_detail{
+
+// indices of the k largest values, largest first, ties broken by the smaller index
+std::vector<size_t> top_k(const std::vector<double>& x, size_t k){
+    std::vector<size_t> idx(x.size());
+    for(size_t i=0; i<idx.size(); ++i) idx[i] = i;
+    k = std::min(k, idx.size());
+    auto larger = [&](size_t a, size_t b){ return x[a] > x[b] || (x[a] == x[b] && a < b); };
+    std::partial_sort(idx.begin(), idx.begin() + k, idx.end(), larger);
+    idx.resize(k);
+    return idx;
+}
+
+}
+
+
+template <class G>
+GroundTruth compute_ground_truth(const G& g, const std::vector<uint64_t>& sources, double alpha, double tol, Dangling dangling){
+    GroundTruth truth;
+    truth.n = g.n;
+    truth.m = g.m;
+    truth.alpha = alpha;
+    truth.tol = tol;
+    truth.dangling = static_cast<int>(dangling);
+    truth.sources = sources;
+    truth.ppr.resize(sources.size());
+    parallel_for(0, sources.size(), [&](size_t i){
+        truth.ppr[i] = ppr_power_iteration(g, sources[i], alpha, tol, dangling);
+    }, 1);
+    return truth;
+}
+
+void save_ground_truth(std::string filename, const GroundTruth& truth){
+    auto data = std::make_tuple(truth.n, truth.m, truth.alpha, truth.tol, truth.dangling, truth.sources, truth.ppr);
+    if(!save_file(filename, data)){
+        throw std::runtime_error("Could not write to file: " + filename);
+    }
+}
+
+GroundTruth load_ground_truth(std::string filename){
+    std::ifstream exists(filename);
+    if(!exists.is_open()){
+        throw std::runtime_error("Could not open file: " + filename);
+    }
+    using Data = std::tuple<uint64_t, uint64_t, double, double, int, std::vector<uint64_t>, std::vector<std::vector<double>>>;
+    GroundTruth truth;
+    std::tie(truth.n, truth.m, truth.alpha, truth.tol, truth.dangling, truth.sources, truth.ppr) = load_file<Data>(filename);
+    return truth;
+}
+
+// Loads the ground truth from cache if it was computed for the same query, otherwise computes and caches it.
+template <class G>
+GroundTruth ground_truth(const G& g, const std::vector<uint64_t>& sources, double alpha, double tol, Dangling dangling, std::string cache = ""){
+    if(!cache.empty() && std::ifstream(cache).is_open()){
+        GroundTruth truth = load_ground_truth(cache);
+        if(truth.n == g.n && truth.m == g.m && truth.alpha == alpha && truth.tol == tol &&
+           truth.dangling == static_cast<int>(dangling) && truth.sources == sources){
+            return truth;
+        }
+    }
+    GroundTruth truth = compute_ground_truth(g, sources, alpha, tol, dangling);
+    if(!cache.empty()) save_ground_truth(cache, truth);
+    return truth;
+}
+
+
+AccuracyMetrics accuracy_metrics(const std::vector<double>& exact, const std::vector<double>& est, size_t k, double delta){
+    if(exact.size() != est.size()){
+        throw std::invalid_argument("PPR vectors of different sizes.");
+    }
+    AccuracyMetrics mt;
+    for(size_t v=0; v<exact.size(); ++v){
+        double err = std::abs(est[v] - exact[v]);
+        mt.l1 += err;
+        if(exact[v] >= delta && exact[v] > 0) mt.max_rel_err = std::max(mt.max_rel_err, err / exact[v]);
+    }
+    std::vector<size_t> top_exact = __accuracy_detail::top_k(exact, k);
+    std::vector<size_t> top_est = __accuracy_detail::top_k(est, k);
+    if(top_exact.empty()) return mt;
+    std::vector<size_t> sorted_exact = top_exact;
+    std::sort(sorted_exact.begin(), sorted_exact.end());
+    double hits = 0, dcg = 0, ideal = 0;
+    for(size_t i=0; i<top_est.size(); ++i){
+        hits += std::binary_search(sorted_exact.begin(), sorted_exact.end(), top_est[i]);
+        dcg += exact[top_est[i]] / std::log2(i + 2.0);
+        ideal += exact[top_exact[i]] / std::log2(i + 2.0);
+    }
+    mt.precision = hits / top_exact.size();
+    mt.ndcg = ideal > 0 ? dcg / ideal : 1.0;
+    return mt;
+}
+
+// metric: "max_rel_err", "l1", "precision" or "ndcg", returned so that lower is better
+double metric_error(const AccuracyRecord& r, std::string metric){
+    if(metric == "max_rel_err") return r.metrics.max_rel_err;
+    if(metric == "l1") return r.metrics.l1;
+    if(metric == "precision") return 1.0 - r.metrics.precision;
+    if(metric == "ndcg") return 1.0 - r.metrics.ndcg;
+    throw std::invalid_argument("Invalid accuracy metric: " + metric);
+}
+
+
+template <class G>
+std::vector<AccuracyRecord> accuracy_sweep(const G& g, const GroundTruth& truth, const AccuracyConfig& config){
+    double delta = config.delta == 0 ? 1.0 / g.n : config.delta;
+
+    std::vector<AccuracyRecord> records;
+    auto run = [&](const std::string& method, double eps, double rmax, size_t rw_num, size_t pi_num){
+        AccuracyRecord rec;
+        rec.graph = config.graph;
+        rec.method = method;
+        rec.eps = eps;
+        rec.rmax = rmax;
+        rec.rw_num = rw_num;
+        rec.pi_num = pi_num;
+        std::vector<double> latencies;
+        size_t runs = 0;
+        for(size_t i=0; i<truth.sources.size(); ++i){
+            for(size_t rep=0; rep<config.reps; ++rep){
+                auto start = std::chrono::steady_clock::now();
+                std::vector<double> ppr = SSPPR(g, truth.sources[i], truth.alpha, method, eps, 0, 0, rmax, rw_num, pi_num, 0, 0, config.dangling);
+                latencies.push_back(std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count());
+                AccuracyMetrics mt = accuracy_metrics(truth.ppr[i], ppr, config.k, delta);
+                rec.metrics.max_rel_err += mt.max_rel_err;
+                rec.metrics.l1 += mt.l1;
+                rec.metrics.precision += mt.precision;
+                rec.metrics.ndcg += mt.ndcg;
+                ++runs;
+            }
+        }
+        if(runs > 0){
+            rec.metrics.max_rel_err /= runs;
+            rec.metrics.l1 /= runs;
+            rec.metrics.precision /= runs;
+            rec.metrics.ndcg /= runs;
+        }
+        rec.latency = summarize(latencies);
+        records.push_back(rec);
+    };
+
+    for(const std::string& method : config.methods){
+        // float variants sweep the parameters of their double method
+        std::string base = method.size() > 4 && method.compare(method.size() - 4, 4, "_f32") == 0 ? method.substr(0, method.size() - 4) : method;
+        if(base == "push" || base == "forwardpush"){
+            for(double rmax : config.rmaxs) run(method, 0, rmax, 0, 0);
+        } else if(base == "rw"){
+            for(size_t rw_num : config.rw_nums) run(method, 0, 0, rw_num, 0);
+        } else if(base == "fora_skeleton"){
+            for(double rmax : config.rmaxs){
+                for(size_t rw_num : config.rw_nums) run(method, 0, rmax, rw_num, 0);
+            }
+        } else if(base == "fora" || base == "speedppr" || method == "auto"){
+            for(double eps : config.epss) run(method, eps, 0, 0, 0);
+        } else if(method == "ppw"){
+            for(size_t pi_num : config.pi_nums) run(method, 0, 0, 0, pi_num);
+        } else{
+            throw std::invalid_argument("Invalid method specified for the accuracy sweep: " + method);
+        }
+    }
+    return records;
+}
+
+// Flags the records on the Pareto front of median latency against metric.
+void mark_pareto(std::vector<AccuracyRecord>& records, std::string metric){
+    for(AccuracyRecord& r : records){
+        double t = r.latency.median, e = metric_error(r, metric);
+        r.pareto = std::none_of(records.begin(), records.end(), [&](const AccuracyRecord& o){
+            double ot = o.latency.median, oe = metric_error(o, metric);
+            return ot <= t && oe <= e && (ot < t || oe < e);
+        });
+    }
+}
+
+// most accurate record by metric with median latency within budget_ms, nullptr if none fits
+const AccuracyRecord* best_under_budget(const std::vector<AccuracyRecord>& records, std::string metric, double budget_ms){
+    const AccuracyRecord* best = nullptr;
+    for(const AccuracyRecord& r : records){
+        if(r.latency.median > budget_ms) continue;
+        if(best == nullptr || metric_error(r, metric) < metric_error(*best, metric)) best = &r;
+    }
+    return best;
+}
+
+
+void write_accuracy_csv(std::string filename, const std::vector<AccuracyRecord>& records){
+    std::ofstream os(filename);
+    if(!os.is_open()){
+        throw std::runtime_error("Could not write to file: " + filename);
+    }
+    os << "graph,method,eps,rmax,rw_num,pi_num,queries,median_ms,p99_ms,max_rel_err,l1,precision,ndcg,pareto\n";
+    for(const AccuracyRecord& r : records){
+        os << r.graph << "," << r.method << "," << r.eps << "," << r.rmax << "," << r.rw_num << "," << r.pi_num << ","
+           << r.latency.count << "," << r.latency.median << "," << r.latency.p99 << ","
+           << r.metrics.max_rel_err << "," << r.metrics.l1 << "," << r.metrics.precision << "," << r.metrics.ndcg << ","
+           << r.pareto << "\n";
+    }
+}
+
+
+}
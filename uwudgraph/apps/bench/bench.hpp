@@ -0,0 +1,176 @@
+/*
+// This header file implements the SSPPR benchmark harness. For every (method, alpha, eps) in the grid it
+// runs warmup queries, then times reps passes over the sampled sources, one latency sample per query.
+// Work counters come from one extra pass on a CountingGraph, so the timed passes run the plain kernels.
+// Results are written as JSON and CSV; compare_baseline matches a run against a stored CSV by
+// (graph, method, alpha, eps) and flags medians that got slower by more than the tolerance.
+*/
+
+
+# pragma once
+
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "benchmark.hpp"
+#include "convenientPrint.hpp"
+#include "random.hpp"
+
+#include "uwudgraph/apps/ssppr/ssppr.hpp"
+
+
+namespace uwudgraph{
+
+
+struct BenchConfig{
+    std::string graph;                      // label written into the records
+    std::vector<std::string> methods = {"push", "rw", "fora_skeleton", "fora", "speedppr", "ppw"};
+    std::vector<double> alphas = {0.2};
+    std::vector<double> epss = {0.1};
+    size_t num_sources = 10;                // sampled among nodes with out-edges
+    std::vector<uint64_t> sources;          // used instead of sampling when not empty
+    size_t warmup = 1;                      // untimed queries per source
+    size_t reps = 5;                        // timed passes over all sources
+    double rmax = 0;                        // 0 keeps the SSPPR defaults
+    size_t rw_num = 0;
+    Dangling dangling = Dangling::selfloop;
+    uint32_t seed = 1;
+};
+
+struct BenchRecord{
+    std::string graph, method;
+    double alpha = 0, eps = 0;
+    LatencySummary latency;                 // milliseconds per query
+    double pushes = 0;                      // per query, see CountingGraph::scans
+    double walk_steps = 0;                  // per query
+    size_t peak_rss_kb = 0;                 // of the process after this configuration
+};
+
+
+// up to num uniformly sampled nodes with out-edges
+template <class G>
+std::vector<uint64_t> sample_sources(const G& g, size_t num, uint32_t seed){
+    std::vector<uint64_t> sources;
+    std::mt19937 gen(seed);
+    std::uniform_int_distribution<uint64_t> dist(0, g.n - 1);
+    for(size_t tries=0; sources.size() < num && tries < 100 * num; ++tries){
+        uint64_t s = dist(gen);
+        if(g.get_neighbor_count(s) > 0) sources.push_back(s);
+    }
+    if(sources.empty()){
+        throw std::invalid_argument("No source with out-edges found for the benchmark.");
+    }
+    return sources;
+}
+
+template <class G>
+std::vector<BenchRecord> bench_ssppr(const G& g, BenchConfig config){
+    if(config.sources.empty()) config.sources = sample_sources(g, config.num_sources, config.seed);
+
+    std::vector<BenchRecord> records;
+    for(const std::string& method : config.methods){
+        for(double alpha : config.alphas){
+            for(double eps : config.epss){
+                auto query = [&](const auto& graph, uint64_t s){
+                    return SSPPR(graph, s, alpha, method, eps, 0, 0, config.rmax, config.rw_num, 0, 0, 0, config.dangling);
+                };
+                for(size_t w=0; w<config.warmup; ++w){
+                    for(uint64_t s : config.sources) query(g, s);
+                }
+                std::vector<double> latencies;
+                double sink = 0;
+                for(size_t rep=0; rep<config.reps; ++rep){
+                    for(uint64_t s : config.sources){
+                        auto start = std::chrono::steady_clock::now();
+                        std::vector<double> ppr = query(g, s);
+                        latencies.push_back(std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count());
+                        sink += ppr[s];
+                    }
+                }
+                CountingGraph<G> counted(g);
+                for(uint64_t s : config.sources) sink += query(counted, s)[s];
+
+                BenchRecord rec;
+                rec.graph = config.graph;
+                rec.method = method;
+                rec.alpha = alpha;
+                rec.eps = eps;
+                rec.latency = summarize(latencies);
+                rec.pushes = static_cast<double>(counted.scans) / config.sources.size();
+                rec.walk_steps = static_cast<double>(counted.steps) / config.sources.size();
+                rec.peak_rss_kb = peak_rss_kb();
+                records.push_back(rec);
+                if(sink < 0) print("");     // keeps the queries from being optimized away
+            }
+        }
+    }
+    return records;
+}
+
+
+void write_bench_csv(std::string filename, const std::vector<BenchRecord>& records){
+    std::ofstream os(filename);
+    if(!os.is_open()){
+        throw std::runtime_error("Could not write to file: " + filename);
+    }
+    os << "graph,method,alpha,eps,queries,median_ms,p99_ms,mean_ms,pushes,walk_steps,peak_rss_kb\n";
+    for(const BenchRecord& r : records){
+        os << r.graph << "," << r.method << "," << r.alpha << "," << r.eps << "," << r.latency.count << ","
+           << r.latency.median << "," << r.latency.p99 << "," << r.latency.mean << ","
+           << r.pushes << "," << r.walk_steps << "," << r.peak_rss_kb << "\n";
+    }
+}
+
+void write_bench_json(std::string filename, const std::vector<BenchRecord>& records){
+    std::ofstream os(filename);
+    if(!os.is_open()){
+        throw std::runtime_error("Could not write to file: " + filename);
+    }
+    os << "[\n";
+    for(size_t i=0; i<records.size(); ++i){
+        const BenchRecord& r = records[i];
+        os << "  {\"graph\": \"" << r.graph << "\", \"method\": \"" << r.method << "\", \"alpha\": " << r.alpha
+           << ", \"eps\": " << r.eps << ", \"queries\": " << r.latency.count
+           << ", \"median_ms\": " << r.latency.median << ", \"p99_ms\": " << r.latency.p99
+           << ", \"mean_ms\": " << r.latency.mean << ", \"pushes\": " << r.pushes
+           << ", \"walk_steps\": " << r.walk_steps << ", \"peak_rss_kb\": " << r.peak_rss_kb << "}"
+           << (i + 1 < records.size() ? ",\n" : "\n");
+    }
+    os << "]\n";
+}
+
+// Prints the median of every record next to its baseline. A record regresses when its median is more than
+// tolerance (relative) and noise_ms (absolute) above the baseline. Returns the number of regressions.
+size_t compare_baseline(const std::vector<BenchRecord>& records, std::string baseline, double tolerance, double noise_ms){
+    std::vector<std::map<std::string, std::string>> rows = read_csv(baseline);
+    size_t regressions = 0;
+    for(const BenchRecord& r : records){
+        const std::map<std::string, std::string>* base = nullptr;
+        for(const auto& row : rows){
+            if(row.at("graph") == r.graph && row.at("method") == r.method &&
+               std::stod(row.at("alpha")) == r.alpha && std::stod(row.at("eps")) == r.eps){
+                base = &row;
+            }
+        }
+        if(base == nullptr){
+            print(r.method, "alpha", r.alpha, "eps", r.eps, ": no baseline");
+            continue;
+        }
+        double before = std::stod(base->at("median_ms"));
+        double after = r.latency.median;
+        bool regressed = after > before * (1 + tolerance) && after - before > noise_ms;
+        regressions += regressed;
+        print(r.method, "alpha", r.alpha, "eps", r.eps, ": median", before, "->", after, "ms",
+              regressed ? "REGRESSION" : "ok");
+    }
+    return regressions;
+}
+
+
+}
@@ -0,0 +1,180 @@
+/*
+// This header file turns raw edge lists into graphs with dense node ids, replacing scripts/map_points.py.
+// Node ids may be arbitrary 64-bit integers or strings; IdMap hashes them to 0..n-1 in order of first
+// appearance and can save the mapping as "original<TAB>dense" lines.
+// Lines are split at spaces, tabs and commas, columns after the second are ignored and lines starting
+// with '#' or '/' are comments, as in load_edgelist.
+*/
+
+
+# pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <fstream>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "multithread/parallel.hpp"
+
+#include "uwudgraph/graph.hpp"
+#include "uwudgraph/graph_types.hpp"
+
+
+namespace uwudgraph{
+
+
+class IdMap{
+public:
+    // mode: "int" for 64-bit integer ids, "string" for any token, "auto" to decide on the first id
+    IdMap(std::string mode = "auto"){
+        if(mode == "int") numeric = 1;
+        else if(mode == "string") numeric = 0;
+        else if(mode != "auto") throw std::invalid_argument("Invalid id mode specified for IdMap: " + mode);
+    }
+
+    // dense id of token, assigning the next one if it is new
+    node_id get(const std::string& token){
+        if(numeric < 0) numeric = is_integer(token);
+        if(numeric){
+            if(!is_integer(token)){
+                throw std::invalid_argument("Non-integer node id \"" + token + "\", use string ids.");
+            }
+            auto [it, inserted] = int_ids.try_emplace(std::stoull(token), int_names.size());
+            if(inserted) int_names.push_back(it->first);
+            return it->second;
+        }
+        auto [it, inserted] = str_ids.try_emplace(token, str_names.size());
+        if(inserted) str_names.push_back(token);
+        return it->second;
+    }
+
+    node_id size() const{
+        return numeric == 1 ? int_names.size() : str_names.size();
+    }
+
+    std::string name(node_id u) const{
+        return numeric == 1 ? std::to_string(int_names[u]) : str_names[u];
+    }
+
+    // Writes "original<TAB>dense" for every id. With remap, dense id u is written as remap[u] and
+    // skipped if remap[u] is node_id(-1), e.g. for nodes outside an extracted component.
+    void save(std::string filename, const std::vector<node_id>& remap = {}) const{
+        std::ofstream os(filename);
+        if(!os.is_open()){
+            throw std::runtime_error("Could not write to file: " + filename);
+        }
+        for(node_id u=0; u<size(); ++u){
+            node_id id = remap.empty() ? u : remap[u];
+            if(id == static_cast<node_id>(-1)) continue;
+            os << name(u) << "\t" << id << "\n";
+        }
+    }
+
+private:
+    int numeric = -1;   // -1 undecided
+    std::unordered_map<uint64_t, node_id> int_ids;
+    std::vector<uint64_t> int_names;
+    std::unordered_map<std::string, node_id> str_ids;
+    std::vector<std::string> str_names;
+
+    static bool is_integer(const std::string& token){
+        return !token.empty() && token.size() <= 20 &&
+               std::all_of(token.begin(), token.end(), [](unsigned char c){ return std::isdigit(c); });
+    }
+};
+
+
+// Reads the edges of a raw edge list, mapping both endpoints through ids.
+std::vector<edge> read_raw_edgelist(std::string filename, IdMap& ids){
+    std::ifstream is(filename);
+    if(!is.is_open()){
+        throw std::runtime_error("Could not open file: " + filename);
+    }
+    std::vector<edge> edges;
+    std::string line, token[2];
+    size_t lineno = 0;
+    while(std::getline(is, line)){
+        ++lineno;
+        if(line.empty() || line[0] == '#' || line[0] == '/') continue;
+        int found = 0;
+        size_t i = 0;
+        while(found < 2 && i < line.size()){
+            while(i < line.size() && (line[i] == ' ' || line[i] == '\t' || line[i] == ',' || line[i] == '\r')) ++i;
+            size_t start = i;
+            while(i < line.size() && line[i] != ' ' && line[i] != '\t' && line[i] != ',' && line[i] != '\r') ++i;
+            if(i > start) token[found++] = line.substr(start, i - start);
+        }
+        if(found == 0) continue;
+        if(found != 2){
+            throw std::runtime_error("Wrong number of tokens on edgelist line " + std::to_string(lineno) + ".");
+        }
+        try{
+            node_id u = ids.get(token[0]);
+            edges.emplace_back(u, ids.get(token[1]));
+        } catch(std::logic_error& e){
+            throw std::runtime_error(std::string(e.what()) + " (line " + std::to_string(lineno) + ")");
+        }
+    }
+    return edges;
+}
+
+// Simple undirected graph on n nodes: self-loops and parallel edges are dropped, rows are sorted.
+// Threads count the row lengths of their edges with atomic increments into one n-sized array, which after a prefix
+// sum holds the cursor of every row, and scatter their arcs by atomically advancing the cursors. Extra memory is
+// O(n) whatever the thread count; rows are sorted afterwards, so the result does not depend on it either.
+// edge_id is 32-bit, so at most 2^32 - 1 edges are accepted, duplicates included; more throw std::invalid_argument.
+Graph* build_graph(node_id n, const std::vector<edge>& edges){
+    if(edges.size() > std::numeric_limits<edge_id>::max()){
+        throw std::invalid_argument("Too many edges for a 32-bit edge_id: " + std::to_string(edges.size()));
+    }
+    Graph* g = new Graph();
+    g->n = n;
+    // the length of row u, then the position of its next arc
+    std::vector<std::atomic<size_t>> cursor(n);
+    // f(u, v) for every arc (u, v) of the edges, in parallel
+    auto for_each_arc = [&](auto&& f){
+        parallel_for(0, edges.size(), [&](size_t e){
+            auto [u, v] = edges[e];
+            if(u == v) return;
+            f(u, v);
+            f(v, u);
+        }, 4096);
+    };
+    for_each_arc([&](node_id u, node_id){ cursor[u].fetch_add(1, std::memory_order_relaxed); });
+    std::vector<size_t> start(n + 1, 0);
+    for(node_id u=0; u<n; ++u){
+        start[u + 1] = start[u] + cursor[u].load(std::memory_order_relaxed);
+        cursor[u].store(start[u], std::memory_order_relaxed);
+    }
+    huge_vector<node_id> arcs(start[n]);
+    for_each_arc([&](node_id u, node_id v){ arcs[cursor[u].fetch_add(1, std::memory_order_relaxed)] = v; });
+    std::vector<std::atomic<size_t>>().swap(cursor);
+
+    std::vector<size_t> fill(n);
+    // fill[u] - start[u] becomes the length of row u without duplicates
+    parallel_for(0, n, [&](size_t u){
+        node_id* first = arcs.data() + start[u];
+        std::sort(first, arcs.data() + start[u + 1]);
+        fill[u] = start[u] + (std::unique(first, arcs.data() + start[u + 1]) - first);
+    }, 1024);
+    g->offsets.assign(n + 1, 0);
+    for(node_id u=0; u<n; ++u) g->offsets[u + 1] = g->offsets[u] + (fill[u] - start[u]);
+    if(g->offsets[n] == start[n]){
+        g->targets = std::move(arcs);
+    } else{
+        g->targets.resize(g->offsets[n]);
+        parallel_for(0, n, [&](size_t u){
+            std::copy(arcs.data() + start[u], arcs.data() + fill[u], g->targets.data() + g->offsets[u]);
+        }, 1024);
+    }
+    g->m = g->offsets[n] / 2;
+    return g;
+}
+
+
+}
@@ -0,0 +1,110 @@
+/*
+// This header file implements connected-component labelling of undirected graphs.
+// Components are numbered 0..num_components-1 in order of their smallest node id.
+// The labelling is a parallel union-find: every edge is united with compare-and-swap, always hooking the larger
+// root under the smaller one, so the root of a component is its smallest node and no cycle can form.
+// find() halves paths as it goes; losing a race only leaves a path a bit longer.
+
+// Sources:
+//     union-find               : "Wait-free Parallel Algorithms for the Union-Find Problem", Anderson and Woll
+*/
+
+
+# pragma once
+
+#include <atomic>
+#include <vector>
+
+#include "multithread/parallel.hpp"
+
+#include "uwudgraph/graph.hpp"
+#include "uwudgraph/graph_types.hpp"
+
+
+namespace uwudgraph{
+
+
+namespace __component_detail{
+
+node_id find(std::vector<std::atomic<node_id>>& parent, node_id u){
+    while(true){
+        node_id p = parent[u].load(std::memory_order_relaxed);
+        if(p == u) return u;
+        node_id gp = parent[p].load(std::memory_order_relaxed);
+        if(gp != p) parent[u].compare_exchange_weak(p, gp, std::memory_order_relaxed);
+        u = gp;
+    }
+}
+
+void unite(std::vector<std::atomic<node_id>>& parent, node_id u, node_id v){
+    while(true){
+        u = find(parent, u);
+        v = find(parent, v);
+        if(u == v) return;
+        if(u < v) std::swap(u, v);
+        node_id expected = u;
+        if(parent[u].compare_exchange_strong(expected, v)) return;
+    }
+}
+
+}
+
+
+// label[u] is the component of u; num_components receives the number of components
+std::vector<node_id> connected_components(const Graph& g, node_id& num_components){
+    std::vector<std::atomic<node_id>> parent(g.n);
+    parallel_for(0, g.n, [&](size_t u){ parent[u].store(u, std::memory_order_relaxed); }, 4096);
+    parallel_for(0, g.n, [&](size_t u){
+        for(node_id v : g.get_neighbors(u)){
+            if(v < u) __component_detail::unite(parent, u, v);
+        }
+    }, 256);
+
+    std::vector<node_id> label(g.n);
+    parallel_for(0, g.n, [&](size_t u){ label[u] = __component_detail::find(parent, u); }, 4096);
+    // roots are the smallest nodes of their components, so a scan numbers them in order
+    std::vector<node_id> index(g.n);
+    num_components = 0;
+    for(node_id u=0; u<g.n; ++u){
+        if(label[u] == u) index[u] = num_components++;
+    }
+    parallel_for(0, g.n, [&](size_t u){ label[u] = index[label[u]]; }, 4096);
+    return label;
+}
+
+// component with the most nodes, ties broken by the smaller component id
+node_id largest_component(const std::vector<node_id>& label, node_id num_components){
+    std::vector<node_id> size(num_components, 0);
+    for(node_id c : label) ++size[c];
+    node_id best = 0;
+    for(node_id c=1; c<num_components; ++c){
+        if(size[c] > size[best]) best = c;
+    }
+    return best;
+}
+
+// Subgraph induced by the nodes of component c, renumbered 0..size-1 in increasing id order.
+// new_id[u] receives the id of u in the subgraph, or node_id(-1) if u is outside it.
+Graph* extract_component(const Graph& g, const std::vector<node_id>& label, node_id c, std::vector<node_id>& new_id){
+    new_id.assign(g.n, static_cast<node_id>(-1));
+    Graph* sub = new Graph();
+    for(node_id u=0; u<g.n; ++u){
+        if(label[u] == c) new_id[u] = sub->n++;
+    }
+    // rows keep their length: every neighbor of a node in c is in c
+    sub->offsets.assign(sub->n + 1, 0);
+    for(node_id u=0; u<g.n; ++u){
+        if(label[u] == c) sub->offsets[new_id[u] + 1] = sub->offsets[new_id[u]] + g.get_degree(u);
+    }
+    sub->targets.resize(sub->offsets[sub->n]);
+    parallel_for(0, g.n, [&](size_t u){
+        if(label[u] != c) return;
+        node_id* row = sub->targets.data() + sub->offsets[new_id[u]];
+        for(node_id v : g.get_neighbors(u)) *row++ = new_id[v];
+    }, 1024);
+    sub->m = sub->offsets[sub->n] / 2;
+    return sub;
+}
+
+
+}
@@ -0,0 +1,32 @@
+# pragma once
+
+#include "uwudgraph/graph.hpp"
+#include "uwudgraph/graph_types.hpp"
+#include "uwudgraph/graphio.hpp"
+
+#include "lanczos.hpp"
+
+
+namespace uwudgraph{
+
+
+EigenResult Eigen(std::string filename, size_t k, std::string which, double tol, size_t max_restarts, size_t block_size){
+    Graph* g = load_graph(filename);
+
+    if(tol == 0) tol = 1e-8;
+    if(max_restarts == 0) max_restarts = 1000;
+
+    EigenResult result;
+    if(which == "laplacian"){
+        result = laplacian_smallest(*g, k, tol, max_restarts, block_size);
+    } else if(which == "normalized_adjacency"){
+        result = normalized_adjacency_largest(*g, k, tol, max_restarts, block_size);
+    } else{
+        delete g;
+        throw std::invalid_argument("Invalid operator specified for Eigen.");
+    }
+    delete g;
+    return result;
+}
+
+};
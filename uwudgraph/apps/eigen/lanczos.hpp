@@ -0,0 +1,247 @@
+/*
+// This header file implements a thick-restart block Lanczos eigensolver and the graph operators it runs on.
+// The solver keeps an orthonormal basis of at most m + b vectors (m = O(k)), so memory stays O(k*n).
+// Every new block is fully reorthogonalized against the basis (classical Gram-Schmidt, applied twice),
+// the Rayleigh quotient V^T A V is diagonalized with a dense Jacobi solver, and on restart the wanted
+// Ritz vectors are kept together with the residual block.
+// Blocks larger than one vector resolve repeated eigenvalues, which single-vector Lanczos finds only slowly.
+
+// Sources:
+//     thick restart            : "Thick-Restart Lanczos Method for Large Symmetric Eigenvalue Problems", Wu and Simon
+//     block Lanczos            : "Matrix Computations", Golub and Van Loan, Section 10.3.6
+*/
+
+
+# pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <mutex>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+#include "linalg.hpp"
+#include "multithread/parallel.hpp"
+
+#include "uwudgraph/graph.hpp"
+#include "uwudgraph/graph_types.hpp"
+#include "uwudgraph/operators.hpp"
+
+
+namespace uwudgraph{
+
+
+struct EigenResult{
+    std::vector<double> values;                 // k eigenvalues, in the order requested
+    std::vector<std::vector<double>> vectors;   // k unit eigenvectors of length n
+    size_t spmv = 0;                            // number of operator applications
+    size_t restarts = 0;
+    bool converged = false;
+};
+
+
+namespace __lanczos_detail{
+
+// w -= sum_{i<cnt} <w, V_i> V_i, twice; h accumulates the removed coefficients
+void project_out(const std::vector<std::vector<double>>& V, size_t cnt, std::vector<double>& w, std::vector<double>& h){
+    size_t n = w.size();
+    std::vector<double> c(cnt);
+    std::mutex mutex;
+    for(int pass=0; pass<2; ++pass){
+        std::fill(c.begin(), c.end(), 0.0);
+        parallel_for_chunks(0, n, [&](size_t lo, size_t hi){
+            std::vector<double> local(cnt, 0.0);
+            for(size_t i=0; i<cnt; ++i){
+                const double* vi = V[i].data();
+                double acc = 0;
+                for(size_t x=lo; x<hi; ++x) acc += vi[x] * w[x];
+                local[i] = acc;
+            }
+            std::lock_guard<std::mutex> lock(mutex);
+            for(size_t i=0; i<cnt; ++i) c[i] += local[i];
+        });
+        parallel_for_chunks(0, n, [&](size_t lo, size_t hi){
+            for(size_t i=0; i<cnt; ++i){
+                const double* vi = V[i].data();
+                for(size_t x=lo; x<hi; ++x) w[x] -= c[i] * vi[x];
+            }
+        });
+        for(size_t i=0; i<cnt; ++i) h[i] += c[i];
+    }
+}
+
+// Orthonormalize w against V[0, cnt) into V[cnt]. Returns the norm of w after projection.
+// A (numerically) dependent w is replaced by a random direction; a full basis leaves V[cnt] zero.
+double extend_basis(std::vector<std::vector<double>>& V, size_t cnt, std::vector<double>& w, std::vector<double>& h,
+                    std::mt19937& gen){
+    double wnorm = norm2(w);
+    project_out(V, cnt, w, h);
+    double beta = norm2(w);
+    if(beta > 1e-10 * wnorm && beta > 0){
+        V[cnt] = w;
+        scale(1.0 / beta, V[cnt]);
+        return beta;
+    }
+    std::normal_distribution<double> normal;
+    std::vector<double> discard(cnt, 0.0);
+    for(double& x : w) x = normal(gen);
+    double rnorm = norm2(w);
+    project_out(V, cnt, w, discard);
+    double rbeta = norm2(w);
+    if(rbeta > 1e-8 * rnorm){
+        V[cnt] = w;
+        scale(1.0 / rbeta, V[cnt]);
+    } else{
+        std::fill(V[cnt].begin(), V[cnt].end(), 0.0);
+    }
+    return 0.0;
+}
+
+// V[0, p) = V[0, cnt) * Y[:, 0, p), in place, Y is row-major cnt x ldy
+void rotate_basis(std::vector<std::vector<double>>& V, size_t cnt, const std::vector<double>& Y, size_t ldy, size_t p){
+    size_t n = V[0].size();
+    parallel_for_chunks(0, n, [&](size_t lo, size_t hi){
+        std::vector<double> tmp(p);
+        for(size_t x=lo; x<hi; ++x){
+            std::fill(tmp.begin(), tmp.end(), 0.0);
+            for(size_t j=0; j<cnt; ++j){
+                double vjx = V[j][x];
+                for(size_t i=0; i<p; ++i) tmp[i] += vjx * Y[j * ldy + i];
+            }
+            for(size_t i=0; i<p; ++i) V[i][x] = tmp[i];
+        }
+    }, 256);
+}
+
+}
+
+
+// Thick-restart block Lanczos for the k largest eigenpairs of a symmetric operator on R^n.
+// op(X, first, Y, b) must write Y[c] = A X[first + c] for c in [0, b).
+// Eigenpairs are converged when ||A u - theta u|| <= tol * max|theta|.
+template <typename Op>
+EigenResult lanczos_largest(Op&& op, size_t n, size_t k, double tol, size_t max_restarts, size_t block_size = 0,
+                            size_t krylov_dim = 0, uint32_t seed = 1){
+    if(k == 0 || k > n){
+        throw std::invalid_argument("Number of eigenpairs must be in [1, n].");
+    }
+    size_t b = block_size ? block_size : std::min<size_t>(k, 4);
+    size_t m = krylov_dim ? krylov_dim : std::max(2 * k + 2 * b, k + 20 * b);
+    m = std::min(m, n);
+    b = std::min(b, m);
+
+    std::mt19937 gen(seed);
+    std::normal_distribution<double> normal;
+    std::vector<std::vector<double>> V(m + b, std::vector<double>(n, 0.0));
+    std::vector<std::vector<double>> W(b, std::vector<double>(n, 0.0));
+    std::vector<double> T(m * m, 0.0), R(b * b, 0.0), h(m + b);
+    std::vector<double> evals, evecs;
+    EigenResult result;
+
+    // random orthonormal starting block
+    for(size_t c=0; c<b; ++c){
+        for(double& x : W[c]) x = normal(gen);
+        std::fill(h.begin(), h.end(), 0.0);
+        __lanczos_detail::extend_basis(V, c, W[c], h, gen);
+    }
+
+    size_t ne = 0;   // number of expanded basis vectors, V[ne, ne + b) is the unexpanded block
+    for(result.restarts=0; ; ++result.restarts){
+        while(ne + b <= m){
+            op(V, ne, W, b);
+            result.spmv += b;
+            for(size_t c=0; c<b; ++c){
+                std::fill(h.begin(), h.end(), 0.0);
+                h[ne + b + c] = __lanczos_detail::extend_basis(V, ne + b + c, W[c], h, gen);
+                // the projections onto the expanded part are entries of the Rayleigh quotient
+                for(size_t i=0; i<ne + b; ++i){
+                    T[i * m + ne + c] = h[i];
+                    T[(ne + c) * m + i] = h[i];
+                }
+                // coupling of this block with the next one
+                for(size_t r=0; r<b; ++r) R[r * b + c] = h[ne + b + r];
+            }
+            ne += b;
+        }
+
+        std::vector<double> Tne(ne * ne);
+        for(size_t i=0; i<ne; ++i){
+            for(size_t j=0; j<ne; ++j) Tne[i * ne + j] = T[i * m + j];
+        }
+        sym_eig(Tne, ne, evals, evecs);
+
+        double scale_theta = std::max(std::abs(evals.front()), std::abs(evals.back()));
+        if(scale_theta == 0) scale_theta = 1;
+        result.converged = true;
+        for(size_t i=0; i<k; ++i){
+            double res = 0;
+            for(size_t r=0; r<b; ++r){
+                double acc = 0;
+                for(size_t c=0; c<b; ++c) acc += R[r * b + c] * evecs[(ne - b + c) * ne + i];
+                res += acc * acc;
+            }
+            if(std::sqrt(res) > tol * scale_theta) result.converged = false;
+        }
+
+        if(result.converged || result.restarts >= max_restarts){
+            __lanczos_detail::rotate_basis(V, ne, evecs, ne, k);
+            result.values.assign(evals.begin(), evals.begin() + k);
+            result.vectors.assign(V.begin(), V.begin() + k);
+            break;
+        }
+
+        // keep p Ritz vectors and move the residual block right behind them
+        size_t p = std::max(k, std::min(m - b, k + (m - k) / 2));
+        __lanczos_detail::rotate_basis(V, ne, evecs, ne, p);
+        for(size_t c=0; c<b; ++c) V[p + c].swap(V[ne + c]);
+        std::fill(T.begin(), T.end(), 0.0);
+        for(size_t i=0; i<p; ++i) T[i * m + i] = evals[i];
+        ne = p;
+    }
+
+    // fix the sign of each eigenvector so the entry of largest magnitude is positive
+    for(std::vector<double>& vec : result.vectors){
+        size_t arg = 0;
+        for(size_t x=1; x<n; ++x){
+            if(std::abs(vec[x]) > std::abs(vec[arg]) + 1e-12) arg = x;
+        }
+        if(vec[arg] < 0) scale(-1.0, vec);
+    }
+    return result;
+}
+
+
+// k smallest eigenpairs of the Laplacian L = D - A, in ascending order.
+// Runs Lanczos on 2*dmax*I - L, whose spectrum is the reversed spectrum of L.
+EigenResult laplacian_smallest(const Graph& g, size_t k, double tol, size_t max_restarts, size_t block_size = 0){
+    node_id dmax = 0;
+    for(node_id u=0; u<g.n; ++u) dmax = std::max(dmax, g.get_degree(u));
+    double sigma = 2.0 * dmax;
+    auto op = [&](const std::vector<std::vector<double>>& X, size_t first, std::vector<std::vector<double>>& Y, size_t b){
+        laplacian_spmv(g, X, first, Y, b);
+        for(size_t c=0; c<b; ++c){
+            const std::vector<double>& x = X[first + c];
+            std::vector<double>& y = Y[c];
+            parallel_for(0, g.n, [&](size_t u){ y[u] = sigma * x[u] - y[u]; }, 4096);
+        }
+    };
+    EigenResult result = lanczos_largest(op, g.n, k, tol, max_restarts, block_size);
+    for(double& v : result.values) v = sigma - v;
+    return result;
+}
+
+// k largest eigenpairs of the normalized adjacency D^{-1/2} A D^{-1/2}, in descending order.
+EigenResult normalized_adjacency_largest(const Graph& g, size_t k, double tol, size_t max_restarts, size_t block_size = 0){
+    std::vector<double> dinv_sqrt(g.n, 0.0);
+    for(node_id u=0; u<g.n; ++u){
+        if(g.get_degree(u) > 0) dinv_sqrt[u] = 1.0 / std::sqrt(static_cast<double>(g.get_degree(u)));
+    }
+    auto op = [&](const std::vector<std::vector<double>>& X, size_t first, std::vector<std::vector<double>>& Y, size_t b){
+        normalized_adjacency_spmv(g, dinv_sqrt, X, first, Y, b);
+    };
+    return lanczos_largest(op, g.n, k, tol, max_restarts, block_size);
+}
+
+
+}
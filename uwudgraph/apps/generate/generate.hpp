@@ -0,0 +1,198 @@
+/*
+// This header file implements seeded parallel generators of synthetic undirected graphs for scale testing.
+// Edges are produced in fixed blocks, each block drawing from its own counter-based stream, so a seed gives
+// the same graph for any number of threads. Graphs are built with build_graph, which drops self-loops and
+// parallel edges, so m is the number of distinct edges and can be below the number of draws.
+// Models:
+//     rmat     : 2^scale nodes, m draws recursing into the quadrants with probabilities a, b, c, 1-a-b-c;
+//                node ids are scrambled by a seeded bijection so degree does not follow the id.
+//     er       : G(n, m), m uniform node pairs.
+//     ba       : Barabasi-Albert with k edges per node. Edge j leaves node j / k and copies the endpoint
+//                at a random earlier position of the edge array, which every edge resolves on its own.
+//     sbm      : planted partition with blocks equal blocks, m draws, a fraction mu of which pick the second
+//                endpoint anywhere instead of inside the block of the first.
+//     grid     : rows x cols lattice, every edge kept with probability keep, road-like for keep < 1.
+
+// Sources:
+//     rmat                     : "R-MAT: A Recursive Model for Graph Mining", Chakrabarti, Zhan and Faloutsos
+//     ba                       : "Scalable Generation of Scale-free Graphs", Sanders and Schulz
+*/
+
+
+# pragma once
+
+#include <algorithm>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "multithread/parallel.hpp"
+#include "random.hpp"
+
+#include "uwudgraph/graph.hpp"
+#include "uwudgraph/graph_types.hpp"
+#include "uwudgraph/apps/component/compact.hpp"
+
+
+namespace uwudgraph{
+
+
+struct GeneratorParams{
+    node_id n = 0;              // er, ba, sbm
+    size_t m = 0;               // rmat, er, sbm: number of edge draws
+    uint32_t scale = 0;         // rmat
+    double a = 0.57, b = 0.19, c = 0.19;
+    node_id k = 0;              // ba: edges per node
+    node_id blocks = 0;         // sbm
+    double mu = 0.1;            // sbm
+    node_id rows = 0, cols = 0; // grid
+    double keep = 1.0;          // grid
+    uint64_t seed = 1;
+};
+
+
+namespace __generate_detail{
+
+const size_t block_size = 1 << 16;
+
+// counter-based stream of one block of edges
+struct Stream{
+    uint64_t state;
+
+    Stream(uint64_t seed, uint64_t block) : state(splitmix64(seed ^ splitmix64(block))){}
+
+    uint64_t next(){
+        return splitmix64(state++);
+    }
+
+    double uniform(){
+        return 0x1.0p-53 * (next() >> 11);
+    }
+
+    // uniform in [0, n)
+    uint64_t below(uint64_t n){
+        return static_cast<uint64_t>((static_cast<unsigned __int128>(next()) * n) >> 64);
+    }
+};
+
+// Fills edges[0, m) in parallel blocks, f(stream, j) returns edge j.
+template <typename F>
+std::vector<edge> draw_edges(size_t m, uint64_t seed, F&& f){
+    std::vector<edge> edges(m);
+    size_t blocks = (m + block_size - 1) / block_size;
+    parallel_for(0, blocks, [&](size_t blk){
+        Stream stream(seed, blk);
+        for(size_t j=blk * block_size; j<std::min(m, (blk + 1) * block_size); ++j) edges[j] = f(stream, j);
+    }, 1);
+    return edges;
+}
+
+}
+
+
+std::vector<edge> generate_rmat_edges(uint32_t scale, size_t m, double a, double b, double c, uint64_t seed){
+    if(scale == 0 || scale > 31 || a < 0 || b < 0 || c < 0 || a + b + c > 1){
+        throw std::invalid_argument("Invalid R-MAT parameters.");
+    }
+    // quadrant thresholds with 16-bit precision, so one 64-bit draw serves four levels
+    uint32_t ta = a * 65536, tab = (a + b) * 65536, tabc = (a + b + c) * 65536;
+    // seeded bijection of [0, 2^scale): odd multipliers and xor-shifts, no permutation table to miss in cache
+    uint64_t mask = (uint64_t(1) << scale) - 1;
+    uint64_t mul1 = splitmix64(seed) | 1, mul2 = splitmix64(seed + 1) | 1;
+    uint32_t shift = (scale + 1) / 2;
+    auto scramble = [=](uint64_t x){
+        x = (x * mul1) & mask;
+        x ^= x >> shift;
+        x = (x * mul2) & mask;
+        return static_cast<node_id>(x ^ (x >> shift));
+    };
+    return __generate_detail::draw_edges(m, seed, [&](__generate_detail::Stream& stream, size_t){
+        node_id u = 0, v = 0;
+        uint64_t bits = 0;
+        for(uint32_t level=0; level<scale; ++level){
+            if(level % 4 == 0) bits = stream.next();
+            uint32_t r = bits & 0xFFFF;
+            bits >>= 16;
+            node_id bu = r >= tab, bv = (r >= ta) ^ (r >= tab) ^ (r >= tabc);
+            u = (u << 1) | bu;
+            v = (v << 1) | bv;
+        }
+        return edge(scramble(u), scramble(v));
+    });
+}
+
+std::vector<edge> generate_er_edges(node_id n, size_t m, uint64_t seed){
+    if(n == 0) throw std::invalid_argument("Invalid Erdos-Renyi parameters.");
+    return __generate_detail::draw_edges(m, seed, [&](__generate_detail::Stream& stream, size_t){
+        node_id u = stream.below(n);
+        return edge(u, stream.below(n));
+    });
+}
+
+std::vector<edge> generate_ba_edges(node_id n, node_id k, uint64_t seed){
+    if(n == 0 || k == 0) throw std::invalid_argument("Invalid Barabasi-Albert parameters.");
+    // position 2j holds the source of edge j, position 2j+1 its target, a copy of a uniform earlier position
+    auto resolve = [&](uint64_t pos){
+        while(pos & 1){
+            uint64_t j = pos >> 1;
+            if(j == 0) return node_id(0);
+            pos = splitmix64(seed ^ splitmix64(pos)) % (2 * j);
+        }
+        return static_cast<node_id>((pos >> 1) / k);
+    };
+    return __generate_detail::draw_edges(static_cast<size_t>(n) * k, seed, [&](__generate_detail::Stream&, size_t j){
+        return edge(static_cast<node_id>(j / k), resolve(2 * j + 1));
+    });
+}
+
+std::vector<edge> generate_sbm_edges(node_id n, node_id blocks, size_t m, double mu, uint64_t seed){
+    if(n == 0 || blocks == 0 || blocks > n || mu < 0 || mu > 1){
+        throw std::invalid_argument("Invalid stochastic block model parameters.");
+    }
+    // block i is [i * n / blocks, (i + 1) * n / blocks)
+    auto first = [&](uint64_t i){ return static_cast<node_id>(i * n / blocks); };
+    return __generate_detail::draw_edges(m, seed, [&](__generate_detail::Stream& stream, size_t){
+        node_id u = stream.below(n);
+        if(stream.uniform() < mu) return edge(u, stream.below(n));
+        uint64_t i = static_cast<uint64_t>(u) * blocks / n;
+        while(first(i) > u) --i;
+        while(first(i + 1) <= u) ++i;
+        return edge(u, first(i) + stream.below(first(i + 1) - first(i)));
+    });
+}
+
+std::vector<edge> generate_grid_edges(node_id rows, node_id cols, double keep, uint64_t seed){
+    if(rows == 0 || cols == 0 || static_cast<uint64_t>(rows) * cols > node_id(-1)){
+        throw std::invalid_argument("Invalid grid parameters.");
+    }
+    // candidate 2u links u to its right neighbor, 2u+1 to the one below; dropped candidates become self-loops
+    size_t n = static_cast<size_t>(rows) * cols;
+    return __generate_detail::draw_edges(2 * n, seed, [&](__generate_detail::Stream& stream, size_t j){
+        node_id u = j / 2;
+        bool right = (j & 1) == 0;
+        bool exists = right ? (u % cols + 1 < cols) : (u / cols + 1 < rows);
+        if(!exists || (keep < 1 && stream.uniform() >= keep)) return edge(u, u);
+        return edge(u, right ? u + 1 : u + cols);
+    });
+}
+
+// model: "rmat", "er", "ba", "sbm" or "grid"
+Graph* generate_graph(std::string model, const GeneratorParams& p){
+    if(model == "rmat"){
+        return build_graph(node_id(1) << p.scale, generate_rmat_edges(p.scale, p.m, p.a, p.b, p.c, p.seed));
+    } else if(model == "er"){
+        return build_graph(p.n, generate_er_edges(p.n, p.m, p.seed));
+    } else if(model == "ba"){
+        return build_graph(p.n, generate_ba_edges(p.n, p.k, p.seed));
+    } else if(model == "sbm"){
+        return build_graph(p.n, generate_sbm_edges(p.n, p.blocks, p.m, p.mu, p.seed));
+    } else if(model == "grid"){
+        return build_graph(p.rows * p.cols, generate_grid_edges(p.rows, p.cols, p.keep, p.seed));
+    } else{
+        throw std::invalid_argument("Invalid model specified for generate_graph: " + model);
+    }
+}
+
+
+}
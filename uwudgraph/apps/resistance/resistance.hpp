@@ -0,0 +1,137 @@
+/*
+// This header file implements estimators of effective resistance R(s, t) = (e_s - e_t)^T L^+ (e_s - e_t).
+//     sketch   : Johnson-Lindenstrauss embedding Z = Q B L^+ with k = O(log n / eps^2) rows, built with k
+//                Laplacian solves run in parallel. Afterwards R(s, t) ~ ||Z e_s - Z e_t||^2 costs O(k)
+//                for any pair, and all edges are answered in one parallel pass.
+//     local    : estimates R_alpha(s, t) = (e_s - e_t)^T (L + alpha A)^{-1} (e_s - e_t) from the PPR vectors of
+//                s and t computed with forward push and random walks. Since (L + alpha A)^{-1} = Pi_alpha D^{-1} / alpha,
+//                R_alpha(s, t) = (pi_s(s)/d_s + pi_t(t)/d_t - pi_s(t)/d_t - pi_t(s)/d_s) / alpha.
+//                R_alpha is a biased proxy for R: with lambda_2 the spectral gap of the normalized Laplacian,
+//                    R / (1 - alpha + alpha / lambda_2) <= R_alpha <= R / (1 - alpha / 2),
+//                so it tends to R as alpha -> 0 and underestimates R once alpha is large against lambda_2.
+//                Smaller alpha lowers the bias but needs a smaller rmax, because the push error is amplified by 1/alpha.
+
+// Sources:
+//     sketch                   : "Graph Sparsification by Effective Resistances", Spielman and Srivastava
+//     local                    : "Local Algorithms for Estimating Effective Resistance", Peng et al.
+*/
+
+
+# pragma once
+
+#include <cmath>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+#include "multithread/parallel.hpp"
+
+#include "uwudgraph/graph.hpp"
+#include "uwudgraph/graph_types.hpp"
+#include "uwudgraph/apps/lapsolver/lapsolver.hpp"
+#include "uwudgraph/apps/ssppr/ssppr_custom.hpp"
+
+
+namespace uwudgraph{
+
+
+// Sketch dimension giving (1 +- eps) relative error for all pairs with high probability.
+size_t resistance_sketch_dim(node_id n, double eps){
+    return static_cast<size_t>(std::ceil(24.0 * std::log(std::max<node_id>(n, 2)) / (eps * eps)));
+}
+
+
+class ResistanceSketch{
+public:
+    // dim = 0 derives the sketch dimension from eps; the embedding is stored in float.
+    ResistanceSketch(const Graph& g, double eps, size_t dim = 0, std::string preconditioner = "jacobi",
+                     double tol = 1e-6, uint32_t seed = 1)
+        : g(g){
+        k = dim ? dim : resistance_sketch_dim(g.n, eps);
+        Z.assign(static_cast<size_t>(g.n) * k, 0.0f);
+        LaplacianSolver solver(g, preconditioner);
+        double scale_q = 1.0 / std::sqrt(static_cast<double>(k));
+
+        // every row is an independent solve; rows run in parallel, each solve runs on its own thread
+        parallel_for(0, k, [&](size_t i){
+            std::mt19937 gen(seed + static_cast<uint32_t>(i) * 0x9E3779B9u);
+            std::vector<double> b(g.n, 0.0), x;
+            for(node_id u=0; u<g.n; ++u){
+                for(node_id v : g.get_neighbors(u)){
+                    if(u < v){
+                        double y = (gen() & 1) ? scale_q : -scale_q;
+                        b[u] += y;
+                        b[v] -= y;
+                    }
+                }
+            }
+            solver.solve(b, x, tol, 10 * static_cast<size_t>(g.n) + 100);
+            for(node_id u=0; u<g.n; ++u) Z[static_cast<size_t>(u) * k + i] = static_cast<float>(x[u]);
+        }, 1);
+    }
+
+    size_t dim() const{
+        return k;
+    }
+
+    // O(dim) estimate of R(s, t)
+    double query(node_id s, node_id t) const{
+        const float* zs = &Z[static_cast<size_t>(s) * k];
+        const float* zt = &Z[static_cast<size_t>(t) * k];
+        double acc = 0;
+        for(size_t i=0; i<k; ++i){
+            double diff = static_cast<double>(zs[i]) - zt[i];
+            acc += diff * diff;
+        }
+        return acc;
+    }
+
+    std::vector<double> query_batch(const std::vector<edge>& pairs) const{
+        std::vector<double> res(pairs.size());
+        parallel_for(0, pairs.size(), [&](size_t i){ res[i] = query(pairs[i].first, pairs[i].second); }, 256);
+        return res;
+    }
+
+    // resistances of all edges (u, v) with u < v, in adjacency-list order
+    std::pair<std::vector<edge>, std::vector<double>> all_edges() const{
+        std::vector<edge> edges;
+        for(node_id u=0; u<g.n; ++u){
+            for(node_id v : g.get_neighbors(u)){
+                if(u < v) edges.emplace_back(u, v);
+            }
+        }
+        std::vector<double> res = query_batch(edges);
+        return std::make_pair(edges, res);
+    }
+
+private:
+    const Graph& g;
+    size_t k = 0;
+    std::vector<float> Z;    // n x k, row u is the embedding of node u
+};
+
+
+// Local estimate of R_alpha(s, t), not of R(s, t), from forward push (threshold rmax) refined with rw_num walks
+// per residual node.
+double resistance_alpha_local(const Graph& g, node_id s, node_id t, double alpha, double rmax, size_t rw_num){
+    if(g.get_degree(s) == 0 || g.get_degree(t) == 0){
+        throw std::invalid_argument("Effective resistance is undefined for isolated nodes.");
+    }
+    if(s == t) return 0.0;
+    std::vector<double> ppr_s = ppr_forarw_skelton(g, s, alpha, rmax, rw_num);
+    std::vector<double> ppr_t = ppr_forarw_skelton(g, t, alpha, rmax, rw_num);
+    double ds = g.get_degree(s), dt = g.get_degree(t);
+    return (ppr_s[s] / ds + ppr_t[t] / dt - ppr_s[t] / dt - ppr_t[s] / ds) / alpha;
+}
+
+// resistance_alpha_local for a batch of pairs, one pair per task
+std::vector<double> resistance_alpha_local_batch(const Graph& g, const std::vector<edge>& pairs, double alpha, double rmax, size_t rw_num){
+    std::vector<double> res(pairs.size());
+    parallel_for(0, pairs.size(), [&](size_t i){
+        res[i] = resistance_alpha_local(g, pairs[i].first, pairs[i].second, alpha, rmax, rw_num);
+    }, 1);
+    return res;
+}
+
+
+}
@@ -0,0 +1,482 @@
+/*
+// This header file implements a resident SSPPR query server on a Unix domain socket, its client and its protocol.
+// The server keeps one graph in memory, runs queries on an SSPPRExecutor (ssppr_executor.hpp) and keeps the PPR
+// vectors it computed in an LRU cache of bounded size, keyed by (source, alpha, method, eps, rmax, rw_num).
+// Every connection gets an I/O thread that reads its requests in order; queries of different connections run
+// concurrently on the executor threads. The threads of closed connections are joined as the next one is accepted,
+// so a long-running server holds threads only for its open connections.
+//
+// Protocol: every message is a frame of a uint32 payload length and the payload, encoded with serialize.hpp
+// (native byte order, both ends on one machine). A request is the fixed-size tuple
+//     (uint8 kind, uint8 method, uint64 source, uint64 arg, double alpha, double eps, double rmax, uint64 rw_num,
+//      double deadline_ms)
+// where method indexes server_methods and arg is k for topk and the target node for pair. A response is a uint8
+// status followed by, on success,
+//     info   : (uint64 n, uint64 m, uint64 cache hits, uint64 cache misses)
+//     ssppr  : std::vector<double> of all n values
+//     topk   : std::vector<std::pair<uint64, double>> of the k largest values, largest first
+//     pair   : double
+//     stop   : nothing; the server stops accepting and returns from run() once open connections closed
+// and on failure by the error message as std::string. Zero-valued parameters take the defaults of SSPPR().
+// "anytime" answers are not cached, since they depend on the deadline.
+*/
+
+
+# pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include "serialize.hpp"
+
+#include "uwudgraph/apps/ssppr/ssppr_executor.hpp"
+
+
+namespace uwudgraph{
+
+
+enum class RequestKind : uint8_t { info, ssppr, topk, pair, stop };
+
+const std::vector<std::string> server_methods = {"push", "rw", "fora_skeleton", "fora", "speedppr", "ppw", "auto", "anytime"};
+
+struct ServerRequest{
+    RequestKind kind = RequestKind::ssppr;
+    std::string method = "fora";
+    uint64_t source = 0;
+    uint64_t arg = 0;                       // k of topk, target node of pair
+    double alpha = 0.2;
+    double eps = 0, rmax = 0;
+    uint64_t rw_num = 0;
+    double deadline_ms = 0;                 // of "anytime", 0 for none
+};
+
+struct ServerConfig{
+    std::string socket;                     // path of the Unix domain socket
+    size_t threads = 0;                     // query threads, 0 means hardware concurrency
+    size_t max_pending = 1024;              // queued queries before connections wait
+    size_t cache_bytes = 256 << 20;         // of cached PPR vectors
+    Dangling dangling = Dangling::selfloop; // restart for directed graphs, as in SSPPR()
+};
+
+struct ServerCounters{
+    uint64_t n = 0, m = 0, hits = 0, misses = 0;
+};
+
+
+namespace __server_detail{
+
+using Frame = std::vector<uint8_t>;
+using WireRequest = std::tuple<uint8_t, uint8_t, uint64_t, uint64_t, double, double, double, uint64_t, double>;
+
+const uint32_t max_frame = 1u << 31;
+
+// false if the peer closed the socket before len bytes arrived
+inline bool read_all(int fd, void* buf, size_t len){
+    char* p = static_cast<char*>(buf);
+    while(len > 0){
+        ssize_t got = ::read(fd, p, len);
+        if(got < 0 && errno == EINTR) continue;
+        if(got <= 0) return false;
+        p += got;
+        len -= got;
+    }
+    return true;
+}
+
+inline bool write_all(int fd, const void* buf, size_t len){
+    const char* p = static_cast<const char*>(buf);
+    while(len > 0){
+        ssize_t sent = ::send(fd, p, len, MSG_NOSIGNAL);
+        if(sent < 0 && errno == EINTR) continue;
+        if(sent <= 0) return false;
+        p += sent;
+        len -= sent;
+    }
+    return true;
+}
+
+inline bool read_frame(int fd, Frame& frame, uint32_t limit = max_frame){
+    uint32_t len;
+    if(!read_all(fd, &len, sizeof(len)) || len > limit) return false;
+    frame.resize(len);
+    return read_all(fd, frame.data(), len);
+}
+
+inline bool write_frame(int fd, const Frame& frame){
+    uint32_t len = static_cast<uint32_t>(frame.size());
+    return write_all(fd, &len, sizeof(len)) && write_all(fd, frame.data(), frame.size());
+}
+
+inline Frame encode_request(const ServerRequest& req){
+    auto it = std::find(server_methods.begin(), server_methods.end(), req.method);
+    if(it == server_methods.end()){
+        throw std::invalid_argument("Method not served: " + req.method);
+    }
+    Frame frame;
+    serialize(WireRequest(static_cast<uint8_t>(req.kind), static_cast<uint8_t>(it - server_methods.begin()), req.source,
+                          req.arg, req.alpha, req.eps, req.rmax, req.rw_num, req.deadline_ms), frame);
+    return frame;
+}
+
+inline ServerRequest decode_request(const Frame& frame){
+    if(frame.size() != get_size(WireRequest())){
+        throw std::invalid_argument("Malformed request.");
+    }
+    uint8_t kind, method;
+    ServerRequest req;
+    std::tie(kind, method, req.source, req.arg, req.alpha, req.eps, req.rmax, req.rw_num, req.deadline_ms) = deserialize<WireRequest>(frame);
+    if(kind > static_cast<uint8_t>(RequestKind::stop) || method >= server_methods.size()){
+        throw std::invalid_argument("Malformed request.");
+    }
+    req.kind = static_cast<RequestKind>(kind);
+    req.method = server_methods[method];
+    return req;
+}
+
+// status byte followed by the serialized payload
+template <class T>
+Frame encode_response(const T& payload, uint8_t status = 0){
+    Frame frame(1, status);
+    serialize(payload, frame);
+    return frame;
+}
+
+inline int connect_socket(const std::string& path){
+    sockaddr_un addr;
+    if(path.size() >= sizeof(addr.sun_path)){
+        throw std::invalid_argument("Socket path too long: " + path);
+    }
+    std::memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    std::strcpy(addr.sun_path, path.c_str());
+    int fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    if(fd < 0 || ::connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0){
+        if(fd >= 0) ::close(fd);
+        throw std::runtime_error("Could not connect to socket: " + path);
+    }
+    return fd;
+}
+
+}
+
+
+// LRU cache of PPR vectors, bounded by the bytes of the vectors it holds
+class PPRCache{
+public:
+    using Key = std::tuple<uint64_t, double, std::string, double, double, uint64_t>;
+    using Value = std::shared_ptr<const std::vector<double>>;
+
+    PPRCache(size_t capacity_bytes) : capacity(capacity_bytes){}
+
+    Value get(const Key& key){
+        std::lock_guard<std::mutex> lock(mutex);
+        auto it = index.find(key);
+        if(it == index.end()){
+            ++misses;
+            return nullptr;
+        }
+        ++hits;
+        entries.splice(entries.begin(), entries, it->second);
+        return it->second->second;
+    }
+
+    void put(const Key& key, Value value){
+        size_t size = value->size() * sizeof(double);
+        if(size > capacity) return;
+        std::lock_guard<std::mutex> lock(mutex);
+        auto it = index.find(key);
+        if(it != index.end()){
+            bytes -= it->second->second->size() * sizeof(double);
+            entries.erase(it->second);
+            index.erase(it);
+        }
+        entries.emplace_front(key, std::move(value));
+        index[key] = entries.begin();
+        bytes += size;
+        while(bytes > capacity){
+            bytes -= entries.back().second->size() * sizeof(double);
+            index.erase(entries.back().first);
+            entries.pop_back();
+        }
+    }
+
+    size_t size() const{
+        std::lock_guard<std::mutex> lock(mutex);
+        return entries.size();
+    }
+
+    uint64_t get_hits() const{
+        std::lock_guard<std::mutex> lock(mutex);
+        return hits;
+    }
+
+    uint64_t get_misses() const{
+        std::lock_guard<std::mutex> lock(mutex);
+        return misses;
+    }
+
+private:
+    size_t capacity;
+    size_t bytes = 0;
+    uint64_t hits = 0, misses = 0;
+    std::list<std::pair<Key, Value>> entries;      // most recently used first
+    std::map<Key, std::list<std::pair<Key, Value>>::iterator> index;
+    mutable std::mutex mutex;
+};
+
+
+template <class G>
+class SSPPRServer{
+public:
+    SSPPRServer(const G& g, ServerConfig config) : g(g), config(config), cache(config.cache_bytes),
+                                                    executor(g, ExecutorConfig{config.threads, config.max_pending}){}
+
+    ~SSPPRServer(){
+        stop();
+    }
+
+    // Binds the socket (replacing a stale socket file) and serves until stop() or a stop request.
+    void run(){
+        sockaddr_un addr;
+        if(config.socket.size() >= sizeof(addr.sun_path)){
+            throw std::invalid_argument("Socket path too long: " + config.socket);
+        }
+        std::memset(&addr, 0, sizeof(addr));
+        addr.sun_family = AF_UNIX;
+        std::strcpy(addr.sun_path, config.socket.c_str());
+        ::unlink(config.socket.c_str());
+        int fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+        if(fd < 0 || ::bind(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0 || ::listen(fd, 128) != 0){
+            if(fd >= 0) ::close(fd);
+            throw std::runtime_error("Could not listen on socket: " + config.socket);
+        }
+        listen_fd = fd;
+        listening = true;
+        if(stopping) ::shutdown(fd, SHUT_RDWR);
+
+        std::map<uint64_t, std::thread> connections;
+        uint64_t next_id = 0;
+        while(!stopping){
+            int client = ::accept(fd, nullptr, nullptr);
+            if(client < 0){
+                if(errno == EINTR || errno == ECONNABORTED) continue;
+                break;
+            }
+            std::vector<uint64_t> done;
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                clients.insert(client);
+                done.swap(finished);
+            }
+            for(uint64_t id : done){
+                connections[id].join();
+                connections.erase(id);
+            }
+            uint64_t id = next_id++;
+            connections.emplace(id, std::thread([this, client, id]{ serve(client, id); }));
+            threads_held = connections.size();
+        }
+        {
+            // wake the connections blocked on idle clients, letting answers in flight go out
+            std::lock_guard<std::mutex> lock(mutex);
+            for(int client : clients) ::shutdown(client, SHUT_RD);
+        }
+        for(auto& connection : connections) connection.second.join();
+        finished.clear();
+        threads_held = 0;
+        ::close(fd);
+        ::unlink(config.socket.c_str());
+        listening = false;
+    }
+
+    // makes run() return; safe from any thread, including a connection
+    void stop(){
+        stopping = true;
+        if(listening) ::shutdown(listen_fd, SHUT_RDWR);
+    }
+
+    // true once run() accepts connections
+    bool ready() const{
+        return listening;
+    }
+
+    // connection threads started and not yet joined: the open connections plus those closed since the last accept
+    size_t connection_threads() const{
+        return threads_held;
+    }
+
+    ServerCounters counters() const{
+        return {g.n, g.m, cache.get_hits(), cache.get_misses()};
+    }
+
+private:
+    const G& g;
+    ServerConfig config;
+    PPRCache cache;
+    SSPPRExecutor<G> executor;
+    std::atomic<bool> stopping{false}, listening{false};
+    std::atomic<int> listen_fd{-1};
+    std::atomic<size_t> threads_held{0};
+    std::mutex mutex;
+    std::set<int> clients;
+    std::vector<uint64_t> finished;         // connections whose thread is about to return, to be joined
+
+    PPRCache::Value ppr(const ServerRequest& req){
+        bool cached = req.method != "anytime";
+        PPRCache::Key key(req.source, req.alpha, req.method, req.eps, req.rmax, req.rw_num);
+        if(cached){
+            PPRCache::Value hit = cache.get(key);
+            if(hit) return hit;
+        }
+        SSPPRQuery q;
+        q.source = req.source;
+        q.alpha = req.alpha;
+        q.method = req.method;
+        q.eps = req.eps;
+        q.rmax = req.rmax;
+        q.rw_num = req.rw_num;
+        q.dangling = config.dangling;
+        if(req.deadline_ms > 0) q.budget.seconds = req.deadline_ms / 1000;
+        PPRCache::Value value = std::make_shared<const std::vector<double>>(executor.submit(q).get().ppr);
+        if(cached) cache.put(key, value);
+        return value;
+    }
+
+    __server_detail::Frame answer(const ServerRequest& req){
+        if(req.kind == RequestKind::info){
+            ServerCounters c = counters();
+            return __server_detail::encode_response(std::make_tuple(c.n, c.m, c.hits, c.misses));
+        }
+        if(req.kind == RequestKind::stop){
+            stop();
+            return __server_detail::Frame(1, 0);
+        }
+        if(req.source >= g.n){
+            throw std::invalid_argument("Source node out of range: " + std::to_string(req.source));
+        }
+        PPRCache::Value p = ppr(req);
+        if(req.kind == RequestKind::ssppr) return __server_detail::encode_response(*p);
+        if(req.kind == RequestKind::pair){
+            if(req.arg >= g.n){
+                throw std::invalid_argument("Target node out of range: " + std::to_string(req.arg));
+            }
+            return __server_detail::encode_response((*p)[req.arg]);
+        }
+        std::vector<uint64_t> idx(p->size());
+        for(size_t i=0; i<idx.size(); ++i) idx[i] = i;
+        size_t k = std::min<size_t>(req.arg, idx.size());
+        std::partial_sort(idx.begin(), idx.begin() + k, idx.end(), [&](uint64_t a, uint64_t b){
+            return (*p)[a] > (*p)[b] || ((*p)[a] == (*p)[b] && a < b);
+        });
+        std::vector<std::pair<uint64_t, double>> top(k);
+        for(size_t i=0; i<k; ++i) top[i] = {idx[i], (*p)[idx[i]]};
+        return __server_detail::encode_response(top);
+    }
+
+    void serve(int client, uint64_t id){
+        __server_detail::Frame request;
+        while(__server_detail::read_frame(client, request, 1024)){
+            __server_detail::Frame response;
+            try{
+                response = answer(__server_detail::decode_request(request));
+            } catch(const std::exception& e){
+                response = __server_detail::encode_response(std::string(e.what()), 1);
+            }
+            if(!__server_detail::write_frame(client, response)) break;
+        }
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            clients.erase(client);
+            finished.push_back(id);
+        }
+        ::close(client);
+    }
+};
+
+
+// One connection to an SSPPRServer. Requests on it are answered in order; use one client per thread.
+class SSPPRClient{
+public:
+    SSPPRClient(const std::string& socket) : fd(__server_detail::connect_socket(socket)){}
+
+    ~SSPPRClient(){
+        ::close(fd);
+    }
+
+    SSPPRClient(const SSPPRClient&) = delete;
+    SSPPRClient& operator=(const SSPPRClient&) = delete;
+
+    ServerCounters info(){
+        ServerRequest req;
+        req.kind = RequestKind::info;
+        ServerCounters c;
+        std::tie(c.n, c.m, c.hits, c.misses) = call<std::tuple<uint64_t, uint64_t, uint64_t, uint64_t>>(req);
+        return c;
+    }
+
+    std::vector<double> ssppr(ServerRequest req){
+        req.kind = RequestKind::ssppr;
+        return call<std::vector<double>>(req);
+    }
+
+    std::vector<std::pair<uint64_t, double>> topk(ServerRequest req, uint64_t k){
+        req.kind = RequestKind::topk;
+        req.arg = k;
+        return call<std::vector<std::pair<uint64_t, double>>>(req);
+    }
+
+    double pair(ServerRequest req, uint64_t target){
+        req.kind = RequestKind::pair;
+        req.arg = target;
+        return call<double>(req);
+    }
+
+    // asks the server to shut down
+    void stop_server(){
+        ServerRequest req;
+        req.kind = RequestKind::stop;
+        exchange(req);
+    }
+
+private:
+    int fd;
+
+    __server_detail::Frame exchange(const ServerRequest& req){
+        __server_detail::Frame frame;
+        if(!__server_detail::write_frame(fd, __server_detail::encode_request(req)) || !__server_detail::read_frame(fd, frame) || frame.empty()){
+            throw std::runtime_error("Lost the connection to the SSPPR server.");
+        }
+        if(frame[0] != 0){
+            __serialize_detail::stream_cptr it = frame.begin() + 1;
+            throw std::runtime_error("SSPPR server: " + deserialize<std::string>(it, frame.end()));
+        }
+        return frame;
+    }
+
+    template <class T>
+    T call(const ServerRequest& req){
+        __server_detail::Frame frame = exchange(req);
+        __serialize_detail::stream_cptr it = frame.begin() + 1;
+        return deserialize<T>(it, frame.end());
+    }
+};
+
+
+}
@@ -0,0 +1,175 @@
+/*
+// This header file implements spectral sparsification by importance sampling of edges.
+// Each edge e is kept independently with probability p_e = min(1, c * s_e) and reweighted to w_e / p_e, so the
+// sparsifier H satisfies E[x^T L_H x] = x^T L_G x. The importance s_e is either
+//     resistance : w_e R_e, estimated with ResistanceSketch (sum over edges = n - 1 on a connected graph);
+//                  a constant-factor estimate suffices, so the sketch is built for eps = 1 with loose solves
+//                  unless sketch_dim is set
+//     degree     : 1/d_u + 1/d_v, a cheap heuristic proxy of R_e (sum over edges = n without isolated nodes); it is
+//                  no bound in either direction, e.g. a bridge between two hubs has R_e = 1 but a small proxy
+// The scale c is c = ln(n) / eps^2 for a target eps, or is found by bisection so that sum_e p_e hits an edge budget.
+// Sampling hashes the edge index with the seed, so the result is reproducible and independent of thread count.
+
+// Sources:
+//     sparsify                 : "Graph Sparsification by Effective Resistances", Spielman and Srivastava
+*/
+
+
+# pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <random>
+#include <stdexcept>
+#include <tuple>
+#include <vector>
+
+#include "multithread/parallel.hpp"
+#include "serialize.hpp"
+
+#include "uwudgraph/graph.hpp"
+#include "uwudgraph/graph_types.hpp"
+#include "uwudgraph/apps/resistance/resistance.hpp"
+
+
+namespace uwudgraph{
+
+
+using weighted_edge = std::tuple<node_id, node_id, double>;
+
+struct DistortionReport{
+    double mean = 0;    // mean of |x^T L_H x / x^T L_G x - 1|
+    double max = 0;     // max of |x^T L_H x / x^T L_G x - 1|
+    size_t trials = 0;
+};
+
+
+namespace __sparsify_detail{
+
+double expected_edges(const std::vector<double>& importance, double c){
+    return parallel_reduce(0, importance.size(), 0.0,
+                           [&](size_t e){ return std::min(1.0, c * importance[e]); }, std::plus<double>(), 4096);
+}
+
+}
+
+
+// Samples a sparsifier of g. budget > 0 overrides eps and targets that many edges in expectation.
+std::vector<weighted_edge> sparsify(const Graph& g, std::string method, double eps, size_t budget,
+                                    size_t sketch_dim = 0, uint64_t seed = 1){
+    std::vector<edge> edges;
+    for(node_id u=0; u<g.n; ++u){
+        for(node_id v : g.get_neighbors(u)){
+            if(u < v) edges.emplace_back(u, v);
+        }
+    }
+
+    std::vector<double> importance;
+    if(method == "resistance"){
+        ResistanceSketch sketch(g, 1.0, sketch_dim, "jacobi", 1e-4, static_cast<uint32_t>(seed));
+        importance = sketch.query_batch(edges);
+    } else if(method == "degree"){
+        importance.resize(edges.size());
+        parallel_for(0, edges.size(), [&](size_t e){
+            importance[e] = 1.0 / g.get_degree(edges[e].first) + 1.0 / g.get_degree(edges[e].second);
+        }, 4096);
+    } else{
+        throw std::invalid_argument("Invalid importance method specified for sparsify.");
+    }
+
+    double c;
+    if(budget > 0){
+        double lo = 0, hi = 1;
+        while(__sparsify_detail::expected_edges(importance, hi) < budget && hi < 1e300) hi *= 2;
+        for(int it=0; it<100; ++it){
+            double mid = 0.5 * (lo + hi);
+            if(__sparsify_detail::expected_edges(importance, mid) < budget) lo = mid;
+            else hi = mid;
+        }
+        c = hi;
+    } else{
+        c = std::log(std::max<node_id>(g.n, 2)) / (eps * eps);
+    }
+
+    std::vector<double> weight(edges.size(), 0.0);
+    parallel_for(0, edges.size(), [&](size_t e){
+        double p = std::min(1.0, c * importance[e]);
+        double u = 0x1.0p-53 * (splitmix64(seed ^ (e * 0xD1B54A32D192ED03ull)) >> 11);
+        if(u < p) weight[e] = 1.0 / p;
+    }, 4096);
+
+    std::vector<weighted_edge> sparse;
+    for(size_t e=0; e<edges.size(); ++e){
+        if(weight[e] > 0) sparse.emplace_back(edges[e].first, edges[e].second, weight[e]);
+    }
+    return sparse;
+}
+
+
+// Compares x^T L_H x with x^T L_G x on random test vectors: white noise and noise smoothed by
+// a few random-walk steps, which probes the low end of the spectrum as well.
+DistortionReport quadratic_form_distortion(const Graph& g, const std::vector<weighted_edge>& sparse, size_t trials,
+                                           uint32_t seed = 1){
+    DistortionReport report;
+    std::mt19937 gen(seed);
+    std::normal_distribution<double> normal;
+    std::vector<double> x(g.n), y(g.n);
+    for(size_t trial=0; trial<trials; ++trial){
+        for(double& xi : x) xi = normal(gen);
+        size_t smooth_steps = (trial % 3) * 4;
+        for(size_t step=0; step<smooth_steps; ++step){
+            parallel_for(0, g.n, [&](size_t u){
+                double acc = x[u];
+                for(node_id v : g.get_neighbors(u)) acc += x[v];
+                y[u] = acc / (g.get_degree(u) + 1);
+            });
+            x.swap(y);
+        }
+
+        double qg = parallel_reduce(0, g.n, 0.0, [&](size_t u){
+            double acc = 0;
+            for(node_id v : g.get_neighbors(u)) acc += (x[u] - x[v]) * (x[u] - x[v]);
+            return acc;
+        }, std::plus<double>()) / 2;
+        double qh = parallel_reduce(0, sparse.size(), 0.0, [&](size_t e){
+            auto [u, v, w] = sparse[e];
+            return w * (x[u] - x[v]) * (x[u] - x[v]);
+        }, std::plus<double>(), 4096);
+        if(qg == 0) continue;
+
+        double dist = std::abs(qh / qg - 1.0);
+        report.mean += dist;
+        report.max = std::max(report.max, dist);
+        ++report.trials;
+    }
+    if(report.trials) report.mean /= report.trials;
+    return report;
+}
+
+
+
+// Writes the sparsifier as "u v w" lines plus a .meta file ("text"), or as a serialized (n, edges) pair ("bin").
+void save_sparsifier(std::string filename, node_id n, const std::vector<weighted_edge>& sparse, std::string format){
+    if(format == "bin"){
+        if(!save_file(filename, std::make_pair(n, sparse))){
+            throw std::runtime_error("Could not write to file: " + filename);
+        }
+        return;
+    }
+    if(format != "text"){
+        throw std::invalid_argument("Invalid output format specified for sparsifier: " + format);
+    }
+    std::ofstream os(filename);
+    if(!os.is_open()){
+        throw std::runtime_error("Could not write to file: " + filename);
+    }
+    os.precision(17);
+    for(const auto& [u, v, w] : sparse) os << u << "\t" << v << "\t" << w << "\n";
+    os.close();
+    std::ofstream meta(filename + ".meta");
+    meta << n << " " << sparse.size() << std::endl;
+}
+
+
+}
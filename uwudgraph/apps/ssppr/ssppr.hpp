@@ -10,40 +10,154 @@
 #include "uwudgraph/graphio.hpp"
 
 #include "ssppr_custom.hpp"
+#include "ssppr_auto.hpp"
+#include "ssppr_anytime.hpp"
+#include "ssppr_multi.hpp"
+#include "ssppr_seeds.hpp"
 
 
 namespace uwudgraph{
 
 
-std::vector<double> SSPPR(std::string filename, std::string source_str, double alpha, std::string method, double eps, double delta, double pf, double rmax, size_t rw_num, size_t pi_num, size_t sample_size, size_t batch_size){
-    Graph* g = load_edgelist(filename);
-    node_id source = static_cast<node_id>(std::stoul(source_str));
-
+// SSPPR on an in-memory graph of any type supported by the kernels in ssppr_custom.hpp.
+// Zero-valued parameters take the defaults below. dangling only matters for nodes without out-edges.
+// stats receives the counters of the query if built with SSPPR_STATS, see ssppr_stats.hpp.
+// "auto" answers with fora or speedppr and tunes rmax to the graph across calls, see ssppr_auto.hpp.
+// "anytime" stops at the budget of anytime (none if nullptr) and reports its error bound there, see ssppr_anytime.hpp.
+// push, rw, fora_skeleton, fora and speedppr with the suffix "_f32" (e.g. "fora_f32") keep ppr and r as float.
+// workspace, if given, is reused for the residual and queue of push, fora_skeleton and fora, see PushWorkspace.
+template <class G>
+std::vector<double> SSPPR(const G& g, node_id source, double alpha, std::string method, double eps, double delta, double pf, double rmax, size_t rw_num, size_t pi_num, size_t sample_size, size_t batch_size, Dangling dangling = Dangling::selfloop, SSPPRStats* stats = nullptr, AnytimeControl* anytime = nullptr,
+                         PushWorkspace<double>* workspace = nullptr){
+    if(source >= g.n){
+        throw std::invalid_argument("Source node out of range: " + std::to_string(source));
+    }
     if(eps == 0) eps = 0.1;
-    if(delta == 0) delta = 1.0/g->n;
-    if(pf == 0) pf = 1.0/g->n;
+    if(delta == 0) delta = 1.0/g.n;
+    if(pf == 0) pf = 1.0/g.n;
     if(rmax == 0) rmax = 1e-4;
     if(rw_num == 0) rw_num = 1000;
     if(pi_num == 0) pi_num = 10;
     if(sample_size == 0) sample_size = 100;
     if(batch_size == 0) batch_size = 10; 
 
-
+    __ssppr_detail::stats() = SSPPRStats();
+    TRACE_SCOPE("SSPPR", "ssppr");
+    std::vector<double> ppr;
     if(method == "push" or method == "forwardpush"){
-        return ppr_forwardpush(*g,source,alpha,rmax).first;
+        if(workspace != nullptr) ppr = __ssppr_detail::forwardpush_in(g, source, alpha, rmax, dangling, *workspace, nullptr);
+        else ppr = ppr_forwardpush(g,source,alpha,rmax,dangling).first;
     } else if(method == "rw"){
-        return ppr_rw(*g, source, alpha, rw_num);
+        ppr = ppr_rw(g, source, alpha, rw_num, dangling);
     } else if(method == "fora_skeleton"){
-        return ppr_forarw_skelton(*g, source, alpha, rmax, rw_num);
+        ppr = ppr_forarw_skelton(g, source, alpha, rmax, rw_num, dangling, workspace);
     } else if(method == "fora"){
-        return ppr_fora(*g, source, alpha, eps, delta, pf);
+        ppr = ppr_fora(g, source, alpha, eps, delta, pf, dangling, workspace);
     } else if(method == "speedppr"){
-        return ppr_speedppr(*g, source, alpha, eps, delta, pf);
+        ppr = ppr_speedppr(g, source, alpha, eps, delta, pf, dangling);
     } else if(method == "ppw"){
-        return ppr_ppw(*g, source, alpha, pi_num, sample_size, batch_size);
+        ppr = ppr_ppw(g, source, alpha, pi_num, sample_size, batch_size, dangling);
+    } else if(method == "auto"){
+        ppr = __ssppr_detail::auto_tuner(g, alpha, eps, delta, pf, dangling).query(source);
+    } else if(method == "anytime"){
+        AnytimeResult res = ppr_anytime(g, source, alpha, eps, delta, pf, anytime != nullptr ? anytime->budget : SSPPRBudget(), dangling);
+        ppr = std::move(res.ppr);
+        if(anytime != nullptr) anytime->result = std::move(res);
+    } else if(method == "push_f32" or method == "forwardpush_f32"){
+        std::vector<float> est = ppr_forwardpush<float>(g, source, alpha, rmax, dangling).first;
+        ppr.assign(est.begin(), est.end());
+    } else if(method == "rw_f32"){
+        std::vector<float> est = ppr_rw<float>(g, source, alpha, rw_num, dangling);
+        ppr.assign(est.begin(), est.end());
+    } else if(method == "fora_skeleton_f32"){
+        std::vector<float> est = ppr_forarw_skelton<float>(g, source, alpha, rmax, rw_num, dangling);
+        ppr.assign(est.begin(), est.end());
+    } else if(method == "fora_f32"){
+        std::vector<float> est = ppr_fora<float>(g, source, alpha, eps, delta, pf, dangling);
+        ppr.assign(est.begin(), est.end());
+    } else if(method == "speedppr_f32"){
+        std::vector<float> est = ppr_speedppr<float>(g, source, alpha, eps, delta, pf, dangling);
+        ppr.assign(est.begin(), est.end());
     } else{
         throw std::invalid_argument("Invalid method specified for SSPPR.");
     }
+    if(stats != nullptr) *stats = __ssppr_detail::stats();
+    return ppr;
+}
+
+// PPR personalized over a seed set, see ssppr_seeds.hpp. push, rw, fora_skeleton and fora start from all seeds at once.
+// The other methods sum one query per seed, which is the same PPR unless dangling is restart, where they are refused.
+template <class G>
+std::vector<double> SSPPR(const G& g, const SeedSet& seeds, double alpha, std::string method, double eps, double delta, double pf, double rmax, size_t rw_num, size_t pi_num, size_t sample_size, size_t batch_size, Dangling dangling = Dangling::selfloop, SSPPRStats* stats = nullptr){
+    seeds.check(g);
+    if(seeds.nodes.size() == 1){
+        return SSPPR(g, seeds.nodes[0], alpha, method, eps, delta, pf, rmax, rw_num, pi_num, sample_size, batch_size, dangling, stats);
+    }
+    if(eps == 0) eps = 0.1;
+    if(delta == 0) delta = 1.0/g.n;
+    if(pf == 0) pf = 1.0/g.n;
+    if(rmax == 0) rmax = 1e-4;
+    if(rw_num == 0) rw_num = 1000;
+
+    __ssppr_detail::stats() = SSPPRStats();
+    TRACE_SCOPE("SSPPR", "ssppr");
+    std::vector<double> ppr;
+    if(method == "push" or method == "forwardpush"){
+        ppr = ppr_forwardpush(g, seeds, alpha, rmax, dangling).first;
+    } else if(method == "rw"){
+        ppr = ppr_rw(g, seeds, alpha, rw_num, dangling);
+    } else if(method == "fora_skeleton"){
+        ppr = ppr_forarw_skelton(g, seeds, alpha, rmax, rw_num, dangling);
+    } else if(method == "fora"){
+        ppr = ppr_fora(g, seeds, alpha, eps, delta, pf, dangling);
+    } else if(dangling == Dangling::restart){
+        throw std::invalid_argument("Method " + method + " does not support seed sets with restart on dangling nodes.");
+    } else{
+        SSPPRStats total, one;
+        ppr.assign(g.n, 0.0);
+        for(size_t i=0; i<seeds.nodes.size(); ++i){
+            std::vector<double> single = SSPPR(g, seeds.nodes[i], alpha, method, eps, delta, pf, rmax, rw_num, pi_num, sample_size, batch_size, dangling, &one);
+            for(node_id v=0; v<g.n; ++v) ppr[v] += seeds.weights[i] * single[v];
+            total += one;
+        }
+        if(stats != nullptr) *stats = total;
+        return ppr;
+    }
+    if(stats != nullptr) *stats = __ssppr_detail::stats();
+    return ppr;
+}
+
+// SSPPR of one source for several alphas, result[i] for alphas[i]. push, rw, fora_skeleton and fora share one
+// traversal across the alphas (see ssppr_multi.hpp), the other methods run once per alpha.
+template <class G>
+std::vector<std::vector<double>> SSPPR(const G& g, node_id source, const std::vector<double>& alphas, std::string method, double eps, double delta, double pf, double rmax, size_t rw_num, size_t pi_num, size_t sample_size, size_t batch_size, Dangling dangling = Dangling::selfloop, SSPPRStats* stats = nullptr){
+    if(method == "forwardpush" or method == "push" or method == "rw" or method == "fora_skeleton" or method == "fora"){
+        __ssppr_detail::stats() = SSPPRStats();
+        TRACE_SCOPE("SSPPR", "ssppr");
+        std::vector<std::vector<double>> ppr = ppr_multi_alpha(g, source, alphas, method, eps, delta, pf, rmax, rw_num, dangling);
+        if(stats != nullptr) *stats = __ssppr_detail::stats();
+        return ppr;
+    }
+    std::vector<std::vector<double>> ppr;
+    SSPPRStats total, one;
+    for(double alpha : alphas){
+        ppr.push_back(SSPPR(g, source, alpha, method, eps, delta, pf, rmax, rw_num, pi_num, sample_size, batch_size, dangling, &one));
+        total += one;
+    }
+    if(stats != nullptr) *stats = total;
+    return ppr;
+}
+
+std::vector<double> SSPPR(std::string filename, std::string source_str, double alpha, std::string method, double eps, double delta, double pf, double rmax, size_t rw_num, size_t pi_num, size_t sample_size, size_t batch_size, std::string dangling = "selfloop", SSPPRStats* stats = nullptr, AnytimeControl* anytime = nullptr){
+    Graph* g;
+    {
+        TRACE_SCOPE("load", "io");
+        g = load_graph(filename);
+    }
+    node_id source = static_cast<node_id>(std::stoul(source_str));
+    std::vector<double> ppr = SSPPR(*g, source, alpha, method, eps, delta, pf, rmax, rw_num, pi_num, sample_size, batch_size, parse_dangling(dangling), stats, anytime);
+    delete g;
+    return ppr;
 }
 
 };
\ No newline at end of file
@@ -0,0 +1,156 @@
+/*
+// This header file implements anytime SSPPR: a query under a wall-time or work budget that can be cancelled from
+// another thread and, whenever it stops, returns its best estimate so far together with an error bound.
+// It refines one forward-push state (ppr, r), for which pi = ppr + sum_u r[u] * pi_u holds at every point, in rounds:
+//     push : forward push down to rmax, which starts at 0.1 and shrinks 4x per round
+//     walk : walks from the residual, drawn by a ResidualSampler (ssppr_custom.hpp), until the walk work of the round
+//            matches its push work
+// Since the sampler's walks carry FORA's guarantee for any count W, every prefix of a round is an estimate within the
+// eps' at which W = |r| * fora_walks_per_residual(eps', delta, pf):
+//     |estimate(v) - pi(v)| <= eps' * pi(v)   for pi(v) >= delta, with probability at least 1 - pf,
+// and without walks push alone gives eps' = |r| / delta. The query answers with the estimate of smallest eps' seen and
+// stops as converged once eps' <= eps, otherwise at the deadline, at the work budget (edges scanned by push plus walk
+// steps) or when the cancel flag is set. Budgets are polled every 256 pushes and every 64 walks.
+*/
+
+
+# pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <vector>
+
+#include "benchmark.hpp"
+#include "random.hpp"
+#include "uniqueue.hpp"
+
+#include "ssppr_custom.hpp"
+
+
+namespace uwudgraph{
+
+
+struct SSPPRBudget{
+    double seconds = std::numeric_limits<double>::infinity();   // wall time from the start of the query
+    size_t work = std::numeric_limits<size_t>::max();           // edges scanned by push plus walk steps
+    const std::atomic<bool>* cancel = nullptr;                   // stops the query once set, from any thread
+};
+
+enum class AnytimeStop { converged, deadline, work, cancelled };
+
+std::string anytime_stop_name(AnytimeStop stop){
+    if(stop == AnytimeStop::converged) return "converged";
+    if(stop == AnytimeStop::deadline) return "deadline";
+    if(stop == AnytimeStop::work) return "work";
+    return "cancelled";
+}
+
+struct AnytimeResult{
+    std::vector<double> ppr;
+    double error_bound = 0;         // relative error of ppr[v] for pi(v) >= delta, with probability at least 1 - pf
+    double residual = 0;            // |r| behind ppr, the L1 error of its push part
+    size_t walks = 0;               // behind ppr
+    size_t rounds = 0;              // push rounds started
+    size_t work = 0;                // edges scanned plus walk steps, over the whole query
+    double seconds = 0;
+    AnytimeStop stop = AnytimeStop::converged;
+};
+
+// budget and outcome of an "anytime" query through SSPPR(), whose result comes without ppr
+struct AnytimeControl{
+    SSPPRBudget budget;
+    AnytimeResult result;
+};
+
+
+template <class G>
+AnytimeResult ppr_anytime(const G& g, node_id source, double alpha, double eps, double delta, double pf,
+                          const SSPPRBudget& budget = SSPPRBudget(), Dangling dangling = Dangling::selfloop){
+    auto start = std::chrono::steady_clock::now();
+    CountingGraph<G> counted(g);
+    AnytimeResult res;
+
+    // polled between pushes and walks; records why the query stops
+    bool stopped = false;
+    auto exhausted = [&](){
+        if(budget.cancel != nullptr && budget.cancel->load(std::memory_order_relaxed)) res.stop = AnytimeStop::cancelled;
+        else if(counted.edges + counted.steps >= budget.work) res.stop = AnytimeStop::work;
+        else if(std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count() >= budget.seconds) res.stop = AnytimeStop::deadline;
+        else return false;
+        stopped = true;
+        return true;
+    };
+
+    SSPPR_STAT_ADD(alloc_bytes, g.n * (3 * sizeof(double)) + g.n / 8);
+    std::vector<double> ppr(g.n, 0.0), r(g.n, 0.0);
+    r[source] = 1.0;
+    uniqueue<node_id> queue(g.n);
+    queue.push(source);
+
+    std::vector<double> best;
+    double best_bound = std::numeric_limits<double>::infinity();
+    double best_residual = 0;
+    size_t best_walks = 0;
+
+    __ssppr_detail::ResidualSampler sampler;
+    std::vector<node_id> ends;
+    // eps' of the round so far
+    auto bound = [&](){ return sampler.error_bound(ends.size(), delta, pf); };
+    // keeps ppr plus the walk estimate of the round if its bound beats the best so far
+    auto snapshot = [&](){
+        double b = bound();
+        if(b >= best_bound) return;
+        best = ppr;
+        for(node_id v : ends) best[v] += sampler.residual() / ends.size();
+        best_bound = b;
+        best_residual = sampler.residual();
+        best_walks = ends.size();
+    };
+
+    double rmax = 0.1;
+    while(!stopped){
+        ++res.rounds;
+        size_t work_before = counted.edges + counted.steps;
+        forwardpush_resume(counted, source, alpha, rmax, ppr, r, queue, dangling, exhausted);
+        size_t push_work = counted.edges + counted.steps - work_before;
+        rmax /= 4;
+
+        ends.clear();
+        sampler.reset(r);
+        for(node_id u : sampler.support()){
+            // seeds the push of the next round, same threshold as forwardpush_resume
+            double d = g.get_neighbor_count(u) == 0 ? 1.0 : g.get_degree(u);
+            if(r[u] > d * rmax) queue.push(u);
+        }
+        if(stopped || bound() <= eps){
+            snapshot();
+            break;
+        }
+
+        SSPPR_PHASE(walk);
+        size_t walk_before = counted.steps;
+        while(counted.steps - walk_before < push_work || ends.size() < 64){
+            if((ends.size() & 63) == 0 && exhausted()) break;
+            ends.push_back(sampler.walk(counted, alpha, source, dangling));
+            if((ends.size() & 63) == 0 && bound() <= eps) break;
+        }
+        snapshot();
+        if(best_bound <= eps) break;
+    }
+    if(best_bound <= eps) res.stop = AnytimeStop::converged;
+
+    res.ppr = std::move(best);
+    res.error_bound = best_bound;
+    res.residual = best_residual;
+    res.walks = best_walks;
+    res.work = counted.edges + counted.steps;
+    res.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return res;
+}
+
+
+}
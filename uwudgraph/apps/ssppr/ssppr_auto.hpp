@@ -0,0 +1,151 @@
+/*
+// This header file implements the "auto" SSPPR method, which picks the method and rmax for the graph and machine.
+// For a requested (eps, delta, pf) FORA needs w walks per unit of residual whatever rmax is, so rmax only trades
+// push work for walks. With c_e the time per edge scanned by push and c_w the time per walk,
+//     T(rmax) ~ c_e / (alpha * rmax) + c_w * m * w * rmax,   minimized at rmax = sqrt(c_e / (alpha * c_w * m * w)),
+// which is the rmax of ppr_fora when c_w = c_e / alpha. A short probe measures c_e and c_w: pushes and walks from a
+// few sampled nodes, timed on a CountingGraph. Across a batch of queries AutoSSPPR then adapts online:
+//     rmax   : both cost terms are equal at the optimum, so after every FORA query rmax is scaled by
+//              (push time / walk time)^(step / 2), clamped to [1e-12, 1]
+//     method : FORA and SpeedPPR (same guarantee) keep a moving average of their latency; the faster one serves the
+//              queries and the other one is retried every explore_every queries
+// The bounds behind the model are worst case, which is why the measured phase times steer rmax after the probe.
+*/
+
+
+# pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "benchmark.hpp"
+
+#include "ssppr_custom.hpp"
+
+
+namespace uwudgraph{
+
+
+template <class G>
+class AutoSSPPR{
+public:
+    size_t explore_every = 16;      // queries between two runs of the slower method
+    double step = 0.5;              // fraction of the measured rmax correction applied per query
+    double smoothing = 0.3;         // weight of the newest latency in the moving averages
+
+    AutoSSPPR(const G& g, double alpha, double eps, double delta, double pf, Dangling dangling = Dangling::selfloop, uint32_t seed = 1)
+        : g(g), alpha(alpha), eps(eps), delta(delta), pf(pf), dangling(dangling){
+        w = __ssppr_detail::fora_walks_per_residual(eps, delta, pf);
+        probe(seed);
+    }
+
+    std::vector<double> query(node_id source){
+        ++queries;
+        bool fora;
+        if(queries == 1) fora = true;
+        else if(queries == 2) fora = false;
+        else{
+            fora = latency[0] <= latency[1];
+            if(queries % explore_every == 0) fora = !fora;
+        }
+
+        std::vector<double> ppr;
+        auto start = std::chrono::steady_clock::now();
+        if(fora){
+            method = "fora";
+            double jump = 0;
+            auto [p, r] = ppr_forwardpush(g, source, alpha, rmax, dangling, &jump);
+            auto pushed = std::chrono::steady_clock::now();
+            __ssppr_detail::walk_residuals(g, p, r, w, alpha, source, dangling, jump);
+            ppr = std::move(p);
+            auto end = std::chrono::steady_clock::now();
+            double push_time = std::chrono::duration<double>(pushed - start).count();
+            double walk_time = std::chrono::duration<double>(end - pushed).count();
+            double ratio = std::clamp((push_time + 1e-9) / (walk_time + 1e-9), 1.0 / 16, 16.0);
+            rmax = std::clamp(rmax * std::pow(ratio, step / 2), 1e-12, 1.0);
+        } else{
+            method = "speedppr";
+            ppr = ppr_speedppr(g, source, alpha, eps, delta, pf, dangling);
+        }
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        double& avg = latency[fora ? 0 : 1];
+        avg = avg < 0 ? seconds : (1 - smoothing) * avg + smoothing * seconds;
+        return ppr;
+    }
+
+    // true if the tuner was built for this graph and query parameters
+    bool matches(const G& other, double a, double e, double d, double p, Dangling dl) const{
+        return &other == &g && other.n == g.n && other.m == m && a == alpha && e == eps && d == delta && p == pf && dl == dangling;
+    }
+
+    double get_rmax() const{ return rmax; }
+    std::string get_method() const{ return method; }       // method of the last query
+    double get_edge_cost() const{ return edge_cost; }       // seconds per edge scanned by push
+    double get_walk_cost() const{ return walk_cost; }       // seconds per walk
+    size_t get_queries() const{ return queries; }
+
+private:
+    const G& g;
+    size_t m = g.m;
+    double alpha, eps, delta, pf;
+    Dangling dangling;
+    double w;
+    double rmax = 1;
+    double edge_cost = 0, walk_cost = 0;
+    double latency[2] = {-1, -1};       // moving averages of fora and speedppr, -1 before the first run
+    size_t queries = 0;
+    std::string method;
+
+    void probe(uint32_t seed){
+        std::mt19937 gen(seed);
+        std::uniform_int_distribution<uint64_t> dist(0, g.n - 1);
+        std::vector<node_id> sources;
+        for(size_t tries=0; sources.size() < 3 && tries < 300; ++tries){
+            node_id s = dist(gen);
+            if(g.get_neighbor_count(s) > 0) sources.push_back(s);
+        }
+        if(sources.empty()) sources.push_back(0);
+
+        // at most about a million edge scans per push, whatever eps asks for
+        double total = g.get_total_weight();
+        double rmax_probe = std::max(std::sqrt(1.0 / (total * w)), 1.0 / (alpha * 1e6));
+        CountingGraph<G> counted(g);
+        auto start = std::chrono::steady_clock::now();
+        for(node_id s : sources) ppr_forwardpush(counted, s, alpha, rmax_probe, dangling);
+        double push_time = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        edge_cost = (push_time + 1e-9) / std::max<size_t>(counted.edges, 1);
+
+        size_t walks = 0;
+        start = std::chrono::steady_clock::now();
+        for(node_id s : sources){
+            for(size_t i=0; i<1000; ++i, ++walks) random_walk(g, s, alpha, s, dangling);
+        }
+        double walk_time = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        walk_cost = (walk_time + 1e-9) / walks;
+
+        rmax = std::clamp(std::sqrt(edge_cost / (alpha * walk_cost * total * w)), 1e-12, 1.0);
+    }
+};
+
+
+namespace __ssppr_detail{
+
+// tuner of the last "auto" query on this thread, reused while the graph and the parameters stay the same
+template <class G>
+AutoSSPPR<G>& auto_tuner(const G& g, double alpha, double eps, double delta, double pf, Dangling dangling){
+    thread_local std::unique_ptr<AutoSSPPR<G>> tuner;
+    if(!tuner || !tuner->matches(g, alpha, eps, delta, pf, dangling)){
+        tuner.reset(new AutoSSPPR<G>(g, alpha, eps, delta, pf, dangling));
+    }
+    return *tuner;
+}
+
+}
+
+
+}
@@ -3,6 +3,25 @@
 // The algorithms include random walk-based methods, forward push, power push, and hybrid approaches.
 // Each method has its own trade-offs in terms of accuracy, efficiency, and memory usage.
 // The namespace `uwudgraph` encapsulates all the functions to avoid naming conflicts.
+// Every function is a template over the graph type G, which must provide n, get_degree(u) (weighted degree),
+// get_neighbor_count(u), for_each_neighbor(u, f(v, w)), get_total_weight() and rand_neighbor(u).
+// On weighted graphs the push splits the residual of u in proportion to w(u, v) / d(u) and walks
+// move along an edge with probability proportional to its weight.
+// Nodes without out-edges (sinks of directed graphs, isolated nodes) follow a Dangling policy:
+//     restart  : the walk jumps back to the source.
+//     uniform  : the walk jumps to a uniformly random node. Push accumulates this mass and spreads it
+//                over all nodes only once it exceeds n * rmax, so the O(n) spread stays amortized. FORA and
+//                SpeedPPR keep the mass left when the push ends apart and refine it with one batch of walks
+//                from uniformly sampled nodes, instead of at least one walk from each of the n nodes.
+//     selfloop : the walk stays at the node until it terminates, i.e. the node keeps all its residual.
+// The push and walk kernels (rw, forwardpush, powerpush, fora_skeleton, fora, speedppr) are also templates over the
+// value type T of ppr and r, double by default: ppr_fora<float>(g, ...) stores both as float, which halves the
+// memory traffic of the push and scan loops, while every update is computed in double and rounded once when
+// stored. Walk ends are summed in double per batch before they reach a float estimate, see add_walk_ends.
+// The kernels size ppr and r with assign_workspace (memory.hpp), so on large graphs they are faulted in huge pages
+// on the querying thread's NUMA node. forwardpush, fora_skeleton and fora can also take a PushWorkspace, the residual
+// and queue of one thread kept across its queries, so a query allocates and faults in only its answer. Index builds,
+// which push from many sources and keep only the entries each push set, use a SparsePushWorkspace per thread.
 
 // Sources:
 //     forwardpush, fora        : "FORA: Simple and Effective Approximate Single-Source Personalized PageRank",
@@ -19,188 +38,664 @@
 #include <unordered_map>
 #include <algorithm>
 #include <cmath>
+#include <memory>
+#include <numeric>
+#include <stdexcept>
+#include <type_traits>
 
+#include "memory.hpp"
 #include "uniqueue.hpp"
 #include "random.hpp"
 
 
 #include "uwudgraph/graph.hpp"
 #include "uwudgraph/graph_types.hpp"
+#include "ssppr_stats.hpp"
 
 
 namespace uwudgraph{
 
 
-node_id random_walk(const Graph& g, node_id v, double alpha) {
+enum class Dangling { restart, uniform, selfloop };
+
+Dangling parse_dangling(std::string name){
+    if(name == "restart") return Dangling::restart;
+    if(name == "uniform") return Dangling::uniform;
+    if(name == "selfloop") return Dangling::selfloop;
+    throw std::invalid_argument("Invalid dangling policy: " + name);
+}
+
+// Personalization over a set of seed nodes: the query starts from seed nodes[i] with probability weights[i], and
+// walks and pushed mass jump back to this distribution under Dangling::restart. Weights default to uniform and are
+// normalized; a seed may appear more than once.
+struct SeedSet{
+    std::vector<node_id> nodes;
+    std::vector<double> weights;
+
+    SeedSet(std::vector<node_id> seed_nodes, std::vector<double> seed_weights = {})
+        : nodes(std::move(seed_nodes)), weights(std::move(seed_weights)){
+        if(nodes.empty()){
+            throw std::invalid_argument("Seed set is empty.");
+        }
+        if(weights.empty()) weights.assign(nodes.size(), 1.0);
+        if(weights.size() != nodes.size()){
+            throw std::invalid_argument("Seed set needs one weight per node.");
+        }
+        double sum = 0;
+        for(double w : weights){
+            if(!(w >= 0)) throw std::invalid_argument("Seed weights must not be negative.");
+            sum += w;
+        }
+        if(!(sum > 0)) throw std::invalid_argument("Seed weights sum to zero.");
+        for(double& w : weights) w /= sum;
+        sampler = std::make_shared<AliasSampler>(weights);
+    }
+
+    node_id sample() const{
+        return nodes[sampler->sample()];
+    }
+
+    template <class G>
+    void check(const G& g) const{
+        for(node_id u : nodes){
+            if(u >= g.n) throw std::invalid_argument("Seed node out of range: " + std::to_string(u));
+        }
+    }
+
+private:
+    std::shared_ptr<const AliasSampler> sampler;
+};
+
+
+namespace __ssppr_detail{
+
+// restart() gives the node a walk jumps to from a dangling node under Dangling::restart
+template <class G, class Restart>
+node_id random_walk(const G& g, node_id v, double alpha, Dangling dangling, Restart&& restart) {
+    SSPPR_STAT_ADD(walks, 1);
     while (true) {
         if (rand_uniformf() < alpha) return v;
-        v = g.rand_neighbor(v);
+        SSPPR_STAT_ADD(walk_steps, 1);
+        if (g.get_neighbor_count(v) == 0) {
+            if (dangling == Dangling::selfloop) return v;
+            v = dangling == Dangling::restart ? restart() : rand_uniform(g.n);
+        } else {
+            v = g.rand_neighbor(v);
+        }
     };
 }
 
-std::vector<double> ppr_rw(const Graph& g, node_id source, double alpha, size_t rw_num){
-    std::vector<double> ppr(g.n, 0.0);
+// Walk ends buffered before add_walk_ends adds them to the estimate.
+const size_t walk_batch = 1 << 16;
+
+// Adds share to ppr[v] for every walk end v in ends, then clears ends. With float storage the shares of equal
+// ends are first summed in double, so a node takes one rounding per batch of walks instead of one per walk.
+template <class T>
+void add_walk_ends(std::vector<T>& ppr, std::vector<node_id>& ends, double share){
+    if constexpr(std::is_same<T, double>::value){
+        for(node_id v : ends) ppr[v] += share;
+    } else{
+        std::sort(ends.begin(), ends.end());
+        for(size_t i=0, j=0; i<ends.size(); i=j){
+            while(j < ends.size() && ends[j] == ends[i]) ++j;
+            ppr[ends[i]] += (j - i) * share;
+        }
+    }
+    ends.clear();
+}
+
+}
+
+
+template <class G>
+node_id random_walk(const G& g, node_id v, double alpha, node_id source, Dangling dangling) {
+    return __ssppr_detail::random_walk(g, v, alpha, dangling, [source] { return source; });
+}
+
+template <class G>
+node_id random_walk(const G& g, node_id v, double alpha, const SeedSet& seeds, Dangling dangling) {
+    return __ssppr_detail::random_walk(g, v, alpha, dangling, [&seeds] { return seeds.sample(); });
+}
+
+template <class G>
+node_id random_walk(const G& g, node_id v, double alpha) {
+    return random_walk(g, v, alpha, v, Dangling::selfloop);
+}
+
+template <class T = double, class G>
+std::vector<T> ppr_rw(const G& g, node_id source, double alpha, size_t rw_num, Dangling dangling = Dangling::selfloop){
+    SSPPR_PHASE(walk);
+    SSPPR_STAT_ADD(alloc_bytes, g.n * sizeof(T));
+    std::vector<T> ppr;
+    assign_workspace(ppr, g.n, T(0));
+    std::vector<node_id> ends;
     for(size_t _=0; _<rw_num; ++_){
-        ppr[random_walk(g,source,alpha)] += 1.0 / rw_num;
+        ends.push_back(random_walk(g,source,alpha,source,dangling));
+        if(ends.size() == __ssppr_detail::walk_batch) __ssppr_detail::add_walk_ends(ppr, ends, 1.0 / rw_num);
     }
+    __ssppr_detail::add_walk_ends(ppr, ends, 1.0 / rw_num);
     return ppr;
 }
 
 
-std::pair<std::vector<double>, std::vector<double>> ppr_forwardpush(const Graph& g, node_id source, double alpha, double rmax){
-    std::vector<double> ppr(g.n, 0.0);
-    std::vector<double> r(g.n, 0.0);
-    r[source] = 1.0;
-    uniqueue<node_id> queue(g.n);
-    queue.push(source);
+namespace __ssppr_detail{
 
-    while(!queue.empty()){
-        node_id u = queue.pop();
-        ppr[u] += alpha * r[u];
-        double ruv = r[u] * (1.0 - alpha) / g.get_degree(u);
-        for(node_id v : g.get_neighbors(u)){
-            r[v] += ruv;
-            if(r[v] > g.get_degree(v) * rmax){
-                queue.push(v);
+// Default touch callback of forwardpush_resume.
+struct no_touch{
+    void operator()(node_id) const {}
+};
+
+// Moves the non-terminating share rest = (1 - alpha) * r[u] of a dangling node u.
+// Mass for the uniform policy is parked in jump; on_push(v) is called for nodes whose residual grew.
+template <class T, class OnPush>
+void push_dangling(node_id u, double rest, node_id source, Dangling dangling,
+                   std::vector<T>& ppr, std::vector<T>& r, double& jump, OnPush&& on_push){
+    if(dangling == Dangling::selfloop){
+        ppr[u] += rest;
+    } else if(dangling == Dangling::restart){
+        r[source] += rest;
+        on_push(source);
+    } else{
+        jump += rest;
+    }
+}
+
+// Adds jump / n to every residual, calling on_push(v) for every node.
+template <class G, class T, class OnPush>
+void spread_jump(const G& g, std::vector<T>& r, double& jump, OnPush&& on_push){
+    double share = jump / g.n;
+    jump = 0;
+    for(node_id v=0; v<g.n; ++v){
+        r[v] += share;
+        on_push(v);
+    }
+}
+
+// Adds jump * weights[i] to the residual of every seed, calling on_push for each.
+template <class T, class OnPush>
+void spread_jump(const SeedSet& seeds, std::vector<T>& r, double& jump, OnPush&& on_push){
+    double total = jump;
+    jump = 0;
+    for(size_t i=0; i<seeds.nodes.size(); ++i){
+        r[seeds.nodes[i]] += total * seeds.weights[i];
+        on_push(seeds.nodes[i]);
+    }
+}
+
+// y = (1 - alpha) * P^T x, with P the transition matrix completed by the dangling policy
+template <class G>
+void transition_transpose(const G& g, const std::vector<double>& x, std::vector<double>& y, double alpha,
+                          node_id source, Dangling dangling){
+    SSPPR_PHASE(iterate);
+    std::fill(y.begin(), y.end(), 0.0);
+    double jump = 0;
+    for(node_id u=0; u<g.n; ++u){
+        if(x[u] == 0) continue;
+        SSPPR_STAT_ADD(edges_scanned, g.get_neighbor_count(u));
+        double xu = (1.0 - alpha) * x[u];
+        if(g.get_neighbor_count(u) == 0){
+            if(dangling == Dangling::selfloop) y[u] += xu;
+            else if(dangling == Dangling::restart) y[source] += xu;
+            else jump += xu;
+            continue;
+        }
+        double xuv = xu / g.get_degree(u);
+        g.for_each_neighbor(u, [&](node_id v, double w){
+            y[v] += xuv * w;
+        });
+    }
+    if(jump != 0){
+        double share = jump / g.n;
+        for(double& yv : y) yv += share;
+    }
+}
+
+// Walk count of FORA: w walks per unit of residual give relative error eps above delta with probability 1 - pf.
+inline double fora_walks_per_residual(double eps, double delta, double pf){
+    return ((2*eps/3+2)*std::log(2.0/pf)) / (eps*eps*delta);
+}
+
+// The inverse: the eps reached by walks independent walks drawn in proportion to a residual of mass rsum, the positive
+// root of eps^2 * a = (2 eps / 3 + 2) * log(2 / pf) with a = delta * walks / rsum.
+inline double fora_error_of_walks(double walks, double rsum, double delta, double pf){
+    double log_term = std::log(2.0/pf);
+    double a = delta * walks / rsum;
+    return (2*log_term/3 + std::sqrt(4*log_term*log_term/9 + 8*a*log_term)) / (2*a);
+}
+
+// Draws walks from nodes in proportion to a residual r >= 0. With |r| = sum_u r[u], W such walks estimate
+// sum_u r[u] * pi_u(v) by |r| / W * (walks ending at v); they are independent draws worth |r| / W each, like the
+// walks of FORA, so any W of them come with FORA's guarantee. The alias table is built by the first walk after reset.
+class ResidualSampler{
+public:
+    // draws from r from now on; returns |r|
+    template <class T>
+    double reset(const std::vector<T>& r){
+        nodes.clear();
+        weights.clear();
+        built = false;
+        rsum = 0;
+        for(node_id u=0; u<r.size(); ++u){
+            if(r[u] > 0){
+                nodes.push_back(u);
+                weights.push_back(r[u]);
+                rsum += r[u];
             }
         }
+        return rsum;
+    }
+
+    // the nodes of positive residual, in increasing order
+    const std::vector<node_id>& support() const{ return nodes; }
+    double residual() const{ return rsum; }
+
+    // end of one walk; r must be nonzero
+    template <class G, class Source>
+    node_id walk(const G& g, double alpha, const Source& source, Dangling dangling){
+        uint32_t k = static_cast<uint32_t>(nodes.size());
+        if(!built){
+            prob.resize(k);
+            alias.resize(k);
+            build_alias_table(weights.data(), k, prob.data(), alias.data(), scaled, small, large);
+            built = true;
+        }
+        return random_walk(g, nodes[sample_alias_table(prob.data(), alias.data(), k)], alpha, source, dangling);
+    }
+
+    // eps with |estimate(v) - pi(v)| <= eps * pi(v) for pi(v) >= delta, with probability at least 1 - pf, after walks
+    // walks; |r| / delta, the bound of the push alone, if that is smaller
+    double error_bound(size_t walks, double delta, double pf) const{
+        if(rsum <= 0) return 0;
+        double push_only = rsum / delta;
+        if(walks == 0) return push_only;
+        return std::min(push_only, fora_error_of_walks(walks, rsum, delta, pf));
+    }
+
+private:
+    std::vector<node_id> nodes;
+    std::vector<double> weights, prob, scaled;
+    std::vector<uint32_t> alias, small, large;
+    bool built = false;
+    double rsum = 0;
+};
+
+// Turns the residual into PPR estimates with ceil(r[u] * w) walks from every node u; source is a node or a SeedSet.
+// jump is residual mass spread evenly over all nodes, kept out of r by the push; it takes ceil(jump * w) walks
+// from uniformly sampled nodes, so every walk still carries at most 1 / w.
+template <class G, class Source, class T>
+void walk_residuals(const G& g, std::vector<T>& ppr, const std::vector<T>& r, double w, double alpha,
+                    const Source& source, Dangling dangling, double jump = 0){
+    SSPPR_PHASE(walk);
+    std::vector<node_id> ends;
+    for(node_id u = 0; u < g.n; ++u){
+        if(r[u] > 0){
+            double ru = r[u];
+            size_t rw_num = std::ceil(ru * w);
+            for(size_t _ = 0; _ < rw_num; ++_){
+                ends.push_back(random_walk(g,u,alpha,source,dangling));
+                if(ends.size() == walk_batch) add_walk_ends(ppr, ends, ru / rw_num);
+            }
+            add_walk_ends(ppr, ends, ru / rw_num);
+        }
+    }
+    if(jump > 0){
+        size_t rw_num = std::ceil(jump * w);
+        for(size_t _ = 0; _ < rw_num; ++_){
+            ends.push_back(random_walk(g,rand_uniform(g.n),alpha,source,dangling));
+            if(ends.size() == walk_batch) add_walk_ends(ppr, ends, jump / rw_num);
+        }
+        add_walk_ends(ppr, ends, jump / rw_num);
+    }
+}
+
+}
+
+
+// Pushes from the nodes in queue until |r[u]| <= d(u) * rmax everywhere, keeping ppr + sum_u r[u] * pi_u fixed.
+// Dangling nodes count as degree 1 here, so the uniform policy cannot bounce ever smaller mass between them.
+// Residuals may be negative, which happens when a dynamic graph repairs the state after an update.
+// stop() is polled every 256 pushes; once it returns true the push ends early with the invariant intact and
+// the nodes still above rmax left in queue. Returns the number of pushes.
+// With a seed set, mass restarting from dangling nodes is parked like uniform mass and spread over the seeds.
+// If jump_left is given, the uniform mass parked when the push ends is added to it instead of being spread over r.
+// touch(v) is called for the source and for every node whose residual changed, before the node is queued.
+template <class G, class T, class Stop, class Touch = __ssppr_detail::no_touch>
+size_t forwardpush_resume(const G& g, node_id source, double alpha, double rmax, std::vector<T>& ppr, std::vector<T>& r,
+                          uniqueue<node_id>& queue, Dangling dangling, Stop&& stop, const SeedSet* seeds = nullptr,
+                          double* jump_left = nullptr, Touch&& touch = Touch()){
+    SSPPR_PHASE(push);
+    size_t pushes = 0;
+    double jump = 0;
+    bool to_seeds = seeds != nullptr && dangling == Dangling::restart;
+    if(to_seeds) dangling = Dangling::uniform;
+    bool keep = jump_left != nullptr && !to_seeds;
+    double spread_at = to_seeds ? seeds->nodes.size() * rmax : g.n * rmax;
+    auto on_push = [&](node_id v){
+        touch(v);
+        double d = g.get_neighbor_count(v) == 0 ? 1.0 : g.get_degree(v);
+        if(std::abs(r[v]) > d * rmax){
+            queue.push(v);
+        }
+    };
+    touch(source);
+    auto spread = [&](){
+        if(to_seeds) __ssppr_detail::spread_jump(*seeds, r, jump, on_push);
+        else __ssppr_detail::spread_jump(g, r, jump, on_push);
+    };
+    while(true){
+        // the leftover uniform mass is spread once the queue runs dry, which may lift residuals above rmax again
+        if(queue.empty() && jump != 0 && !keep) spread();
+        if(queue.empty()) break;
+        if((pushes & 255) == 255 && stop()){
+            if(jump != 0 && !keep) spread();
+            break;
+        }
+        SSPPR_STAT_MAX(queue_high_water, queue.size());
+        node_id u = queue.pop();
+        double ru = r[u];
+        ++pushes;
+        SSPPR_STAT_ADD(edges_scanned, g.get_neighbor_count(u));
         r[u] = 0.0;
+        ppr[u] += alpha * ru;
+        if(g.get_neighbor_count(u) == 0){
+            __ssppr_detail::push_dangling(u, (1.0 - alpha) * ru, source, dangling, ppr, r, jump, on_push);
+            if(std::abs(jump) > spread_at) spread();
+            continue;
+        }
+        double ruv = ru * (1.0 - alpha) / g.get_degree(u);
+        g.for_each_neighbor(u, [&](node_id v, double w){
+            r[v] += ruv * w;
+            on_push(v);
+        });
+    }
+    if(keep) *jump_left += jump;
+    SSPPR_STAT_ADD(pushes, pushes);
+    return pushes;
+}
+
+template <class G, class T>
+size_t forwardpush_resume(const G& g, node_id source, double alpha, double rmax, std::vector<T>& ppr, std::vector<T>& r,
+                          uniqueue<node_id>& queue, Dangling dangling = Dangling::selfloop){
+    return forwardpush_resume(g, source, alpha, rmax, ppr, r, queue, dangling, []{ return false; });
+}
+
+// Residual and queue of forward push, kept by one thread across its queries. prepare() sizes them with
+// assign_workspace, so after the first query on a graph they are reused instead of being allocated and faulted in.
+// A workspace holds O(n) memory between queries and must not be shared between threads.
+template <class T = double>
+struct PushWorkspace{
+    std::vector<T> r;
+    std::unique_ptr<uniqueue<node_id>> queue;
+    node_id n = 0;
+
+    // zero residual and empty queue for a graph of n nodes; returns the bytes it had to allocate
+    size_t prepare(node_id nodes){
+        size_t grown = r.capacity() < nodes ? nodes * sizeof(T) : 0;
+        assign_workspace(r, nodes, T(0));
+        if(!queue || n != nodes){
+            queue.reset(new uniqueue<node_id>(nodes));
+            n = nodes;
+            grown += nodes / 8;
+        } else{
+            queue->clear();
+        }
+        return grown;
     }
-    return std::make_pair(ppr, r);
+};
+
+// ppr, residual and queue of forward pushes from many sources in turn on one thread. push() lists in touched every
+// node whose entries it set and reset() clears only those, so a source costs its push, not O(n). Built on the
+// thread that uses it, which so first touches the arrays.
+struct SparsePushWorkspace{
+    std::vector<double> ppr, r;
+    std::vector<uint8_t> seen;
+    std::vector<node_id> touched;
+    uniqueue<node_id> queue;
+
+    explicit SparsePushWorkspace(node_id n) : queue(n){
+        assign_workspace(ppr, n, 0.0);
+        assign_workspace(r, n, 0.0);
+        assign_workspace(seen, n, uint8_t(0));
+    }
+
+    // forward push from source down to rmax; the uniform mass parked at the end goes to jump_left, if given
+    template <class G>
+    size_t push(const G& g, node_id source, double alpha, double rmax, Dangling dangling, double* jump_left = nullptr){
+        r[source] = 1.0;
+        queue.push(source);
+        return forwardpush_resume(g, source, alpha, rmax, ppr, r, queue, dangling, []{ return false; }, nullptr, jump_left,
+                                  [&](node_id v){
+                                      if(!seen[v]){
+                                          seen[v] = 1;
+                                          touched.push_back(v);
+                                      }
+                                  });
+    }
+
+    void reset(){
+        for(node_id v : touched){
+            ppr[v] = 0.0;
+            r[v] = 0.0;
+            seen[v] = 0;
+        }
+        touched.clear();
+    }
+};
+
+namespace __ssppr_detail{
+
+// ppr_forwardpush on the residual and queue of ws, where the residual stays
+template <class T, class G>
+std::vector<T> forwardpush_in(const G& g, node_id source, double alpha, double rmax, Dangling dangling, PushWorkspace<T>& ws,
+                              double* jump){
+    [[maybe_unused]] size_t grown = ws.prepare(g.n);
+    SSPPR_STAT_ADD(alloc_bytes, g.n * sizeof(T) + grown);
+    std::vector<T> ppr;
+    assign_workspace(ppr, g.n, T(0));
+    ws.r[source] = 1.0;
+    ws.queue->push(source);
+    forwardpush_resume(g, source, alpha, rmax, ppr, ws.r, *ws.queue, dangling, []{ return false; }, nullptr, jump);
+    return ppr;
 }
 
-std::pair<std::vector<double>, std::vector<double>> ppr_powerpush(const Graph& g, node_id source, double alpha, double lambda){
+}
+
+// If jump is given, the uniform mass left when the push ends is returned there rather than spread over r.
+template <class T = double, class G>
+std::pair<std::vector<T>, std::vector<T>> ppr_forwardpush(const G& g, node_id source, double alpha, double rmax, Dangling dangling = Dangling::selfloop,
+                                                          double* jump = nullptr){
+    PushWorkspace<T> ws;
+    std::vector<T> ppr = __ssppr_detail::forwardpush_in(g, source, alpha, rmax, dangling, ws, jump);
+    return std::make_pair(std::move(ppr), std::move(ws.r));
+}
+
+// If jump_left is given, the uniform mass left when the push ends is added to it rather than spread over r.
+template <class T = double, class G>
+std::pair<std::vector<T>, std::vector<T>> ppr_powerpush(const G& g, node_id source, double alpha, double lambda, Dangling dangling = Dangling::selfloop,
+                                                        double* jump_left = nullptr){
+    SSPPR_PHASE(push);
+    SSPPR_STAT_ADD(alloc_bytes, g.n * (2 * sizeof(T)) + g.n / 8);
     int epoch_num = 8;
     node_id scanThreshold = g.n / 4;
     
-    std::vector<double> ppr(g.n, 0.0);
-    std::vector<double> r(g.n, 0.0);
+    std::vector<T> ppr, r;
+    assign_workspace(ppr, g.n, T(0));
+    assign_workspace(r, g.n, T(0));
     r[source] = 1.0;
     uniqueue<node_id> queue(g.n);
     queue.push(source);
 
-    double rmax = lambda / g.m;
+    double rmax = lambda / g.get_total_weight();
     double rsum = 1;
     double ruv = 0;
+    double jump = 0;
+    // dangling nodes count as degree 1, as in forwardpush_resume
+    auto degree = [&](node_id v){
+        return g.get_neighbor_count(v) == 0 ? 1.0 : g.get_degree(v);
+    };
+    auto on_push = [&](node_id v){
+        if(r[v] > degree(v) * rmax){
+            queue.push(v);
+        }
+    };
     while(!queue.empty() && queue.size() <= scanThreshold && rsum > lambda){
+        SSPPR_STAT_MAX(queue_high_water, queue.size());
+        SSPPR_STAT_ADD(pushes, 1);
         node_id u = queue.pop();
-        ppr[u] += alpha * r[u];
-        rsum -= alpha * r[u];
-        ruv = r[u] * (1.0 - alpha) / g.get_degree(u);
-        for(node_id v : g.get_neighbors(u)){
-            r[v] += ruv;
-            if(r[v] > g.get_degree(v) * rmax){
-                queue.push(v);
-            }
-        }
+        double ru = r[u];
+        SSPPR_STAT_ADD(edges_scanned, g.get_neighbor_count(u));
         r[u] = 0.0;
+        ppr[u] += alpha * ru;
+        rsum -= alpha * ru;
+        if(g.get_neighbor_count(u) == 0){
+            if(dangling == Dangling::selfloop) rsum -= (1.0 - alpha) * ru;
+            __ssppr_detail::push_dangling(u, (1.0 - alpha) * ru, source, dangling, ppr, r, jump, on_push);
+            if(jump > g.n * rmax) __ssppr_detail::spread_jump(g, r, jump, on_push);
+            continue;
+        }
+        ruv = ru * (1.0 - alpha) / g.get_degree(u);
+        g.for_each_neighbor(u, [&](node_id v, double w){
+            r[v] += ruv * w;
+            on_push(v);
+        });
     }
+    SSPPR_STAT_MAX(queue_high_water, queue.size());
     if(rsum > lambda){
         // Switch to using sequential scan;
         for(int i=1;i<=epoch_num;++i){
-            double rmaxp = std::pow(lambda, static_cast<double>(i/epoch_num)) / g.m;
-            while(rsum > g.m * rmaxp){
+            double rmaxp = std::pow(lambda, static_cast<double>(i)/epoch_num) / g.get_total_weight();
+            bool progress = true;
+            while(rsum > g.get_total_weight() * rmaxp && progress){
+                progress = false;
+                SSPPR_STAT_ADD(scan_epochs, 1);
+                // uniform mass parked by earlier sweeps is spread before this one once it exceeds n * rmax
+                if(jump > g.n * rmaxp) __ssppr_detail::spread_jump(g, r, jump, [](node_id){});
                 for(node_id u=0; u<g.n; ++u){
-                    if(r[u] > g.get_degree(u) * rmaxp){
-                        ppr[u] += alpha * r[u];
-                        rsum -= alpha * r[u];
-                        ruv = r[u] * (1.0 - alpha) / g.get_degree(u);
-                        for(node_id v : g.get_neighbors(u)){
-                            r[v] += ruv;
-                        }
+                    if(r[u] > degree(u) * rmaxp){
+                        progress = true;
+                        SSPPR_STAT_ADD(pushes, 1);
+                        SSPPR_STAT_ADD(edges_scanned, g.get_neighbor_count(u));
+                        double ru = r[u];
                         r[u] = 0;
+                        ppr[u] += alpha * ru;
+                        rsum -= alpha * ru;
+                        if(g.get_neighbor_count(u) == 0){
+                            if(dangling == Dangling::selfloop) rsum -= (1.0 - alpha) * ru;
+                            __ssppr_detail::push_dangling(u, (1.0 - alpha) * ru, source, dangling, ppr, r, jump, [](node_id){});
+                            continue;
+                        }
+                        ruv = ru * (1.0 - alpha) / g.get_degree(u);
+                        g.for_each_neighbor(u, [&](node_id v, double w){
+                            r[v] += ruv * w;
+                        });
                     }
                 }
             }
         }
     }
-    return std::make_pair(ppr, r);
+    if(jump_left) *jump_left += jump;
+    else if(jump > 0) __ssppr_detail::spread_jump(g, r, jump, [](node_id){});
+    return std::make_pair(std::move(ppr), std::move(r));
 }
 
-std::vector<double> ppr_forarw_skelton(const Graph& g, node_id source, double alpha, double rmax, size_t rw_num){
-    auto [ppr, r] = ppr_forwardpush(g, source, alpha, rmax);
+// ws, if given, supplies the residual and queue of the push, see PushWorkspace.
+template <class T = double, class G>
+std::vector<T> ppr_forarw_skelton(const G& g, node_id source, double alpha, double rmax, size_t rw_num, Dangling dangling = Dangling::selfloop,
+                                  PushWorkspace<T>* ws = nullptr){
+    PushWorkspace<T> local;
+    if(ws == nullptr) ws = &local;
+    std::vector<T> ppr = __ssppr_detail::forwardpush_in(g, source, alpha, rmax, dangling, *ws, nullptr);
+    const std::vector<T>& r = ws->r;
+    SSPPR_PHASE(walk);
+    std::vector<node_id> ends;
     for(node_id u = 0; u < g.n; ++u){
         if(r[u] > 0){
+            double ru = r[u];
             for(size_t _ = 0; _ < rw_num; ++_){
-                ppr[random_walk(g,u,alpha)] += r[u] / rw_num;
+                ends.push_back(random_walk(g,u,alpha,source,dangling));
+                if(ends.size() == __ssppr_detail::walk_batch) __ssppr_detail::add_walk_ends(ppr, ends, ru / rw_num);
             }
+            __ssppr_detail::add_walk_ends(ppr, ends, ru / rw_num);
         }
     }
     return ppr;
 }
 
-std::vector<double> ppr_fora(const Graph& g, node_id source, double alpha, double eps, double delta, double pf){
-    size_t w = ((2*eps/3+2)*std::log(2.0/pf)) / (eps*eps*delta);
-    double rmax = std::sqrt(1.0/(g.m*w));
-    auto [ppr, r] = ppr_forwardpush(g, source, alpha, rmax);
-    for(node_id u = 0; u < g.n; ++u){
-        if(r[u] > 0){
-            size_t rw_num = std::ceil(r[u] * w);
-            for(size_t _ = 0; _ < rw_num; ++_){
-                ppr[random_walk(g,u,alpha)] += r[u] / rw_num;
-            }
-        }
-    }
+// FORA with a given rmax. The error guarantee holds for any rmax, which only trades push work for walks.
+// ws, if given, supplies the residual and queue of the push, see PushWorkspace.
+template <class T = double, class G>
+std::vector<T> ppr_fora_rmax(const G& g, node_id source, double alpha, double eps, double delta, double pf, double rmax, Dangling dangling = Dangling::selfloop,
+                             PushWorkspace<T>* ws = nullptr){
+    size_t w = __ssppr_detail::fora_walks_per_residual(eps, delta, pf);
+    double jump = 0;
+    PushWorkspace<T> local;
+    if(ws == nullptr) ws = &local;
+    std::vector<T> ppr = __ssppr_detail::forwardpush_in(g, source, alpha, rmax, dangling, *ws, &jump);
+    __ssppr_detail::walk_residuals(g, ppr, ws->r, w, alpha, source, dangling, jump);
     return ppr;
 }
 
-std::vector<double> ppr_speedppr(const Graph& g, node_id source, double alpha, double eps, double delta, double pf){
-    size_t w = 2 * ((2*eps/3+2)*std::log(2.0/pf)) / (eps*eps*delta);
-    double lambda = static_cast<double>(g.m / w);
-    auto [ppr, r] = ppr_powerpush(g, source, alpha, lambda);
-    // double rmax = 1.0 / w;
-    for(node_id u = 0; u < g.n; ++u){
-        if(r[u] > 0){
-            size_t rw_num = std::ceil(r[u] * w);
-            for(size_t _ = 0; _ < rw_num; ++_){
-                ppr[random_walk(g,u,alpha)] += r[u] / rw_num;
-            }
-        }
-    }
+// FORA with the rmax that balances the worst-case push and walk costs
+template <class T = double, class G>
+std::vector<T> ppr_fora(const G& g, node_id source, double alpha, double eps, double delta, double pf, Dangling dangling = Dangling::selfloop,
+                        PushWorkspace<T>* ws = nullptr){
+    size_t w = __ssppr_detail::fora_walks_per_residual(eps, delta, pf);
+    double rmax = std::sqrt(1.0/(g.get_total_weight()*w));
+    return ppr_fora_rmax<T>(g, source, alpha, eps, delta, pf, rmax, dangling, ws);
+}
+
+template <class T = double, class G>
+std::vector<T> ppr_speedppr(const G& g, node_id source, double alpha, double eps, double delta, double pf, Dangling dangling = Dangling::selfloop){
+    size_t w = 2 * __ssppr_detail::fora_walks_per_residual(eps, delta, pf);
+    double lambda = g.get_total_weight() / w;
+    double jump = 0;
+    auto [ppr, r] = ppr_powerpush<T>(g, source, alpha, lambda, dangling, &jump);
+    __ssppr_detail::walk_residuals(g, ppr, r, w, alpha, source, dangling, jump);
     return ppr;
 }
 
-std::vector<double> ppr_ppw(const Graph& g, node_id source, double alpha, size_t pi_num, size_t sample_size, size_t batch_size){
+template <class G>
+std::vector<double> ppr_ppw(const G& g, node_id source, double alpha, size_t pi_num, size_t sample_size, size_t batch_size, Dangling dangling = Dangling::selfloop){
+    SSPPR_STAT_ADD(alloc_bytes, 5 * g.n * sizeof(double) + batch_size * 4 * g.n * sizeof(double));
     std::vector<double> ppr(g.n,0);
     std::vector<double> sigma(g.n,0);
     sigma[source] = 1.0;
     std::vector<double> r = sigma;
     std::vector<double> rabs = r;
+    std::vector<double> pppr(g.n);
 
     size_t samples_per_batch = static_cast<size_t>(std::ceil(static_cast<double>(sample_size) / batch_size));
     for(size_t _=0; _<batch_size; ++_){
-        // r = sigma + (1-alpha)/alpha * P * ppr - 1/alpha * ppr
+        // r = sigma + (1-alpha)/alpha * P^T * ppr - 1/alpha * ppr
         // rabs = |r|
+        __ssppr_detail::transition_transpose(g, ppr, pppr, alpha, source, dangling);
         for(size_t u=0; u<g.n; ++u){
-            r[u] = sigma[u] - 1.0/alpha * ppr[u];
-            for(node_id v : g.get_neighbors(u)){
-                r[u] += ((1.0 - alpha)/alpha)  * ppr[v] / g.get_degree(u);
-            }
+            r[u] = sigma[u] - 1.0/alpha * ppr[u] + pppr[u] / alpha;
             rabs[u] = std::abs(r[u]);
         }
 
-        for(size_t i=0; i<samples_per_batch; ++i){
+        double rabs_sum = std::accumulate(rabs.begin(), rabs.end(), 0.0);
+        if(rabs_sum > 0){
+            SSPPR_PHASE(walk);
             AliasSampler sampler(rabs);
-            node_id s = sampler.sample();
-            ppr[random_walk(g,s,alpha)] += static_cast<double>((1-2*std::signbit(r[s])) * std::accumulate(rabs.begin(), rabs.end(), 0)) / samples_per_batch;
+            for(size_t i=0; i<samples_per_batch; ++i){
+                node_id s = sampler.sample();
+                ppr[random_walk(g,s,alpha,source,dangling)] += (1-2*std::signbit(r[s])) * rabs_sum / samples_per_batch;
+            }
         }
         // ppr = \sum_{k=0}^{K-1} alpha(1-alpha)^k * sigma + (1-alpha)^K * P^K * ppr
         std::vector<double> facpsigma = sigma;
         std::vector<double> facpppr = ppr;
-        std::vector<double> facpsigma_temp, facpppr_temp;
+        std::vector<double> facpsigma_temp(g.n), facpppr_temp(g.n);
         std::fill(ppr.begin(), ppr.end(), 0);
         for(size_t k=0; k<pi_num-1; ++k){
-            facpsigma_temp = facpsigma;
-            facpppr_temp = facpppr;
             for(node_id u=0; u<g.n; ++u){
                 ppr[u] += alpha * facpsigma[u];
-                facpsigma[u] = 0;
-                facpppr[u] = 0;
-                for(node_id v : g.get_neighbors(u)){
-                     facpsigma[u] += (1.0 - alpha) * facpsigma_temp[v] / g.get_degree(u);
-                     facpppr[u] += (1.0 - alpha) * facpppr_temp[v] / g.get_degree(u);
-                }    
             }
+            __ssppr_detail::transition_transpose(g, facpsigma, facpsigma_temp, alpha, source, dangling);
+            __ssppr_detail::transition_transpose(g, facpppr, facpppr_temp, alpha, source, dangling);
+            facpsigma.swap(facpsigma_temp);
+            facpppr.swap(facpppr_temp);
         }
         for(node_id u=0; u<g.n; ++u){
             ppr[u] += facpppr[u];
@@ -209,5 +704,25 @@ std::vector<double> ppr_ppw(const Graph& g, node_id source, double alpha, size_t
     return ppr;
 }
 
+// Exact PPR up to an L1 error of tol: ppr = sum_k alpha * ((1 - alpha) P^T)^k e_source, truncated once the
+// remaining mass (1 - alpha)^k drops below tol. Used as ground truth, O(m log(1/tol) / alpha).
+template <class G>
+std::vector<double> ppr_power_iteration(const G& g, node_id source, double alpha, double tol, Dangling dangling = Dangling::selfloop){
+    SSPPR_STAT_ADD(alloc_bytes, 3 * g.n * sizeof(double));
+    std::vector<double> ppr(g.n, 0);
+    std::vector<double> x(g.n, 0), y(g.n);
+    x[source] = 1.0;
+    double mass = 1.0;
+    while(mass > tol){
+        for(node_id u=0; u<g.n; ++u){
+            ppr[u] += alpha * x[u];
+        }
+        __ssppr_detail::transition_transpose(g, x, y, alpha, source, dangling);
+        x.swap(y);
+        mass *= 1.0 - alpha;
+    }
+    return ppr;
+}
+
 
 }
\ No newline at end of file
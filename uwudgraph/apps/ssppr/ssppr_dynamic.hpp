@@ -0,0 +1,172 @@
+/*
+// This header file maintains forward-push SSPPR estimates of tracked sources on a DynamicGraph.
+// Each source keeps the (ppr, r) state of ppr_forwardpush, which satisfies for every node x
+//     alpha * r(x) = alpha * [x == s] - ppr(x) + (1 - alpha) * sum_{y -> x} ppr(y) / d(y),
+// and therefore pi_s = ppr + sum_v r(v) * pi_v. An edge update only breaks this equation around its endpoints:
+// when d(u) changes, ppr(u) is rescaled so that ppr(u) / d(u) stays the same for the other neighbors of u,
+// and the residuals of u and v absorb the difference in O(1). The residuals may become negative, so a batch
+// ends with a signed push from the touched nodes that restores |r(x)| <= d(x) * rmax.
+// A node that becomes or stops being dangling costs O(n) under the uniform policy.
+
+// Sources:
+//     incremental push         : "Approximate Personalized PageRank on Dynamic Graphs", Zhang, Lofgren and Goel
+*/
+
+
+# pragma once
+
+#include <cmath>
+#include <stdexcept>
+#include <unordered_map>
+#include <vector>
+
+#include "uniqueue.hpp"
+
+#include "uwudgraph/dynamic_graph.hpp"
+#include "uwudgraph/graph_types.hpp"
+#include "ssppr_custom.hpp"
+
+
+namespace uwudgraph{
+
+
+class DynamicPPR{
+public:
+    size_t pushes = 0;      // pushes spent on repairs since construction, excluding track()
+
+    DynamicPPR(DynamicGraph& g, double alpha, double rmax, Dangling dangling = Dangling::selfloop)
+        : g(g), alpha(alpha), rmax(rmax), dangling(dangling), queue(g.n){}
+
+    // Computes the state of source from scratch; returns the number of pushes.
+    size_t track(node_id source){
+        if(source >= g.n){
+            throw std::invalid_argument("Source node out of range: " + std::to_string(source));
+        }
+        State& st = states[source];
+        st.ppr.assign(g.n, 0.0);
+        st.r.assign(g.n, 0.0);
+        st.r[source] = 1.0;
+        queue.push(source);
+        return forwardpush_resume(g, source, alpha, rmax, st.ppr, st.r, queue, dangling);
+    }
+
+    bool untrack(node_id source){
+        return states.erase(source) > 0;
+    }
+
+    bool is_tracked(node_id source) const{
+        return states.count(source) > 0;
+    }
+
+    const std::vector<double>& get_ppr(node_id source) const{
+        return state(source).ppr;
+    }
+
+    const std::vector<double>& get_residual(node_id source) const{
+        return state(source).r;
+    }
+
+    // Applies the batch to the graph and repairs every tracked source; returns the number of pushes.
+    size_t update(const std::vector<EdgeUpdate>& batch){
+        for(auto& [source, st] : states){
+            st.touched.clear();
+            st.touch_all = false;
+        }
+        for(const EdgeUpdate& up : batch){
+            node_id du = g.get_degree(up.u), dv = g.get_degree(up.v);
+            bool changed = up.insert ? g.insert_edge(up.u, up.v) : g.delete_edge(up.u, up.v);
+            if(!changed) continue;
+            for(auto& [source, st] : states){
+                update_arc(source, st, up.u, up.v, du, up.insert);
+                update_arc(source, st, up.v, up.u, dv, up.insert);
+            }
+        }
+
+        size_t batch_pushes = 0;
+        for(auto& [source, st] : states){
+            if(st.touch_all){
+                for(node_id x=0; x<g.n; ++x) enqueue(st, x);
+            } else{
+                for(node_id x : st.touched) enqueue(st, x);
+            }
+            batch_pushes += forwardpush_resume(g, source, alpha, rmax, st.ppr, st.r, queue, dangling);
+        }
+        pushes += batch_pushes;
+        return batch_pushes;
+    }
+
+private:
+    struct State{
+        std::vector<double> ppr;
+        std::vector<double> r;
+        std::vector<node_id> touched;   // nodes whose residual changed in the current batch
+        bool touch_all = false;
+    };
+
+    DynamicGraph& g;
+    double alpha;
+    double rmax;
+    Dangling dangling;
+    uniqueue<node_id> queue;
+    std::unordered_map<node_id, State> states;
+
+    const State& state(node_id source) const{
+        auto it = states.find(source);
+        if(it == states.end()){
+            throw std::invalid_argument("Source is not tracked: " + std::to_string(source));
+        }
+        return it->second;
+    }
+
+    void add_residual(State& st, node_id x, double delta){
+        st.r[x] += delta;
+        st.touched.push_back(x);
+    }
+
+    // Adds x times the dangling row of u to the residuals.
+    void add_dangling(node_id source, State& st, node_id u, double x){
+        if(dangling == Dangling::selfloop){
+            add_residual(st, u, x);
+        } else if(dangling == Dangling::restart){
+            add_residual(st, source, x);
+        } else{
+            for(double& rv : st.r) rv += x / g.n;
+            st.touch_all = true;
+        }
+    }
+
+    // Restores the invariant after the arc u -> v was inserted or deleted, d is the degree of u before.
+    void update_arc(node_id source, State& st, node_id u, node_id v, node_id d, bool insert){
+        double pu = st.ppr[u];
+        if(pu == 0) return;
+        double c = (1.0 - alpha) / alpha;
+        if(insert){
+            if(d > 0){
+                st.ppr[u] = pu * (d + 1) / d;
+                add_residual(st, u, -pu / (alpha * d));
+                add_residual(st, v, c * pu / d);
+            } else{
+                add_dangling(source, st, u, -c * pu);
+                add_residual(st, v, c * pu);
+            }
+        } else{
+            if(d > 1){
+                st.ppr[u] = pu * (d - 1) / d;
+                add_residual(st, u, pu / (alpha * d));
+                add_residual(st, v, -c * pu / d);
+            } else{
+                add_residual(st, v, -c * pu);
+                add_dangling(source, st, u, c * pu);
+            }
+        }
+    }
+
+    void enqueue(const State& st, node_id x){
+        if(std::abs(st.r[x]) > g.get_degree(x) * rmax){
+            queue.push(x);
+        }
+    }
+};
+
+
+}
@@ -0,0 +1,264 @@
+/*
+// This header file implements an asynchronous SSPPR API for services that keep a graph in memory.
+// SSPPRExecutor<G> owns a fixed set of query threads (one per core by default) and a bounded queue:
+//     submit       : queues a query and returns a std::future of its answer; blocks while the queue is full
+//     try_submit   : the same without blocking, false when the queue is full or the executor shut down
+//     callbacks    : both also take a callback run on the query thread instead of fulfilling a future
+// Waiting queries are served by priority (larger first), first come first served within a priority. A query runs
+// on one thread from start to end, so at most `threads` of them hold their O(n) working arrays at a time, and the
+// queue holds query descriptors only; memory stays bounded by threads x (one query) plus the answers not yet taken.
+// Every query thread keeps a PushWorkspace (ssppr_custom.hpp) across its queries, so push, fora_skeleton and fora
+// reuse its residual and queue and allocate only their answer.
+// An exception thrown by a callback is caught and dropped, so it cannot end the query thread. A callback may call
+// shutdown(), which then stops the executor without joining the query threads (it runs on one of them); the
+// destructor or a later shutdown() from another thread joins them. A callback must not destroy the executor.
+// Parallel loops inside a query share the process-wide work-stealing pool (parallel.hpp) instead of adding threads.
+// The deadline of an "anytime" query counts from its submission, so time spent queued comes out of its budget.
+// Query parameters left at zero take the defaults of SSPPR().
+*/
+
+
+# pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "ssppr.hpp"
+
+
+namespace uwudgraph{
+
+
+struct SSPPRQuery{
+    node_id source = 0;
+    double alpha = 0.2;
+    std::string method = "fora";
+    double eps = 0, delta = 0, pf = 0, rmax = 0;
+    size_t rw_num = 0, pi_num = 0, sample_size = 0, batch_size = 0;
+    Dangling dangling = Dangling::selfloop;
+    int priority = 0;                       // larger runs first
+    SSPPRBudget budget;                     // of "anytime" queries
+};
+
+struct SSPPRAnswer{
+    std::vector<double> ppr;
+    AnytimeResult anytime;                  // of "anytime" queries, without ppr
+    double queue_seconds = 0;               // from submission to start
+    double run_seconds = 0;
+};
+
+struct ExecutorConfig{
+    size_t threads = 0;                     // query threads, 0 means hardware concurrency
+    size_t max_pending = 1024;              // queued queries beyond which submit blocks and try_submit fails
+};
+
+
+template <class G>
+class SSPPRExecutor{
+public:
+    using Callback = std::function<void(SSPPRAnswer*, std::exception_ptr)>;
+
+    SSPPRExecutor(const G& g, ExecutorConfig config = ExecutorConfig()) : g(g), config(config){
+        if(this->config.threads == 0) this->config.threads = std::max(1u, std::thread::hardware_concurrency());
+        if(this->config.max_pending == 0){
+            throw std::invalid_argument("SSPPRExecutor needs room for at least one pending query.");
+        }
+        for(size_t i=0; i<this->config.threads; ++i){
+            threads.emplace_back([this]{ serve(); });
+            thread_ids.push_back(threads.back().get_id());
+        }
+    }
+
+    ~SSPPRExecutor(){
+        shutdown();
+    }
+
+    SSPPRExecutor(const SSPPRExecutor&) = delete;
+    SSPPRExecutor& operator=(const SSPPRExecutor&) = delete;
+
+    std::future<SSPPRAnswer> submit(SSPPRQuery query){
+        std::unique_ptr<Job> job = make_job(std::move(query));
+        std::future<SSPPRAnswer> answer = job->promise.get_future();
+        enqueue(std::move(job), true);
+        return answer;
+    }
+
+    void submit(SSPPRQuery query, Callback callback){
+        std::unique_ptr<Job> job = make_job(std::move(query));
+        job->callback = std::move(callback);
+        enqueue(std::move(job), true);
+    }
+
+    // admission control: false, leaving answer untouched, if the queue is full or the executor shut down
+    bool try_submit(SSPPRQuery query, std::future<SSPPRAnswer>& answer){
+        std::unique_ptr<Job> job = make_job(std::move(query));
+        std::future<SSPPRAnswer> f = job->promise.get_future();
+        if(!enqueue(std::move(job), false)) return false;
+        answer = std::move(f);
+        return true;
+    }
+
+    bool try_submit(SSPPRQuery query, Callback callback){
+        std::unique_ptr<Job> job = make_job(std::move(query));
+        job->callback = std::move(callback);
+        return enqueue(std::move(job), false);
+    }
+
+    // Stops accepting queries and joins the query threads. Queued queries still run if drain is true and
+    // otherwise fail with std::runtime_error. Running queries always finish. Called from a callback, it does
+    // everything but the join, which would wait for the calling thread itself.
+    void shutdown(bool drain = true){
+        bool from_query_thread = std::find(thread_ids.begin(), thread_ids.end(), std::this_thread::get_id()) != thread_ids.end();
+        std::vector<std::unique_ptr<Job>> dropped;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if(stopping && threads.empty()) return;
+            stopping = true;
+            if(!drain){
+                dropped = std::move(queue);
+                queue.clear();
+            }
+        }
+        work.notify_all();
+        room.notify_all();
+        for(std::unique_ptr<Job>& job : dropped){
+            finish(*job, nullptr, std::make_exception_ptr(std::runtime_error("SSPPR executor shut down before the query ran.")));
+        }
+        if(from_query_thread) return;
+        for(std::thread& t : threads) t.join();
+        threads.clear();
+    }
+
+    size_t pending() const{
+        std::lock_guard<std::mutex> lock(mutex);
+        return queue.size();
+    }
+
+    size_t running() const{
+        std::lock_guard<std::mutex> lock(mutex);
+        return active;
+    }
+
+    size_t num_threads() const{
+        return config.threads;
+    }
+
+private:
+    struct Job{
+        SSPPRQuery query;
+        uint64_t seq;
+        std::chrono::steady_clock::time_point submitted;
+        std::promise<SSPPRAnswer> promise;
+        Callback callback;
+    };
+
+    // heap order: higher priority first, then earlier submission
+    static bool later(const std::unique_ptr<Job>& a, const std::unique_ptr<Job>& b){
+        if(a->query.priority != b->query.priority) return a->query.priority < b->query.priority;
+        return a->seq > b->seq;
+    }
+
+    const G& g;
+    ExecutorConfig config;
+    std::vector<std::thread> threads;
+    std::vector<std::thread::id> thread_ids;    // fixed after construction, so read without the lock
+    mutable std::mutex mutex;
+    std::condition_variable work, room;
+    std::vector<std::unique_ptr<Job>> queue;
+    uint64_t next_seq = 0;
+    size_t active = 0;
+    bool stopping = false;
+
+    std::unique_ptr<Job> make_job(SSPPRQuery query){
+        std::unique_ptr<Job> job(new Job());
+        job->query = std::move(query);
+        job->submitted = std::chrono::steady_clock::now();
+        return job;
+    }
+
+    bool enqueue(std::unique_ptr<Job> job, bool wait){
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            if(wait) room.wait(lock, [&]{ return stopping || queue.size() < config.max_pending; });
+            if(stopping){
+                if(!wait) return false;
+                throw std::runtime_error("SSPPR executor is shut down.");
+            }
+            if(queue.size() >= config.max_pending) return false;
+            job->seq = next_seq++;
+            queue.push_back(std::move(job));
+            std::push_heap(queue.begin(), queue.end(), later);
+        }
+        work.notify_one();
+        return true;
+    }
+
+    void finish(Job& job, SSPPRAnswer* answer, std::exception_ptr error){
+        if(job.callback){
+            try{
+                job.callback(answer, error);
+            } catch(...){
+                // dropped: the query thread has to keep serving
+            }
+        } else if(error){
+            job.promise.set_exception(error);
+        } else{
+            job.promise.set_value(std::move(*answer));
+        }
+    }
+
+    void run(Job& job, PushWorkspace<double>& workspace){
+        SSPPRAnswer answer;
+        std::exception_ptr error;
+        auto start = std::chrono::steady_clock::now();
+        answer.queue_seconds = std::chrono::duration<double>(start - job.submitted).count();
+        try{
+            const SSPPRQuery& q = job.query;
+            AnytimeControl control;
+            control.budget = q.budget;
+            control.budget.seconds -= answer.queue_seconds;
+            answer.ppr = SSPPR(g, q.source, q.alpha, q.method, q.eps, q.delta, q.pf, q.rmax, q.rw_num, q.pi_num,
+                               q.sample_size, q.batch_size, q.dangling, nullptr, &control, &workspace);
+            answer.anytime = std::move(control.result);
+        } catch(...){
+            error = std::current_exception();
+        }
+        answer.run_seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        finish(job, error ? nullptr : &answer, error);
+    }
+
+    void serve(){
+        // built on this thread, so its arrays are first touched here
+        PushWorkspace<double> workspace;
+        while(true){
+            std::unique_ptr<Job> job;
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                work.wait(lock, [&]{ return stopping || !queue.empty(); });
+                if(queue.empty()) return;
+                std::pop_heap(queue.begin(), queue.end(), later);
+                job = std::move(queue.back());
+                queue.pop_back();
+                ++active;
+            }
+            room.notify_one();
+            run(*job, workspace);
+            std::lock_guard<std::mutex> lock(mutex);
+            --active;
+        }
+    }
+};
+
+
+}
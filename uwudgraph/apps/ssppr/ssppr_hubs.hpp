@@ -0,0 +1,405 @@
+/*
+// This header file implements a hub index: precomputed forward pushes from the highest-degree nodes, which a
+// query push uses instead of pushing through their neighbor lists.
+// On power-law graphs most pushed mass passes through a few hubs, and a push from hub h fans out to all d(h)
+// neighbors, which fan out again. build_hub_index runs a forward push down to rmax from every hub, in parallel on
+// one SparsePushWorkspace per thread, and keeps its sparse pair (ppr_h, r_h) and the uniform mass j_h it parked,
+// for which pi_h = ppr_h + sum_u (r_h[u] + j_h / n) * pi_u; j_h stays a scalar, so a hub costs its push, not O(n).
+// A query that would push residual x from h instead adds x * ppr_h to its estimate, x * r_h to its residual and
+// x * j_h to its own parked uniform mass, which keeps the invariant of forward push exactly; the truncation of the
+// hub vectors at their rmax is carried by the residual, not lost. With the index rmax at most the query rmax, no entry x * r_h[u] is above d(u) * rmax by itself, so the
+// cascade of pushes behind the hub is replaced by nnz(ppr_h) + nnz(r_h) additions.
+// Hubs are taken in decreasing degree until the index would exceed its byte budget. The index holds for one
+// alpha and dangling policy; restart jumps back to the query source, not to the hub, and is not supported.
+// It serializes with serialize.hpp (serialize_hub_index, and save_hub_index for files) and is only used on a
+// graph with the same n and m.
+*/
+
+
+# pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "serialize.hpp"
+#include "uniqueue.hpp"
+#include "multithread/parallel.hpp"
+
+#include "ssppr_custom.hpp"
+
+
+namespace uwudgraph{
+
+
+namespace __ssppr_detail{
+    // magic, n, m, alpha, dangling, rmax; followed by the hubs, their work and jump mass, and the CSR arrays of their
+    // ppr and r vectors
+    using HubIndexHeader = std::tuple<uint64_t, uint64_t, uint64_t, double, int32_t, double>;
+    const uint64_t hub_index_magic = 0x3278646e49627548;  // "HubIndx2"
+
+    // Reads a vector after checking that its length fits in what is left of the stream.
+    template <class T>
+    std::vector<T> deserialize_bounded(__serialize_detail::stream_cptr& it, __serialize_detail::stream_cptr end){
+        size_t left = end - it, len;
+        if(left < sizeof(size_t)){
+            throw std::invalid_argument("Malformed hub index.");
+        }
+        std::memcpy(&len, &*it, sizeof(size_t));
+        if(len > (left - sizeof(size_t)) / sizeof(T)){
+            throw std::invalid_argument("Malformed hub index.");
+        }
+        return deserialize<std::vector<T>>(it, end);
+    }
+}
+
+
+class HubIndex;
+
+// Indexes the nodes of largest degree, at most max_hubs of them (0 for no limit), until the index would take more
+// than budget_bytes; every hub vector is a forward push down to rmax. Hubs are pushed in parallel batches.
+template <class G>
+HubIndex build_hub_index(const G& g, double alpha, double rmax, size_t budget_bytes, size_t max_hubs = 0, Dangling dangling = Dangling::selfloop);
+
+class HubIndex{
+public:
+    // The entries of hub i are [ppr_offsets[i], ppr_offsets[i + 1]) of ppr_nodes and ppr_values, the same for r.
+    struct Entries{
+        const node_id* nodes;
+        const double* values;
+        size_t size;
+    };
+
+    HubIndex() = default;
+
+    uint64_t graph_n() const{ return n; }
+    uint64_t graph_m() const{ return m; }
+    double alpha() const{ return alpha_; }
+    double rmax() const{ return rmax_; }
+    Dangling dangling() const{ return dangling_; }
+    const std::vector<node_id>& hubs() const{ return hubs_; }
+    size_t entries() const{ return ppr_nodes.size() + r_nodes.size(); }
+    size_t entries(uint32_t i) const{ return ppr_offsets[i + 1] - ppr_offsets[i] + r_offsets[i + 1] - r_offsets[i]; }
+    // edges scanned by the push that built the vector of hub i
+    uint64_t work(uint32_t i) const{ return work_[i]; }
+    // uniform mass parked by the push of hub i, 0 unless the policy is uniform
+    double jump(uint32_t i) const{ return jump_[i]; }
+    // bytes held by the index, the per-node slot array included
+    size_t bytes() const{
+        return entries() * (sizeof(node_id) + sizeof(double)) + hubs_.size() * hub_bytes + slot.size() * sizeof(uint32_t);
+    }
+    // bytes of a hub besides its entries: its id, work, jump mass and two offsets
+    static constexpr size_t hub_bytes = sizeof(node_id) + 3 * sizeof(uint64_t) + sizeof(double);
+
+    // position of u among the hubs, or none
+    static constexpr uint32_t none = std::numeric_limits<uint32_t>::max();
+    uint32_t find(node_id u) const{ return slot[u]; }
+    Entries ppr(uint32_t i) const{
+        return {ppr_nodes.data() + ppr_offsets[i], ppr_values.data() + ppr_offsets[i], ppr_offsets[i + 1] - ppr_offsets[i]};
+    }
+    Entries r(uint32_t i) const{
+        return {r_nodes.data() + r_offsets[i], r_values.data() + r_offsets[i], r_offsets[i + 1] - r_offsets[i]};
+    }
+
+    template <class G>
+    void check(const G& g, double alpha) const{
+        if(g.n != n || g.m != m){
+            throw std::invalid_argument("Hub index was built on another graph.");
+        }
+        if(alpha != alpha_){
+            throw std::invalid_argument("Hub index was built for alpha " + std::to_string(alpha_) + ".");
+        }
+    }
+
+    template <class G>
+    friend HubIndex build_hub_index(const G& g, double alpha, double rmax, size_t budget_bytes, size_t max_hubs, Dangling dangling);
+    friend void serialize_hub_index(const HubIndex& index, std::vector<uint8_t>& stream);
+    friend HubIndex deserialize_hub_index(const std::vector<uint8_t>& stream);
+
+private:
+    uint64_t n = 0, m = 0;
+    double alpha_ = 0.2;
+    Dangling dangling_ = Dangling::selfloop;
+    double rmax_ = 0;
+    std::vector<node_id> hubs_;
+    std::vector<uint64_t> work_;
+    std::vector<double> jump_;
+    std::vector<uint64_t> ppr_offsets{0}, r_offsets{0};
+    std::vector<node_id> ppr_nodes, r_nodes;
+    std::vector<double> ppr_values, r_values;
+    std::vector<uint32_t> slot;                         // position of every node among the hubs, or none
+};
+
+template <class G>
+HubIndex build_hub_index(const G& g, double alpha, double rmax, size_t budget_bytes, size_t max_hubs, Dangling dangling){
+    if(dangling == Dangling::restart){
+        throw std::invalid_argument("Hub index does not support the restart policy.");
+    }
+    if(rmax <= 0){
+        throw std::invalid_argument("Hub index rmax must be positive.");
+    }
+    HubIndex index;
+    index.n = g.n;
+    index.m = g.m;
+    index.alpha_ = alpha;
+    index.rmax_ = rmax;
+    index.dangling_ = dangling;
+    index.slot.assign(g.n, HubIndex::none);
+
+    size_t candidates = max_hubs == 0 ? g.n : std::min<size_t>(max_hubs, g.n);
+    std::vector<node_id> order(g.n);
+    std::iota(order.begin(), order.end(), 0);
+    std::partial_sort(order.begin(), order.begin() + candidates, order.end(), [&](node_id a, node_id b){
+        return g.get_neighbor_count(a) > g.get_neighbor_count(b);
+    });
+
+    // sparse (ppr, r) and jump mass of one hub
+    struct Vector{
+        std::vector<node_id> ppr_nodes, r_nodes;
+        std::vector<double> ppr_values, r_values;
+        uint64_t work = 0;
+        double jump = 0;
+    };
+    size_t batch = 4 * get_num_threads();
+    std::vector<Vector> vectors(batch);
+    std::mutex lock;
+    std::vector<std::unique_ptr<SparsePushWorkspace>> idle;
+    for(size_t first=0; first<candidates; first+=batch){
+        size_t count = std::min(batch, candidates - first);
+        if(g.get_neighbor_count(order[first]) == 0) break;
+        parallel_for(0, count, [&](size_t i){
+            std::unique_ptr<SparsePushWorkspace> ws;
+            {
+                std::lock_guard<std::mutex> guard(lock);
+                if(!idle.empty()){
+                    ws = std::move(idle.back());
+                    idle.pop_back();
+                }
+            }
+            if(!ws) ws = std::make_unique<SparsePushWorkspace>(g.n);
+            Vector& vec = vectors[i];
+            vec = Vector();
+            ws->push(g, order[first + i], alpha, rmax, dangling, &vec.jump);
+            std::sort(ws->touched.begin(), ws->touched.end());
+            for(node_id v : ws->touched){
+                if(ws->ppr[v] != 0){
+                    // every node with an estimate was pushed at least once
+                    vec.work += g.get_neighbor_count(v);
+                    vec.ppr_nodes.push_back(v);
+                    vec.ppr_values.push_back(ws->ppr[v]);
+                }
+                if(ws->r[v] != 0){
+                    vec.r_nodes.push_back(v);
+                    vec.r_values.push_back(ws->r[v]);
+                }
+            }
+            ws->reset();
+            std::lock_guard<std::mutex> guard(lock);
+            idle.push_back(std::move(ws));
+        }, 1);
+        for(size_t i=0; i<count; ++i){
+            const Vector& vec = vectors[i];
+            size_t grown = index.bytes() + (vec.ppr_nodes.size() + vec.r_nodes.size()) * (sizeof(node_id) + sizeof(double)) +
+                           HubIndex::hub_bytes;
+            if(grown > budget_bytes || g.get_neighbor_count(order[first + i]) == 0) return index;
+            index.slot[order[first + i]] = static_cast<uint32_t>(index.hubs_.size());
+            index.hubs_.push_back(order[first + i]);
+            index.work_.push_back(vec.work);
+            index.jump_.push_back(vec.jump);
+            index.ppr_nodes.insert(index.ppr_nodes.end(), vec.ppr_nodes.begin(), vec.ppr_nodes.end());
+            index.ppr_values.insert(index.ppr_values.end(), vec.ppr_values.begin(), vec.ppr_values.end());
+            index.r_nodes.insert(index.r_nodes.end(), vec.r_nodes.begin(), vec.r_nodes.end());
+            index.r_values.insert(index.r_values.end(), vec.r_values.begin(), vec.r_values.end());
+            index.ppr_offsets.push_back(index.ppr_nodes.size());
+            index.r_offsets.push_back(index.r_nodes.size());
+        }
+    }
+    return index;
+}
+
+
+namespace __ssppr_detail{
+
+// Forward push from the current (ppr, r) down to rmax, resolving the residual of every hub through its vector.
+// As in forwardpush_resume, the uniform mass parked when the push ends goes to jump_left if it is given.
+template <class G>
+size_t forwardpush_hubs(const G& g, const HubIndex& index, double rmax, std::vector<double>& ppr, std::vector<double>& r,
+                        uniqueue<node_id>& queue, double* jump_left = nullptr){
+    SSPPR_PHASE(push);
+    double alpha = index.alpha();
+    Dangling dangling = index.dangling();
+    size_t pushes = 0;
+    double jump = 0;
+    // push work grows about linearly in residual / rmax: pushing x from hub h costs about x * work(h) * scale
+    double scale = index.rmax() / rmax;
+    auto on_push = [&](node_id v){
+        double d = g.get_neighbor_count(v) == 0 ? 1.0 : g.get_degree(v);
+        if(std::abs(r[v]) > d * rmax){
+            queue.push(v);
+        }
+    };
+    while(true){
+        if(queue.empty() && jump != 0 && !jump_left) spread_jump(g, r, jump, on_push);
+        if(queue.empty()) break;
+        SSPPR_STAT_MAX(queue_high_water, queue.size());
+        node_id u = queue.pop();
+        double ru = r[u];
+        ++pushes;
+        r[u] = 0.0;
+        uint32_t hub = index.find(u);
+        if(hub != HubIndex::none && std::abs(ru) * index.work(hub) * scale > index.entries(hub)){
+            // the additions take the place of the edges the pushes behind the hub would have scanned
+            SSPPR_STAT_ADD(edges_scanned, index.entries(hub));
+            HubIndex::Entries p = index.ppr(hub), q = index.r(hub);
+            for(size_t i=0; i<p.size; ++i) ppr[p.nodes[i]] += ru * p.values[i];
+            for(size_t i=0; i<q.size; ++i){
+                r[q.nodes[i]] += ru * q.values[i];
+                on_push(q.nodes[i]);
+            }
+            jump += ru * index.jump(hub);
+            if(std::abs(jump) > g.n * rmax) spread_jump(g, r, jump, on_push);
+            continue;
+        }
+        SSPPR_STAT_ADD(edges_scanned, g.get_neighbor_count(u));
+        ppr[u] += alpha * ru;
+        if(g.get_neighbor_count(u) == 0){
+            // restart is refused when the index is built, so source is never used
+            push_dangling(u, (1.0 - alpha) * ru, u, dangling, ppr, r, jump, on_push);
+            if(std::abs(jump) > g.n * rmax) spread_jump(g, r, jump, on_push);
+            continue;
+        }
+        double ruv = ru * (1.0 - alpha) / g.get_degree(u);
+        g.for_each_neighbor(u, [&](node_id v, double w){
+            r[v] += ruv * w;
+            on_push(v);
+        });
+    }
+    if(jump_left) *jump_left += jump;
+    SSPPR_STAT_ADD(pushes, pushes);
+    return pushes;
+}
+
+}
+
+
+// ppr_forwardpush with the alpha and dangling policy of index, pushing through its hubs with their vectors.
+template <class G>
+std::pair<std::vector<double>, std::vector<double>> ppr_forwardpush(const G& g, const HubIndex& index, node_id source, double alpha, double rmax,
+                                                                    double* jump = nullptr){
+    index.check(g, alpha);
+    if(source >= g.n){
+        throw std::invalid_argument("Source node out of range: " + std::to_string(source));
+    }
+    SSPPR_STAT_ADD(alloc_bytes, g.n * (2 * sizeof(double)) + g.n / 8);
+    std::vector<double> ppr, r;
+    assign_workspace(ppr, g.n, 0.0);
+    assign_workspace(r, g.n, 0.0);
+    r[source] = 1.0;
+    uniqueue<node_id> queue(g.n);
+    queue.push(source);
+    __ssppr_detail::forwardpush_hubs(g, index, rmax, ppr, r, queue, jump);
+    return std::make_pair(std::move(ppr), std::move(r));
+}
+
+// ppr_fora with its push phase through the hubs of index.
+template <class G>
+std::vector<double> ppr_fora(const G& g, const HubIndex& index, node_id source, double alpha, double eps, double delta, double pf){
+    size_t w = __ssppr_detail::fora_walks_per_residual(eps, delta, pf);
+    double rmax = std::sqrt(1.0/(g.get_total_weight()*w));
+    double jump = 0;
+    auto [ppr, r] = ppr_forwardpush(g, index, source, alpha, rmax, &jump);
+    __ssppr_detail::walk_residuals(g, ppr, r, w, alpha, source, index.dangling(), jump);
+    return ppr;
+}
+
+// Appends the index to stream.
+void serialize_hub_index(const HubIndex& index, std::vector<uint8_t>& stream){
+    __ssppr_detail::HubIndexHeader header(__ssppr_detail::hub_index_magic, index.n, index.m, index.alpha_,
+                                          static_cast<int32_t>(index.dangling_), index.rmax_);
+    serialize(header, stream);
+    serialize(index.hubs_, stream);
+    serialize(index.work_, stream);
+    serialize(index.jump_, stream);
+    serialize(index.ppr_offsets, stream);
+    serialize(index.ppr_nodes, stream);
+    serialize(index.ppr_values, stream);
+    serialize(index.r_offsets, stream);
+    serialize(index.r_nodes, stream);
+    serialize(index.r_values, stream);
+}
+
+// Reads an index written by serialize_hub_index; the whole stream must be the one index.
+HubIndex deserialize_hub_index(const std::vector<uint8_t>& stream){
+    __ssppr_detail::HubIndexHeader header;
+    if(stream.size() < get_size(header)){
+        throw std::invalid_argument("Malformed hub index.");
+    }
+    __serialize_detail::stream_cptr it = stream.begin(), end = stream.end();
+    header = deserialize<__ssppr_detail::HubIndexHeader>(it, end);
+    HubIndex index;
+    uint64_t magic;
+    int32_t dangling;
+    std::tie(magic, index.n, index.m, index.alpha_, dangling, index.rmax_) = header;
+    if(magic != __ssppr_detail::hub_index_magic || dangling < 0 || dangling > static_cast<int32_t>(Dangling::selfloop) ||
+       dangling == static_cast<int32_t>(Dangling::restart) || index.n > std::numeric_limits<node_id>::max()){
+        throw std::invalid_argument("Malformed hub index.");
+    }
+    index.dangling_ = static_cast<Dangling>(dangling);
+    index.hubs_ = __ssppr_detail::deserialize_bounded<node_id>(it, end);
+    index.work_ = __ssppr_detail::deserialize_bounded<uint64_t>(it, end);
+    index.jump_ = __ssppr_detail::deserialize_bounded<double>(it, end);
+    index.ppr_offsets = __ssppr_detail::deserialize_bounded<uint64_t>(it, end);
+    index.ppr_nodes = __ssppr_detail::deserialize_bounded<node_id>(it, end);
+    index.ppr_values = __ssppr_detail::deserialize_bounded<double>(it, end);
+    index.r_offsets = __ssppr_detail::deserialize_bounded<uint64_t>(it, end);
+    index.r_nodes = __ssppr_detail::deserialize_bounded<node_id>(it, end);
+    index.r_values = __ssppr_detail::deserialize_bounded<double>(it, end);
+
+    auto valid_csr = [&](const std::vector<uint64_t>& offsets, const std::vector<node_id>& nodes, const std::vector<double>& values){
+        if(offsets.size() != index.hubs_.size() + 1 || offsets.front() != 0 || offsets.back() != nodes.size() ||
+           nodes.size() != values.size()) return false;
+        for(size_t i=1; i<offsets.size(); ++i){
+            if(offsets[i] < offsets[i - 1]) return false;
+        }
+        for(node_id v : nodes){
+            if(v >= index.n) return false;
+        }
+        return true;
+    };
+    if(it != end || index.work_.size() != index.hubs_.size() || index.jump_.size() != index.hubs_.size() ||
+       !valid_csr(index.ppr_offsets, index.ppr_nodes, index.ppr_values) ||
+       !valid_csr(index.r_offsets, index.r_nodes, index.r_values)){
+        throw std::invalid_argument("Malformed hub index.");
+    }
+    index.slot.assign(index.n, HubIndex::none);
+    for(size_t i=0; i<index.hubs_.size(); ++i){
+        node_id h = index.hubs_[i];
+        if(h >= index.n || index.slot[h] != HubIndex::none){
+            throw std::invalid_argument("Malformed hub index.");
+        }
+        index.slot[h] = static_cast<uint32_t>(i);
+    }
+    return index;
+}
+
+void save_hub_index(std::string filename, const HubIndex& index){
+    std::vector<uint8_t> stream;
+    serialize_hub_index(index, stream);
+    save_stream(filename, stream);
+}
+
+HubIndex load_hub_index(std::string filename){
+    return deserialize_hub_index(load_stream(filename));
+}
+
+
+}
@@ -0,0 +1,223 @@
+/*
+// This header file implements SSPPR for several alphas of one source in a single pass over the graph.
+// Forward push carries one residual lane per alpha: node u stores its k residuals (and estimates) side by side,
+// so a push scans the edges of u once and updates all lanes in a short inner loop. u is pushed once any lane is
+// above d(u) * rmax, and then in every lane, which keeps pi_i = ppr_i + sum_u r_i[u] * pi_i,u for each of them.
+// The pushes are about those of the smallest alpha alone.
+// Walks are shared through their geometric lengths: a walk draws one uniform U_t per step and ends for alpha_i at
+// the first step with U_t < alpha_i, so one walk, as long as that of the smallest alpha, has a prefix that is an
+// exact sample of the walk of every larger alpha. FORA takes from node u the largest walk count any lane needs,
+// max_i ceil(r_i[u] * w), and every lane uses all of them, which keeps the guarantee of each lane.
+// SSPPR() with a vector of alphas runs the other methods (speedppr, ppw, auto, anytime) once per alpha.
+*/
+
+
+# pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <stdexcept>
+#include <vector>
+
+#include "random.hpp"
+#include "uniqueue.hpp"
+
+#include "ssppr_custom.hpp"
+
+
+namespace uwudgraph{
+
+
+// Walks from v once and writes the end node for alphas[i] to ends[i]; alphas must be in decreasing order.
+template <class G>
+void random_walk_multi(const G& g, node_id v, const std::vector<double>& alphas, node_id source, Dangling dangling, node_id* ends){
+    SSPPR_STAT_ADD(walks, 1);
+    size_t k = alphas.size(), done = 0;
+    while(true){
+        double u = rand_uniformf();
+        while(done < k && u < alphas[done]) ends[done++] = v;
+        if(done == k) return;
+        SSPPR_STAT_ADD(walk_steps, 1);
+        if(g.get_neighbor_count(v) == 0){
+            if(dangling == Dangling::selfloop){
+                while(done < k) ends[done++] = v;
+                return;
+            }
+            v = dangling == Dangling::restart ? source : rand_uniform(g.n);
+        } else{
+            v = g.rand_neighbor(v);
+        }
+    }
+}
+
+
+namespace __ssppr_detail{
+
+// Estimates and residuals of k alphas, lane i of node u at [u * k + i].
+struct Lanes{
+    size_t k;
+    std::vector<double> ppr, r;
+};
+
+// Forward push of all lanes from source down to rmax; alphas in decreasing order.
+template <class G>
+Lanes forwardpush_multi(const G& g, node_id source, const std::vector<double>& alphas, double rmax, Dangling dangling){
+    SSPPR_PHASE(push);
+    size_t k = alphas.size();
+    SSPPR_STAT_ADD(alloc_bytes, g.n * (2 * k * sizeof(double)) + g.n / 8);
+    Lanes lanes{k, std::vector<double>(g.n * k, 0.0), std::vector<double>(g.n * k, 0.0)};
+    std::vector<double>& ppr = lanes.ppr;
+    std::vector<double>& r = lanes.r;
+    for(size_t i=0; i<k; ++i) r[source * k + i] = 1.0;
+    uniqueue<node_id> queue(g.n);
+    queue.push(source);
+
+    std::vector<double> ru(k), coef(k), jump(k, 0.0);
+    bool jumped = false;
+    auto on_push = [&](node_id v){
+        if(queue.is_active(v)) return;
+        double limit = (g.get_neighbor_count(v) == 0 ? 1.0 : g.get_degree(v)) * rmax;
+        const double* rv = &r[static_cast<size_t>(v) * k];
+        // the smallest alpha, last, keeps the most residual
+        for(size_t i=k; i-- > 0;){
+            if(std::abs(rv[i]) > limit){
+                queue.push(v);
+                return;
+            }
+        }
+    };
+    auto spread = [&](){
+        jumped = false;
+        for(node_id v=0; v<g.n; ++v){
+            for(size_t i=0; i<k; ++i) r[static_cast<size_t>(v) * k + i] += jump[i] / g.n;
+        }
+        std::fill(jump.begin(), jump.end(), 0.0);
+        for(node_id v=0; v<g.n; ++v) on_push(v);
+    };
+
+    size_t pushes = 0;
+    while(true){
+        if(queue.empty() && jumped) spread();
+        if(queue.empty()) break;
+        SSPPR_STAT_MAX(queue_high_water, queue.size());
+        node_id u = queue.pop();
+        ++pushes;
+        SSPPR_STAT_ADD(edges_scanned, g.get_neighbor_count(u));
+        double* pu = &ppr[static_cast<size_t>(u) * k];
+        double* rptr = &r[static_cast<size_t>(u) * k];
+        for(size_t i=0; i<k; ++i){
+            ru[i] = rptr[i];
+            rptr[i] = 0.0;
+            pu[i] += alphas[i] * ru[i];
+        }
+        if(g.get_neighbor_count(u) == 0){
+            for(size_t i=0; i<k; ++i){
+                double rest = (1.0 - alphas[i]) * ru[i];
+                if(dangling == Dangling::selfloop) pu[i] += rest;
+                else if(dangling == Dangling::restart) r[source * k + i] += rest;
+                else jump[i] += rest;
+            }
+            if(dangling == Dangling::restart) on_push(source);
+            if(dangling == Dangling::uniform){
+                jumped = true;
+                double most = 0;
+                for(double j : jump) most = std::max(most, std::abs(j));
+                if(most > g.n * rmax) spread();
+            }
+            continue;
+        }
+        for(size_t i=0; i<k; ++i) coef[i] = ru[i] * (1.0 - alphas[i]) / g.get_degree(u);
+        g.for_each_neighbor(u, [&](node_id v, double w){
+            double* rv = &r[static_cast<size_t>(v) * k];
+            for(size_t i=0; i<k; ++i) rv[i] += coef[i] * w;
+            on_push(v);
+        });
+    }
+    SSPPR_STAT_ADD(pushes, pushes);
+    return lanes;
+}
+
+// Adds to every lane the walk estimate of its residual, with max_i ceil(r_i[u] * w) shared walks from every node u,
+// or rw_num walks if w is 0.
+template <class G>
+void walk_lanes(const G& g, Lanes& lanes, const std::vector<double>& alphas, double w, size_t rw_num, node_id source, Dangling dangling){
+    SSPPR_PHASE(walk);
+    size_t k = lanes.k;
+    std::vector<node_id> ends(k);
+    for(node_id u=0; u<g.n; ++u){
+        const double* ru = &lanes.r[static_cast<size_t>(u) * k];
+        size_t walks = 0;
+        for(size_t i=0; i<k; ++i){
+            if(ru[i] > 0) walks = std::max(walks, w > 0 ? static_cast<size_t>(std::ceil(ru[i] * w)) : rw_num);
+        }
+        for(size_t _=0; _<walks; ++_){
+            random_walk_multi(g, u, alphas, source, dangling, ends.data());
+            for(size_t i=0; i<k; ++i){
+                if(ru[i] > 0) lanes.ppr[static_cast<size_t>(ends[i]) * k + i] += ru[i] / walks;
+            }
+        }
+    }
+}
+
+}
+
+
+// PPR of source for every alpha, result[i] for alphas[i], with the push, rw, fora_skeleton or fora method of SSPPR().
+// Zero-valued parameters take the defaults of SSPPR().
+template <class G>
+std::vector<std::vector<double>> ppr_multi_alpha(const G& g, node_id source, const std::vector<double>& alphas, std::string method,
+                                                 double eps, double delta, double pf, double rmax, size_t rw_num,
+                                                 Dangling dangling = Dangling::selfloop){
+    if(alphas.empty()){
+        throw std::invalid_argument("At least one alpha is required.");
+    }
+    if(source >= g.n){
+        throw std::invalid_argument("Source node out of range: " + std::to_string(source));
+    }
+    if(eps == 0) eps = 0.1;
+    if(delta == 0) delta = 1.0/g.n;
+    if(pf == 0) pf = 1.0/g.n;
+    if(rmax == 0) rmax = 1e-4;
+    if(rw_num == 0) rw_num = 1000;
+
+    // lanes run in decreasing alpha, as the shared walks need
+    std::vector<size_t> order(alphas.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(), [&](size_t a, size_t b){ return alphas[a] > alphas[b]; });
+    std::vector<double> sorted(alphas.size());
+    for(size_t i=0; i<order.size(); ++i) sorted[i] = alphas[order[i]];
+
+    __ssppr_detail::Lanes lanes;
+    if(method == "push" or method == "forwardpush"){
+        lanes = __ssppr_detail::forwardpush_multi(g, source, sorted, rmax, dangling);
+    } else if(method == "rw"){
+        SSPPR_PHASE(walk);
+        lanes = {sorted.size(), std::vector<double>(g.n * sorted.size(), 0.0), {}};
+        std::vector<node_id> ends(sorted.size());
+        for(size_t _=0; _<rw_num; ++_){
+            random_walk_multi(g, source, sorted, source, dangling, ends.data());
+            for(size_t i=0; i<sorted.size(); ++i) lanes.ppr[static_cast<size_t>(ends[i]) * sorted.size() + i] += 1.0 / rw_num;
+        }
+    } else if(method == "fora_skeleton"){
+        lanes = __ssppr_detail::forwardpush_multi(g, source, sorted, rmax, dangling);
+        __ssppr_detail::walk_lanes(g, lanes, sorted, 0, rw_num, source, dangling);
+    } else if(method == "fora"){
+        // w and the rmax of ppr_fora do not depend on alpha
+        size_t w = __ssppr_detail::fora_walks_per_residual(eps, delta, pf);
+        lanes = __ssppr_detail::forwardpush_multi(g, source, sorted, std::sqrt(1.0/(g.get_total_weight()*w)), dangling);
+        __ssppr_detail::walk_lanes(g, lanes, sorted, w, 0, source, dangling);
+    } else{
+        throw std::invalid_argument("Method has no multi-alpha version: " + method);
+    }
+
+    std::vector<std::vector<double>> out(alphas.size(), std::vector<double>(g.n));
+    for(size_t i=0; i<order.size(); ++i){
+        std::vector<double>& dst = out[order[i]];
+        for(node_id v=0; v<g.n; ++v) dst[v] = lanes.ppr[static_cast<size_t>(v) * sorted.size() + i];
+    }
+    return out;
+}
+
+
+}
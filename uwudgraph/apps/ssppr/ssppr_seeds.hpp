@@ -0,0 +1,123 @@
+/*
+// This header file implements PPR personalized over a weighted seed set (SeedSet, ssppr_custom.hpp) in one computation,
+// instead of one query per seed:
+//     push : the residual starts as the seed distribution and the queue holds all seeds, so one push serves them all
+//     rw   : rw_num walks apportioned to the seeds by weight, ceil(weights[i] * rw_num) from seed i
+//     fora : push as above, then ceil(r[u] * w) walks from every node u, as for a single source (fora_skeleton:
+//            rw_num walks per node)
+// The result is sum_i weights[i] * pi_{seeds[i]} under the selfloop and uniform policies. Under restart, walks and pushed
+// mass jump back to the seed distribution rather than to the seed they started from, which is PageRank with the
+// seeds as personalization vector; the two agree on graphs without dangling nodes.
+// load_seeds reads a seed set from a file with one node per line and an optional weight after it.
+*/
+
+
+# pragma once
+
+#include <cmath>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "uniqueue.hpp"
+
+#include "ssppr_custom.hpp"
+
+
+namespace uwudgraph{
+
+
+template <class G>
+std::pair<std::vector<double>, std::vector<double>> ppr_forwardpush(const G& g, const SeedSet& seeds, double alpha, double rmax, Dangling dangling = Dangling::selfloop){
+    seeds.check(g);
+    SSPPR_STAT_ADD(alloc_bytes, g.n * (2 * sizeof(double)) + g.n / 8);
+    std::vector<double> ppr, r;
+    assign_workspace(ppr, g.n, 0.0);
+    assign_workspace(r, g.n, 0.0);
+    uniqueue<node_id> queue(g.n);
+    for(size_t i=0; i<seeds.nodes.size(); ++i){
+        r[seeds.nodes[i]] += seeds.weights[i];
+        queue.push(seeds.nodes[i]);
+    }
+    forwardpush_resume(g, seeds.nodes[0], alpha, rmax, ppr, r, queue, dangling, []{ return false; }, &seeds);
+    return std::make_pair(std::move(ppr), std::move(r));
+}
+
+template <class G>
+std::vector<double> ppr_rw(const G& g, const SeedSet& seeds, double alpha, size_t rw_num, Dangling dangling = Dangling::selfloop){
+    seeds.check(g);
+    SSPPR_PHASE(walk);
+    SSPPR_STAT_ADD(alloc_bytes, g.n * sizeof(double));
+    std::vector<double> ppr(g.n, 0.0);
+    for(size_t i=0; i<seeds.nodes.size(); ++i){
+        if(seeds.weights[i] == 0) continue;
+        size_t walks = std::ceil(seeds.weights[i] * rw_num);
+        for(size_t _=0; _<walks; ++_){
+            ppr[random_walk(g, seeds.nodes[i], alpha, seeds, dangling)] += seeds.weights[i] / walks;
+        }
+    }
+    return ppr;
+}
+
+template <class G>
+std::vector<double> ppr_forarw_skelton(const G& g, const SeedSet& seeds, double alpha, double rmax, size_t rw_num, Dangling dangling = Dangling::selfloop){
+    auto [ppr, r] = ppr_forwardpush(g, seeds, alpha, rmax, dangling);
+    SSPPR_PHASE(walk);
+    for(node_id u = 0; u < g.n; ++u){
+        if(r[u] > 0){
+            for(size_t _ = 0; _ < rw_num; ++_){
+                ppr[random_walk(g, u, alpha, seeds, dangling)] += r[u] / rw_num;
+            }
+        }
+    }
+    return ppr;
+}
+
+template <class G>
+std::vector<double> ppr_fora_rmax(const G& g, const SeedSet& seeds, double alpha, double eps, double delta, double pf, double rmax, Dangling dangling = Dangling::selfloop){
+    size_t w = __ssppr_detail::fora_walks_per_residual(eps, delta, pf);
+    auto [ppr, r] = ppr_forwardpush(g, seeds, alpha, rmax, dangling);
+    __ssppr_detail::walk_residuals(g, ppr, r, w, alpha, seeds, dangling);
+    return ppr;
+}
+
+template <class G>
+std::vector<double> ppr_fora(const G& g, const SeedSet& seeds, double alpha, double eps, double delta, double pf, Dangling dangling = Dangling::selfloop){
+    size_t w = __ssppr_detail::fora_walks_per_residual(eps, delta, pf);
+    double rmax = std::sqrt(1.0/(g.get_total_weight()*w));
+    return ppr_fora_rmax(g, seeds, alpha, eps, delta, pf, rmax, dangling);
+}
+
+// Reads "node [weight]" lines; blank lines and lines starting with # are skipped.
+SeedSet load_seeds(std::string filename){
+    std::ifstream file(filename);
+    if(!file.is_open()){
+        throw std::runtime_error("Could not open file: " + filename);
+    }
+    std::vector<node_id> nodes;
+    std::vector<double> weights;
+    std::string line;
+    while(std::getline(file, line)){
+        std::istringstream fields(line);
+        unsigned long long u;
+        if(!(fields >> u)){
+            fields.clear();
+            std::string first;
+            if(!(fields >> first) || first[0] == '#') continue;
+            throw std::invalid_argument("Invalid seed line: " + line);
+        }
+        double w = 1.0;
+        if(!(fields >> w)){
+            if(!fields.eof()) throw std::invalid_argument("Invalid seed line: " + line);
+            w = 1.0;
+        }
+        nodes.push_back(static_cast<node_id>(u));
+        weights.push_back(w);
+    }
+    return SeedSet(nodes, weights);
+}
+
+
+}
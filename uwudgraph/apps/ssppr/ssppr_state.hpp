@@ -0,0 +1,196 @@
+/*
+// This header file implements a resumable SSPPR state: forward push that can be continued to a smaller rmax and
+// walks that can be added in batches, instead of recomputing from scratch for a tighter accuracy.
+// PushState holds the estimate and residual of ppr_forwardpush together with the walks taken so far:
+//     refine    : resumes the push at a smaller rmax; only nodes above the new threshold are pushed again
+//     add_walks : takes more walks from the residual through a ResidualSampler (ssppr_custom.hpp), keeping for every
+//                 node how many of them ended there
+//     walk_to   : takes walks until error_bound drops to eps, i.e. until there are as many as FORA would take
+// A refine changes the residual the walks were drawn from and so discards them: refine first, then walk.
+// The state serializes with serialize.hpp (serialize_push_state, and save_push_state for files), so an expensive
+// partial computation can be checkpointed, and only resumes on a graph with the same n and m.
+*/
+
+
+# pragma once
+
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "random.hpp"
+#include "serialize.hpp"
+#include "uniqueue.hpp"
+
+#include "ssppr_custom.hpp"
+
+
+namespace uwudgraph{
+
+
+namespace __ssppr_detail{
+    // magic, n, m, source, alpha, dangling, rmax, walks; followed by ppr, r and the walk ends per node
+    using PushStateHeader = std::tuple<uint64_t, uint64_t, uint64_t, uint64_t, double, int32_t, double, uint64_t>;
+    const uint64_t push_state_magic = 0x3174617453687350;  // "PshStat1"
+}
+
+
+class PushState{
+public:
+    PushState() = default;
+
+    // The state before any push: r = e_source, ppr = 0.
+    template <class G>
+    PushState(const G& g, node_id source, double alpha, Dangling dangling = Dangling::selfloop)
+        : n(g.n), m(g.m), src(source), alpha_(alpha), dangling_(dangling), ppr_(g.n, 0.0), r_(g.n, 0.0), hits(g.n, 0){
+        if(source >= g.n){
+            throw std::invalid_argument("Source node out of range: " + std::to_string(source));
+        }
+        r_[source] = 1.0;
+        sampler.reset(r_);
+    }
+
+    // Pushes until |r[u]| <= d(u) * rmax everywhere; nothing to do if the state already got there.
+    // Drops the walks, which estimated the old residual. Returns the number of pushes.
+    template <class G>
+    size_t refine(const G& g, double rmax){
+        check_graph(g);
+        if(rmax >= rmax_) return 0;
+        uniqueue<node_id> queue(n);
+        for(node_id u=0; u<n; ++u){
+            double d = g.get_neighbor_count(u) == 0 ? 1.0 : g.get_degree(u);
+            if(std::abs(r_[u]) > d * rmax) queue.push(u);
+        }
+        size_t pushes = forwardpush_resume(g, src, alpha_, rmax, ppr_, r_, queue, dangling_);
+        rmax_ = rmax;
+        sampler.reset(r_);
+        hits.assign(n, 0);
+        walks_ = 0;
+        return pushes;
+    }
+
+    // Adds count walks drawn in proportion to the residual.
+    template <class G>
+    void add_walks(const G& g, size_t count){
+        check_graph(g);
+        if(sampler.residual() <= 0 || count == 0) return;
+        SSPPR_PHASE(walk);
+        for(size_t i=0; i<count; ++i) ++hits[sampler.walk(g, alpha_, src, dangling_)];
+        walks_ += count;
+    }
+
+    // Adds walks until error_bound(delta, pf) <= eps; returns the number added.
+    template <class G>
+    size_t walk_to(const G& g, double eps, double delta, double pf){
+        double rsum = sampler.residual();
+        if(rsum <= 0 || rsum / delta <= eps) return 0;
+        size_t target = static_cast<size_t>(std::ceil(rsum * __ssppr_detail::fora_walks_per_residual(eps, delta, pf)));
+        if(target <= walks_) return 0;
+        size_t added = target - walks_;
+        add_walks(g, added);
+        return added;
+    }
+
+    // ppr plus the walk estimate of the residual
+    std::vector<double> estimate() const{
+        std::vector<double> est = ppr_;
+        if(walks_ > 0){
+            double share = sampler.residual() / walks_;
+            for(node_id v=0; v<n; ++v) est[v] += share * hits[v];
+        }
+        return est;
+    }
+
+    // relative error of estimate()[v] for pi(v) >= delta, with probability at least 1 - pf
+    double error_bound(double delta, double pf) const{
+        return sampler.error_bound(walks_, delta, pf);
+    }
+
+    node_id source() const{ return src; }
+    double alpha() const{ return alpha_; }
+    Dangling dangling() const{ return dangling_; }
+    double rmax() const{ return rmax_; }                    // infinity before the first refine
+    double residual() const{ return sampler.residual(); }   // |r|
+    size_t walks() const{ return walks_; }
+    const std::vector<double>& ppr() const{ return ppr_; }
+    const std::vector<double>& r() const{ return r_; }
+
+    friend void serialize_push_state(const PushState& state, std::vector<uint8_t>& stream);
+    friend PushState deserialize_push_state(const std::vector<uint8_t>& stream);
+
+private:
+    uint64_t n = 0, m = 0;
+    node_id src = 0;
+    double alpha_ = 0.2;
+    Dangling dangling_ = Dangling::selfloop;
+    double rmax_ = std::numeric_limits<double>::infinity();
+    std::vector<double> ppr_, r_;
+    std::vector<uint64_t> hits;                         // walks ending at every node
+    uint64_t walks_ = 0;
+    __ssppr_detail::ResidualSampler sampler;            // over r, reset by refine
+
+    template <class G>
+    void check_graph(const G& g) const{
+        if(g.n != n || g.m != m){
+            throw std::invalid_argument("Push state was computed on another graph.");
+        }
+    }
+};
+
+// Appends the state to stream.
+void serialize_push_state(const PushState& state, std::vector<uint8_t>& stream){
+    __ssppr_detail::PushStateHeader header(__ssppr_detail::push_state_magic, state.n, state.m, state.src, state.alpha_,
+                                           static_cast<int32_t>(state.dangling_), state.rmax_, state.walks_);
+    serialize(header, stream);
+    serialize(state.ppr_, stream);
+    serialize(state.r_, stream);
+    serialize(state.hits, stream);
+}
+
+// Reads a state written by serialize_push_state; the whole stream must be the one state.
+PushState deserialize_push_state(const std::vector<uint8_t>& stream){
+    __ssppr_detail::PushStateHeader header;
+    size_t header_size = get_size(header);
+    if(stream.size() < header_size){
+        throw std::invalid_argument("Malformed push state.");
+    }
+    __serialize_detail::stream_cptr it = stream.begin();
+    header = deserialize<__ssppr_detail::PushStateHeader>(it, stream.end());
+    PushState state;
+    uint64_t magic, source;
+    int32_t dangling;
+    std::tie(magic, state.n, state.m, source, state.alpha_, dangling, state.rmax_, state.walks_) = header;
+    // three vectors of n 8-byte values, each behind its length
+    size_t vector_size = get_size(std::vector<double>());
+    if(magic != __ssppr_detail::push_state_magic || source >= state.n || dangling < 0 || dangling > static_cast<int32_t>(Dangling::selfloop) ||
+       state.n > (stream.size() - header_size) / 24 || stream.size() != header_size + 3 * (vector_size + 8 * state.n)){
+        throw std::invalid_argument("Malformed push state.");
+    }
+    state.src = static_cast<node_id>(source);
+    state.dangling_ = static_cast<Dangling>(dangling);
+    state.ppr_ = deserialize<std::vector<double>>(it, stream.end());
+    state.r_ = deserialize<std::vector<double>>(it, stream.end());
+    state.hits = deserialize<std::vector<uint64_t>>(it, stream.end());
+    if(state.ppr_.size() != state.n || state.r_.size() != state.n || state.hits.size() != state.n){
+        throw std::invalid_argument("Malformed push state.");
+    }
+    state.sampler.reset(state.r_);
+    return state;
+}
+
+void save_push_state(std::string filename, const PushState& state){
+    std::vector<uint8_t> stream;
+    serialize_push_state(state, stream);
+    save_stream(filename, stream);
+}
+
+PushState load_push_state(std::string filename){
+    return deserialize_push_state(load_stream(filename));
+}
+
+
+}
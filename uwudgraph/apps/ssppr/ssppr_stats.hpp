@@ -0,0 +1,96 @@
+/*
+// This header file implements the work counters and phase timers of the SSPPR kernels.
+// They are compiled in only with -DSSPPR_STATS (make STATS=1); otherwise every SSPPR_STAT_* macro expands to
+// nothing and the kernels are unchanged. Counters go to a thread-local SSPPRStats, which SSPPR() resets before
+// a query and copies out after it:
+//     pushes           : residual pushes, in forward push and in both phases of power push
+//     edges_scanned    : out-edges read by pushes and by products with the transition matrix, and entries of hub
+//                        vectors added in place of pushes (ssppr_hubs.hpp)
+//     queue_high_water : largest size of the push queue
+//     walks, walk_steps: random walks and the edges they took
+//     scan_epochs      : sequential sweeps over all nodes in the second phase of ppr_powerpush
+//     alloc_bytes      : bytes of the O(n) arrays the kernels allocate
+//     *_seconds        : wall time of the push, walk and iteration (matrix product) phases
+// SSPPR_PHASE also records the phase as a trace event while tracing is on, see trace.hpp.
+*/
+
+
+# pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+
+#include "trace.hpp"
+
+
+namespace uwudgraph{
+
+
+struct SSPPRStats{
+    size_t pushes = 0;
+    size_t edges_scanned = 0;
+    size_t queue_high_water = 0;
+    size_t walks = 0;
+    size_t walk_steps = 0;
+    size_t scan_epochs = 0;
+    size_t alloc_bytes = 0;
+    double push_seconds = 0;
+    double walk_seconds = 0;
+    double iterate_seconds = 0;
+
+    // totals of two queries, the larger queue
+    SSPPRStats& operator+=(const SSPPRStats& o){
+        pushes += o.pushes;
+        edges_scanned += o.edges_scanned;
+        queue_high_water = std::max(queue_high_water, o.queue_high_water);
+        walks += o.walks;
+        walk_steps += o.walk_steps;
+        scan_epochs += o.scan_epochs;
+        alloc_bytes += o.alloc_bytes;
+        push_seconds += o.push_seconds;
+        walk_seconds += o.walk_seconds;
+        iterate_seconds += o.iterate_seconds;
+        return *this;
+    }
+};
+
+
+namespace __ssppr_detail{
+
+inline SSPPRStats& stats(){
+    thread_local SSPPRStats s;
+    return s;
+}
+
+// adds the lifetime of the scope to seconds
+class PhaseTimer{
+public:
+    PhaseTimer(double& seconds) : seconds(seconds), start(std::chrono::steady_clock::now()){}
+    ~PhaseTimer(){
+        seconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    }
+
+private:
+    double& seconds;
+    std::chrono::steady_clock::time_point start;
+};
+
+}
+
+
+#ifdef SSPPR_STATS
+const bool ssppr_stats_enabled = true;
+#define SSPPR_STAT_ADD(field, x) (::uwudgraph::__ssppr_detail::stats().field += (x))
+#define SSPPR_STAT_MAX(field, x) (::uwudgraph::__ssppr_detail::stats().field = std::max<size_t>(::uwudgraph::__ssppr_detail::stats().field, (x)))
+#define SSPPR_PHASE(phase) ::uwudgraph::__ssppr_detail::PhaseTimer __ssppr_phase_timer(::uwudgraph::__ssppr_detail::stats().phase##_seconds); \
+                           TRACE_SCOPE(#phase, "ssppr")
+#else
+const bool ssppr_stats_enabled = false;
+#define SSPPR_STAT_ADD(field, x) ((void)0)
+#define SSPPR_STAT_MAX(field, x) ((void)0)
+#define SSPPR_PHASE(phase) TRACE_SCOPE(#phase, "ssppr")
+#endif
+
+
+}
@@ -0,0 +1,386 @@
+/*
+// This header file implements an index of the approximate top-k PPR neighbors of every node, built once for all
+// sources and read back through mmap.
+// build_topk_index runs a forward push down to rmax from every node and keeps the k nodes of largest estimate, the
+// source itself left out. Sources run in parallel, in chunks of config.chunk nodes; every thread reuses one
+// workspace of n-sized arrays and resets only the entries its push touched, so a source costs its push, not O(n).
+// The uniform dangling policy is refused: spreading its jump mass touches every node, which would make each
+// source cost O(n) again.
+// The records of a chunk are bump-allocated in the arenas of the workspaces that encoded them (memory.hpp).
+// After every chunk the records are appended to <path>.part and the next source is written to <path>.ckpt, so a
+// build that is cancelled or killed resumes from its last chunk; a checkpoint for other parameters is discarded.
+// The finished index is written to <path>.tmp and renamed to <path>, so readers of an older index keep their map.
+// File layout, native byte order:
+//     header  : TopKIndexHeader, 64 bytes
+//     offsets : n + 1 uint64, the record of node u is data[offsets[u], offsets[u + 1])
+//     data    : per node, a LEB128 varint count c, c varint gaps of the neighbor ids in increasing order (the
+//               first gap is the id itself), and c uint16 scores q with score = 2^(-q / 1024), a relative
+//               quantization error below 0.04%
+// TopKIndex maps the file read-only and decodes the record of a node in O(k), without touching the rest.
+*/
+
+
+# pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "array_view.hpp"
+#include "memory.hpp"
+#include "serialize.hpp"
+#include "uniqueue.hpp"
+#include "multithread/parallel.hpp"
+
+#include "uwudgraph/graph_types.hpp"
+#include "uwudgraph/apps/ssppr/ssppr_custom.hpp"
+
+
+namespace uwudgraph{
+
+
+struct TopKIndexConfig{
+    size_t k = 16;
+    double alpha = 0.2;
+    double rmax = 1e-5;
+    Dangling dangling = Dangling::selfloop;
+    size_t chunk = 1 << 16;                 // sources between checkpoints
+};
+
+struct TopKIndexHeader{
+    uint64_t magic;
+    uint64_t n, m, k;
+    double alpha, rmax;
+    int32_t dangling;
+    uint32_t score_scale;                   // q per halving of the score
+    uint64_t data_bytes;
+};
+static_assert(sizeof(TopKIndexHeader) == 64, "TopKIndexHeader must be 64 bytes");
+
+
+namespace __topk_index_detail{
+
+const uint64_t index_magic = 0x314b706f54525050;        // "PPRTopK1"
+const uint64_t checkpoint_magic = 0x3174706b434b5450;   // "PTKCkpt1"
+const uint32_t score_scale = 1024;
+
+// magic, n, m, k, alpha, rmax, dangling, next source, bytes of the part file
+using Checkpoint = std::tuple<uint64_t, uint64_t, uint64_t, uint64_t, double, double, int32_t, uint64_t, uint64_t>;
+
+inline void put_varint(std::vector<uint8_t>& out, uint64_t x){
+    while(x >= 0x80){
+        out.push_back(static_cast<uint8_t>(x | 0x80));
+        x >>= 7;
+    }
+    out.push_back(static_cast<uint8_t>(x));
+}
+
+// Reads a varint from [it, end), advancing it; false if it runs past end or over 64 bits.
+inline bool get_varint(const uint8_t*& it, const uint8_t* end, uint64_t& x){
+    x = 0;
+    for(int shift = 0; shift < 64 && it < end; shift += 7){
+        uint8_t b = *it++;
+        x |= static_cast<uint64_t>(b & 0x7f) << shift;
+        if(!(b & 0x80)) return true;
+    }
+    return false;
+}
+
+inline uint16_t quantize(double score){
+    double q = std::round(-std::log2(score) * score_scale);
+    return static_cast<uint16_t>(std::min(std::max(q, 0.0), 65535.0));
+}
+
+// Push arrays of one thread, reused across sources, and the records it encoded.
+struct Workspace : SparsePushWorkspace{
+    std::vector<uint8_t> record;    // record of the current source
+    Arena records;                  // records of the current chunk
+
+    Workspace(node_id n) : SparsePushWorkspace(n){}
+};
+
+// Appends the record of the k largest estimates in ws, the source left out, to out.
+inline void encode_topk(Workspace& ws, node_id source, size_t k, std::vector<uint8_t>& out){
+    std::vector<node_id>& cand = ws.touched;
+    // candidates first: touched is only reordered, reset still clears every node in it
+    auto last = std::partition(cand.begin(), cand.end(), [&](node_id v){ return v != source && ws.ppr[v] > 0; });
+    size_t c = std::min<size_t>(k, last - cand.begin());
+    std::nth_element(cand.begin(), cand.begin() + c, last, [&](node_id a, node_id b){
+        return ws.ppr[a] != ws.ppr[b] ? ws.ppr[a] > ws.ppr[b] : a < b;
+    });
+    std::sort(cand.begin(), cand.begin() + c);
+    put_varint(out, c);
+    node_id prev = 0;
+    for(size_t i=0; i<c; ++i){
+        put_varint(out, cand[i] - prev);
+        prev = cand[i];
+    }
+    for(size_t i=0; i<c; ++i){
+        uint16_t q = quantize(ws.ppr[cand[i]]);
+        out.push_back(static_cast<uint8_t>(q));
+        out.push_back(static_cast<uint8_t>(q >> 8));
+    }
+}
+
+// Byte offsets of the first n records in the file, n + 1 values.
+inline std::vector<uint64_t> record_offsets(std::string filename, uint64_t n){
+    std::ifstream file(filename, std::ios::binary);
+    std::vector<uint64_t> offsets(n + 1, 0);
+    uint64_t pos = 0;
+    auto varint = [&](){
+        uint64_t x = 0;
+        for(int shift = 0; ; shift += 7){
+            int b = file.get();
+            if(b == EOF || shift >= 64){
+                throw std::runtime_error("Corrupt top-k index part file: " + filename);
+            }
+            ++pos;
+            x |= static_cast<uint64_t>(b & 0x7f) << shift;
+            if(!(b & 0x80)) return x;
+        }
+    };
+    for(uint64_t u=0; u<n; ++u){
+        uint64_t c = varint();
+        for(uint64_t i=0; i<c; ++i) varint();
+        file.seekg(2 * c, std::ios::cur);
+        pos += 2 * c;
+        offsets[u + 1] = pos;
+    }
+    if(!file){
+        throw std::runtime_error("Corrupt top-k index part file: " + filename);
+    }
+    return offsets;
+}
+
+inline void write_checkpoint(std::string filename, const Checkpoint& ckpt){
+    std::vector<uint8_t> stream;
+    serialize(ckpt, stream);
+    std::string tmp = filename + ".tmp";
+    {
+        std::ofstream file(tmp, std::ios::binary);
+        if(!file.write(reinterpret_cast<const char*>(stream.data()), stream.size()) || !file.flush()){
+            throw std::runtime_error("Could not write to file: " + tmp);
+        }
+    }
+    std::filesystem::rename(tmp, filename);
+}
+
+// The checkpoint in filename if it exists and is for these parameters.
+inline bool read_checkpoint(std::string filename, const Checkpoint& expected, Checkpoint& ckpt){
+    std::ifstream file(filename, std::ios::binary);
+    if(!file.is_open()) return false;
+    std::vector<uint8_t> stream((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    if(stream.size() != get_size(ckpt)) return false;
+    ckpt = deserialize<Checkpoint>(stream);
+    auto params = [](const Checkpoint& c){
+        return std::make_tuple(std::get<0>(c), std::get<1>(c), std::get<2>(c), std::get<3>(c), std::get<4>(c), std::get<5>(c), std::get<6>(c));
+    };
+    return params(ckpt) == params(expected) && std::get<7>(ckpt) <= std::get<1>(ckpt);
+}
+
+}
+
+
+// Builds the top-k index of every node of g into filename, resuming from a checkpoint of the same parameters.
+// Returns false if cancel was set, which is checked after every chunk; the build then resumes on the next call.
+template <class G>
+bool build_topk_index(const G& g, std::string filename, const TopKIndexConfig& config, const std::atomic<bool>* cancel = nullptr){
+    if(config.k == 0 || config.rmax <= 0 || config.alpha <= 0 || config.alpha >= 1){
+        throw std::invalid_argument("Top-k index needs k > 0, rmax > 0 and 0 < alpha < 1.");
+    }
+    if(config.dangling == Dangling::uniform){
+        throw std::invalid_argument("Top-k index does not support the uniform policy.");
+    }
+    std::string part = filename + ".part", ckpt_file = filename + ".ckpt";
+    __topk_index_detail::Checkpoint ckpt(__topk_index_detail::checkpoint_magic, g.n, g.m, config.k, config.alpha, config.rmax,
+                                         static_cast<int32_t>(config.dangling), 0, 0);
+    if(!__topk_index_detail::read_checkpoint(ckpt_file, ckpt, ckpt) || !std::filesystem::exists(part) ||
+       std::filesystem::file_size(part) < std::get<8>(ckpt)){
+        std::get<7>(ckpt) = std::get<8>(ckpt) = 0;
+    }
+    // drop records written after the last checkpoint
+    { std::ofstream touch(part, std::ios::binary | std::ios::app); }
+    std::filesystem::resize_file(part, std::get<8>(ckpt));
+
+    std::mutex lock;
+    std::vector<std::unique_ptr<__topk_index_detail::Workspace>> idle;
+    size_t chunk = std::max<size_t>(config.chunk, 1);
+    std::vector<array_view<uint8_t>> records;
+    for(uint64_t first = std::get<7>(ckpt); first < g.n; first += chunk){
+        size_t count = std::min<uint64_t>(chunk, g.n - first);
+        records.assign(count, array_view<uint8_t>());
+        parallel_for_chunks(0, count, [&](size_t begin, size_t end){
+            std::unique_ptr<__topk_index_detail::Workspace> ws;
+            {
+                std::lock_guard<std::mutex> guard(lock);
+                if(!idle.empty()){
+                    ws = std::move(idle.back());
+                    idle.pop_back();
+                }
+            }
+            if(!ws) ws = std::make_unique<__topk_index_detail::Workspace>(g.n);
+            for(size_t i=begin; i<end; ++i){
+                node_id source = static_cast<node_id>(first + i);
+                ws->push(g, source, config.alpha, config.rmax, config.dangling);
+                ws->record.clear();
+                __topk_index_detail::encode_topk(*ws, source, config.k, ws->record);
+                records[i] = array_view<uint8_t>(ws->records.copy(ws->record.data(), ws->record.size()), ws->record.size());
+                ws->reset();
+            }
+            std::lock_guard<std::mutex> guard(lock);
+            idle.push_back(std::move(ws));
+        }, 16);
+
+        {
+            std::ofstream out(part, std::ios::binary | std::ios::app);
+            for(const array_view<uint8_t>& rec : records){
+                out.write(reinterpret_cast<const char*>(rec.data()), rec.size());
+            }
+            if(!out.flush()){
+                throw std::runtime_error("Could not write to file: " + part);
+            }
+        }
+        for(auto& ws : idle) ws->records.reset();
+        std::get<7>(ckpt) = first + count;
+        std::get<8>(ckpt) = std::filesystem::file_size(part);
+        __topk_index_detail::write_checkpoint(ckpt_file, ckpt);
+        if(cancel != nullptr && cancel->load() && first + count < g.n) return false;
+    }
+
+    std::vector<uint64_t> offsets = __topk_index_detail::record_offsets(part, g.n);
+    TopKIndexHeader header{__topk_index_detail::index_magic, g.n, g.m, config.k, config.alpha, config.rmax,
+                           static_cast<int32_t>(config.dangling), __topk_index_detail::score_scale, offsets.back()};
+    std::string tmp = filename + ".tmp";
+    {
+        std::ofstream out(tmp, std::ios::binary);
+        std::ifstream in(part, std::ios::binary);
+        out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        out.write(reinterpret_cast<const char*>(offsets.data()), offsets.size() * sizeof(uint64_t));
+        if(offsets.back() > 0) out << in.rdbuf();
+        if(!out.flush()){
+            throw std::runtime_error("Could not write to file: " + tmp);
+        }
+    }
+    std::filesystem::rename(tmp, filename);
+    std::filesystem::remove(part);
+    std::filesystem::remove(ckpt_file);
+    return true;
+}
+
+
+// Read-only view of an index file written by build_topk_index, mapped into memory.
+class TopKIndex{
+public:
+    explicit TopKIndex(std::string filename){
+        int fd = ::open(filename.c_str(), O_RDONLY);
+        if(fd < 0){
+            throw std::runtime_error("Could not open file: " + filename);
+        }
+        struct stat st;
+        if(::fstat(fd, &st) != 0 || static_cast<size_t>(st.st_size) < sizeof(TopKIndexHeader)){
+            ::close(fd);
+            throw std::runtime_error("Not a top-k index file: " + filename);
+        }
+        size = st.st_size;
+        void* addr = ::mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+        ::close(fd);
+        if(addr == MAP_FAILED){
+            throw std::runtime_error("Could not map file: " + filename);
+        }
+        base = static_cast<const uint8_t*>(addr);
+        std::memcpy(&header, base, sizeof(header));
+        uint64_t rest = size - sizeof(header);
+        if(header.magic != __topk_index_detail::index_magic || header.score_scale == 0 || header.n >= rest / sizeof(uint64_t) ||
+           rest - (header.n + 1) * sizeof(uint64_t) != header.data_bytes){
+            unmap();
+            throw std::runtime_error("Not a top-k index file: " + filename);
+        }
+        offsets = reinterpret_cast<const uint64_t*>(base + sizeof(header));
+        data = base + sizeof(header) + (header.n + 1) * sizeof(uint64_t);
+    }
+
+    TopKIndex(const TopKIndex&) = delete;
+    TopKIndex& operator=(const TopKIndex&) = delete;
+    TopKIndex(TopKIndex&& other) noexcept : base(other.base), size(other.size), header(other.header), offsets(other.offsets), data(other.data){
+        other.base = nullptr;
+    }
+    ~TopKIndex(){ unmap(); }
+
+    uint64_t n() const{ return header.n; }
+    uint64_t m() const{ return header.m; }
+    uint64_t k() const{ return header.k; }
+    double alpha() const{ return header.alpha; }
+    double rmax() const{ return header.rmax; }
+
+    // Writes the top-k neighbors of u to out, largest score first, and returns their number.
+    size_t lookup(node_id u, std::vector<std::pair<node_id, float>>& out) const{
+        if(u >= header.n){
+            throw std::invalid_argument("Node out of range: " + std::to_string(u));
+        }
+        uint64_t lo = offsets[u], hi = offsets[u + 1];
+        if(lo > hi || hi > header.data_bytes){
+            throw std::runtime_error("Corrupt top-k index record.");
+        }
+        const uint8_t* it = data + lo;
+        const uint8_t* end = data + hi;
+        uint64_t c = 0, id = 0, gap = 0;
+        if(!__topk_index_detail::get_varint(it, end, c) || c > header.k){
+            throw std::runtime_error("Corrupt top-k index record.");
+        }
+        out.resize(c);
+        for(uint64_t i=0; i<c; ++i){
+            if(!__topk_index_detail::get_varint(it, end, gap) || (id += gap) >= header.n){
+                throw std::runtime_error("Corrupt top-k index record.");
+            }
+            out[i].first = static_cast<node_id>(id);
+        }
+        if(static_cast<uint64_t>(end - it) != 2 * c){
+            throw std::runtime_error("Corrupt top-k index record.");
+        }
+        for(uint64_t i=0; i<c; ++i, it += 2){
+            out[i].second = static_cast<float>(std::exp2(-static_cast<double>(it[0] | (it[1] << 8)) / header.score_scale));
+        }
+        std::sort(out.begin(), out.end(), [](const std::pair<node_id, float>& a, const std::pair<node_id, float>& b){
+            return a.second != b.second ? a.second > b.second : a.first < b.first;
+        });
+        return c;
+    }
+
+    std::vector<std::pair<node_id, float>> lookup(node_id u) const{
+        std::vector<std::pair<node_id, float>> out;
+        lookup(u, out);
+        return out;
+    }
+
+private:
+    const uint8_t* base = nullptr;
+    size_t size = 0;
+    TopKIndexHeader header;
+    const uint64_t* offsets = nullptr;
+    const uint8_t* data = nullptr;
+
+    void unmap(){
+        if(base != nullptr) ::munmap(const_cast<uint8_t*>(base), size);
+        base = nullptr;
+    }
+};
+
+
+}
@@ -0,0 +1,136 @@
+#pragma once
+
+#include <vector>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+
+#include "graph.hpp"
+#include "graph_types.hpp"
+#include "random.hpp"
+
+
+namespace uwudgraph{
+
+struct EdgeUpdate{
+    node_id u;
+    node_id v;
+    bool insert;    // false deletes the edge
+};
+
+// Undirected graph under edge inserts and deletes on a fixed node set.
+// Rows are unordered vectors and every arc (u, v) knows its slot in row u, so a delete swaps the last
+// entry of the row into the freed slot: both operations are amortized O(1).
+// Self-loops and parallel edges are not stored. It provides the interface of Graph used by the SSPPR kernels.
+class DynamicGraph{
+public:
+    node_id n = 0;
+    edge_id m = 0;
+
+    std::vector<std::vector<node_id>> adj = {};
+
+    DynamicGraph(node_id n = 0) : n(n), adj(n) {};
+
+    // copies g, dropping self-loops and parallel edges
+    DynamicGraph(const Graph& g) : n(g.n), adj(g.n){
+        for(node_id u=0; u<g.n; ++u){
+            for(node_id v : g.get_neighbors(u)){
+                if(u < v) insert_edge(u, v);
+            }
+        }
+    }
+
+    node_id get_degree(node_id u) const{
+        return adj[u].size();
+    }
+
+    const std::vector<node_id>& get_neighbors(node_id u) const{
+        return adj[u];
+    }
+
+    node_id get_neighbor_count(node_id u) const{
+        return adj[u].size();
+    }
+
+    // f(v, w) for every edge (u, v), w = 1 in an unweighted graph
+    template <typename F>
+    void for_each_neighbor(node_id u, F&& f) const{
+        for(node_id v : adj[u]) f(v, 1.0);
+    }
+
+    double get_total_weight() const{
+        return m;
+    }
+
+    node_id rand_neighbor(node_id u) const{
+        if (adj[u].size() == 0){
+            throw std::runtime_error("No neighbors");
+        }
+        return adj[u][rand_uniform(adj[u].size())];
+    }
+
+    bool has_edge(node_id u, node_id v) const{
+        return slot.count(key(u, v)) > 0;
+    }
+
+    // Returns false if the edge is a self-loop or already present.
+    bool insert_edge(node_id u, node_id v){
+        check(u, v);
+        if(u == v || has_edge(u, v)) return false;
+        insert_arc(u, v);
+        insert_arc(v, u);
+        ++m;
+        return true;
+    }
+
+    // Returns false if the edge is not present.
+    bool delete_edge(node_id u, node_id v){
+        check(u, v);
+        if(!has_edge(u, v)) return false;
+        delete_arc(u, v);
+        delete_arc(v, u);
+        --m;
+        return true;
+    }
+
+    // Applies the updates in order, returns the number that changed the graph.
+    size_t apply(const std::vector<EdgeUpdate>& batch){
+        size_t changed = 0;
+        for(const EdgeUpdate& up : batch){
+            changed += up.insert ? insert_edge(up.u, up.v) : delete_edge(up.u, up.v);
+        }
+        return changed;
+    }
+
+private:
+    std::unordered_map<uint64_t, node_id> slot;   // arc (u, v) -> index of v in adj[u]
+
+    static uint64_t key(node_id u, node_id v){
+        return (static_cast<uint64_t>(u) << 32) | v;
+    }
+
+    void check(node_id u, node_id v) const{
+        if(u >= n || v >= n){
+            throw std::invalid_argument("Edge (" + std::to_string(u) + ", " + std::to_string(v) + ") out of range.");
+        }
+    }
+
+    void insert_arc(node_id u, node_id v){
+        slot[key(u, v)] = adj[u].size();
+        adj[u].push_back(v);
+    }
+
+    void delete_arc(node_id u, node_id v){
+        auto it = slot.find(key(u, v));
+        node_id i = it->second;
+        slot.erase(it);
+        node_id last = adj[u].back();
+        adj[u].pop_back();
+        if(last != v){
+            adj[u][i] = last;
+            slot[key(u, last)] = i;
+        }
+    }
+};
+
+};
@@ -1,5 +1,9 @@
 /*
    load_edgelist from file and convert to uwudgraph.
+   save_binary / load_binary store the graph in CSR form, which loads without parsing:
+       "UWUDGRPH", uint64 n, uint64 m, uint64 offsets[n + 1], uint32 targets[offsets[n]]
+   where row u is targets[offsets[u], offsets[u + 1]). load_graph picks the format from the file header.
+   load_binary checks that offsets start at 0, never decrease and end at 2m, and that every target is below n.
 */
 
 #pragma once
@@ -8,6 +12,8 @@
 #include <fstream>
 #include <stdexcept>
 #include <algorithm>
+#include <cstring>
+#include <limits>
 
 #include "graph.hpp"
 #include "graph_types.hpp"
@@ -114,23 +120,128 @@ Graph* load_edgelist(std::string filename) {
     }
   }
 
-  // Resize the adjacency list to the number of vertices
-  graph->adj.resize(graph->n);
+  std::vector<edge> edges;
+  edges.reserve(graph->m);
   while (std::getline(is, line)) {
     if (line[0] != '#' && line[0] != '/' && line.length() > 0) {
       try {
         // This line of the input file isn't a comment, parse it.
-        edge this_edge = parse_edgelist_content_line(line);
-        graph->adj[this_edge.first].emplace_back(this_edge.second);
-        graph->adj[this_edge.second].emplace_back(this_edge.first);
+        edges.push_back(parse_edgelist_content_line(line));
       } catch (std::invalid_argument &e) {
         throw(std::runtime_error(e.what()));
       }
     }
   }
   is.close();
+
+  // Count the degrees, then fill every row in file order
+  graph->offsets.assign(graph->n + 1, 0);
+  for (const auto &[u, v] : edges) {
+    ++graph->offsets[u + 1];
+    ++graph->offsets[v + 1];
+  }
+  for (node_id u = 0; u < graph->n; ++u) graph->offsets[u + 1] += graph->offsets[u];
+  graph->targets.resize(graph->offsets[graph->n]);
+  std::vector<size_t> pos(graph->offsets.begin(), graph->offsets.end() - 1);
+  for (const auto &[u, v] : edges) {
+    graph->targets[pos[u]++] = v;
+    graph->targets[pos[v]++] = u;
+  }
+  return graph;
+}
+
+const char binary_magic[8] = {'U', 'W', 'U', 'D', 'G', 'R', 'P', 'H'};
+
+void save_binary(std::string filename, const Graph& g) {
+  std::ofstream os(filename, std::ios::binary);
+  if (!os.is_open()) {
+    throw std::runtime_error("Could not write to file: " + filename);
+  }
+  static_assert(sizeof(size_t) == sizeof(uint64_t), "offsets are stored as uint64");
+  uint64_t n = g.n, m = g.m;
+  os.write(binary_magic, sizeof(binary_magic));
+  os.write(reinterpret_cast<const char*>(&n), sizeof(n));
+  os.write(reinterpret_cast<const char*>(&m), sizeof(m));
+  os.write(reinterpret_cast<const char*>(g.offsets.data()), g.offsets.size() * sizeof(uint64_t));
+  os.write(reinterpret_cast<const char*>(g.targets.data()), g.targets.size() * sizeof(node_id));
+  if (!os) {
+    throw std::runtime_error("Could not write to file: " + filename);
+  }
+}
+
+bool is_binary(std::string filename) {
+  std::ifstream is(filename, std::ios::binary);
+  char magic[sizeof(binary_magic)] = {};
+  is.read(magic, sizeof(magic));
+  return is && std::memcmp(magic, binary_magic, sizeof(magic)) == 0;
+}
+
+Graph* load_binary(std::string filename) {
+  std::ifstream is(filename, std::ios::binary);
+  if (!is.is_open()) {
+    throw std::runtime_error("Could not open file: " + filename);
+  }
+  char magic[sizeof(binary_magic)] = {};
+  uint64_t n = 0, m = 0;
+  is.read(magic, sizeof(magic));
+  is.read(reinterpret_cast<char*>(&n), sizeof(n));
+  is.read(reinterpret_cast<char*>(&m), sizeof(m));
+  if (!is || std::memcmp(magic, binary_magic, sizeof(magic)) != 0) {
+    throw std::runtime_error("Not a uwudgraph binary file: " + filename);
+  }
+  if (n > std::numeric_limits<node_id>::max() || m > std::numeric_limits<edge_id>::max()) {
+    throw std::runtime_error("Corrupt binary graph file: " + filename);
+  }
+  // bytes after the header, which bound every size read from the file before it is allocated
+  std::streamoff header = is.tellg();
+  is.seekg(0, std::ios::end);
+  uint64_t left = is.tellg() - header;
+  is.seekg(header);
+  Graph* graph = new Graph();
+  graph->n = n;
+  graph->m = m;
+  auto fail = [&](std::string what) {
+    delete graph;
+    throw std::runtime_error(what + " binary graph file: " + filename);
+  };
+  if ((n + 1) * sizeof(uint64_t) > left) fail("Truncated");
+  graph->offsets.resize(n + 1);
+  is.read(reinterpret_cast<char*>(graph->offsets.data()), graph->offsets.size() * sizeof(uint64_t));
+  if (!is) fail("Truncated");
+  if (graph->offsets[0] != 0 || graph->offsets[n] != 2 * m) fail("Corrupt");
+  for (node_id u = 0; u < n; ++u) {
+    if (graph->offsets[u] > graph->offsets[u + 1]) fail("Corrupt");
+  }
+  if (graph->offsets[n] > (left - (n + 1) * sizeof(uint64_t)) / sizeof(node_id)) fail("Truncated");
+  graph->targets.resize(graph->offsets[n]);
+  is.read(reinterpret_cast<char*>(graph->targets.data()), graph->targets.size() * sizeof(node_id));
+  if (!is) fail("Truncated");
+  for (node_id v : graph->targets) {
+    if (v >= n) fail("Corrupt");
+  }
   return graph;
 }
 
+// Writes every edge once as "u<TAB>v" with u <= v, plus the .meta file read by load_edgelist.
+void save_edgelist(std::string filename, const Graph& g) {
+  std::ofstream os(filename);
+  if (!os.is_open()) {
+    throw std::runtime_error("Could not write to file: " + filename);
+  }
+  for (node_id u = 0; u < g.n; ++u) {
+    for (node_id v : g.get_neighbors(u)) {
+      if (u <= v) os << u << "\t" << v << "\n";
+    }
+  }
+  os.close();
+  std::ofstream meta(filename + ".meta");
+  meta << g.n << " " << g.m << std::endl;
+}
+
+// binary file if it starts with the magic, edge list otherwise
+Graph* load_graph(std::string filename) {
+  return is_binary(filename) ? load_binary(filename) : load_edgelist(filename);
+}
+
 };
 
@@ -0,0 +1,62 @@
+/*
+// This header file implements the graph matrices used by the linear-algebra solvers as parallel
+// sparse matrix-vector products over the adjacency lists, so no explicit matrix is ever formed.
+// The block variants multiply b vectors in one pass over the graph.
+*/
+
+
+# pragma once
+
+#include <vector>
+
+#include "multithread/parallel.hpp"
+
+#include "uwudgraph/graph.hpp"
+#include "uwudgraph/graph_types.hpp"
+
+
+namespace uwudgraph{
+
+
+// y = L x, L = D - A
+void laplacian_spmv(const Graph& g, const std::vector<double>& x, std::vector<double>& y){
+    parallel_for(0, g.n, [&](size_t u){
+        array_view<node_id> nbrs = g.get_neighbors(u);
+        double acc = static_cast<double>(nbrs.size()) * x[u];
+        for(node_id v : nbrs) acc -= x[v];
+        y[u] = acc;
+    });
+}
+
+// Y[c] = L X[c] for c in [0, b), L = D - A
+void laplacian_spmv(const Graph& g, const std::vector<std::vector<double>>& X, size_t first,
+                    std::vector<std::vector<double>>& Y, size_t b){
+    parallel_for(0, g.n, [&](size_t u){
+        array_view<node_id> nbrs = g.get_neighbors(u);
+        double d = static_cast<double>(nbrs.size());
+        for(size_t c=0; c<b; ++c){
+            const std::vector<double>& x = X[first + c];
+            double acc = d * x[u];
+            for(node_id v : nbrs) acc -= x[v];
+            Y[c][u] = acc;
+        }
+    });
+}
+
+// Y[c] = D^{-1/2} A D^{-1/2} X[c] for c in [0, b), isolated nodes map to zero
+void normalized_adjacency_spmv(const Graph& g, const std::vector<double>& dinv_sqrt,
+                               const std::vector<std::vector<double>>& X, size_t first,
+                               std::vector<std::vector<double>>& Y, size_t b){
+    parallel_for(0, g.n, [&](size_t u){
+        array_view<node_id> nbrs = g.get_neighbors(u);
+        for(size_t c=0; c<b; ++c){
+            const std::vector<double>& x = X[first + c];
+            double acc = 0;
+            for(node_id v : nbrs) acc += dinv_sqrt[v] * x[v];
+            Y[c][u] = dinv_sqrt[u] * acc;
+        }
+    });
+}
+
+
+}
@@ -0,0 +1,84 @@
+#pragma once
+
+#include <vector>
+#include <stdexcept>
+#include <string>
+
+#include "graph_types.hpp"
+#include "array_view.hpp"
+#include "memory.hpp"
+#include "random.hpp"
+
+
+namespace wdigraph{
+// Weighted directed graph in CSR form over out-edges, with the weight of every edge in a
+// parallel array. Each row also carries an alias table over its weights, so rand_neighbor is O(1).
+class Graph{
+public:
+    node_id n = 0;
+    edge_id m = 0;
+
+    huge_vector<size_t> offsets = {};       // row u is [offsets[u], offsets[u+1])
+    huge_vector<node_id> targets = {};
+    huge_vector<weight> weights = {};
+    huge_vector<weight> wdegree = {};       // sum of the out-edge weights of u
+    huge_vector<float> alias_prob = {};     // per-row alias tables, parallel to targets
+    huge_vector<uint32_t> alias_idx = {};   // row-local index of the alias
+    weight total_weight = 0;                // sum of edge weights
+    Graph(){};
+
+    // weighted out-degree
+    weight get_degree(node_id u) const{
+        return wdegree[u];
+    }
+
+    node_id get_neighbor_count(node_id u) const{
+        return static_cast<node_id>(offsets[u+1] - offsets[u]);
+    }
+
+    array_view<node_id> get_neighbors(node_id u) const{
+        return array_view<node_id>(targets.data() + offsets[u], offsets[u+1] - offsets[u]);
+    }
+
+    array_view<weight> get_weights(node_id u) const{
+        return array_view<weight>(weights.data() + offsets[u], offsets[u+1] - offsets[u]);
+    }
+
+    // f(v, w) for every edge (u, v) of weight w
+    template <typename F>
+    void for_each_neighbor(node_id u, F&& f) const{
+        for(size_t e=offsets[u]; e<offsets[u+1]; ++e) f(targets[e], weights[e]);
+    }
+
+    weight get_total_weight() const{
+        return total_weight;
+    }
+
+    // neighbor sampled with probability proportional to the edge weight
+    node_id rand_neighbor(node_id u) const{
+        size_t first = offsets[u];
+        uint32_t k = static_cast<uint32_t>(offsets[u+1] - first);
+        if (k == 0){
+            throw std::runtime_error("No neighbors for node " + std::to_string(u));
+        }
+        return targets[first + sample_alias_table(alias_prob.data() + first, alias_idx.data() + first, k)];
+    }
+
+    // Computes the weighted degrees and per-row alias tables once offsets, targets and weights are filled.
+    void build_alias_tables(){
+        wdegree.assign(n, 0);
+        alias_prob.resize(targets.size());
+        alias_idx.resize(targets.size());
+        std::vector<double> scaled;
+        std::vector<uint32_t> small, large;
+        for(node_id u=0; u<n; ++u){
+            size_t first = offsets[u];
+            uint32_t k = static_cast<uint32_t>(offsets[u+1] - first);
+            for(size_t e=first; e<offsets[u+1]; ++e) wdegree[u] += weights[e];
+            build_alias_table(weights.data() + first, k, alias_prob.data() + first, alias_idx.data() + first,
+                              scaled, small, large);
+        }
+    }
+};
+
+};
@@ -0,0 +1,121 @@
+/*
+   load_edgelist from file and convert to wdigraph.
+   Lines are "u v w" separated by commas, spaces or tabs; a line without weight has weight 1. Weights must be
+   positive, and the m of a .meta file must match the number of edge lines.
+*/
+
+#pragma once
+
+#include <iostream>
+#include <fstream>
+#include <stdexcept>
+#include <algorithm>
+
+#include "graph.hpp"
+#include "graph_types.hpp"
+
+
+namespace wdigraph{
+
+weighted_edge parse_edgelist_content_line(std::string line) {
+  std::vector<std::string> tokens;
+  std::string token;
+  for (char c : line) {
+    if (c == ',' || c == ' ' || c == '\t' || c == '\r') {
+      if (token.length() > 0) tokens.push_back(token);
+      token.clear();
+    } else {
+      token.push_back(c);
+    }
+  }
+  if (token.length() > 0) tokens.push_back(token);
+
+  if (tokens.size() != 2 && tokens.size() != 3) {
+    throw std::invalid_argument("Wrong number of tokens on edgelist line.");
+  }
+  long long u = std::stoll(tokens[0]);
+  long long v = std::stoll(tokens[1]);
+  weight w = tokens.size() == 3 ? std::stod(tokens[2]) : 1.0;
+
+  // Make sure that the vertices u and v and the weight have been parsed successfully
+  if (u < 0 || v < 0) {
+    throw std::invalid_argument("Parse error on edgelist line.");
+  }
+  // a node whose edges all weigh 0 would have degree 0 yet neighbors, and no walk or push could leave it
+  if (!(w > 0)) {
+    throw std::invalid_argument("Non-positive weight on edgelist line.");
+  }
+  return std::make_tuple(static_cast<node_id>(u), static_cast<node_id>(v), w);
+}
+
+Graph* load_edgelist(std::string filename) {
+  // Attempt to open the provided file
+  std::ifstream is(filename);
+  if (!is.is_open()) {
+    throw std::runtime_error("Could not open file: " + filename);
+  }
+
+  Graph* graph = new Graph();
+  std::string line;
+  std::vector<weighted_edge> edges;
+  node_id max_id = 0;
+  while (std::getline(is, line)) {
+    if (line[0] != '#' && line[0] != '/' && line.length() > 0) {
+      try {
+        // This line of the input file isn't a comment, parse it.
+        edges.push_back(parse_edgelist_content_line(line));
+        max_id = std::max({max_id, std::get<0>(edges.back()), std::get<1>(edges.back())});
+      } catch (std::invalid_argument &e) {
+        throw(std::runtime_error(e.what()));
+      }
+    }
+  }
+  is.close();
+
+  // If meta file exists, read n and m from it, otherwise derive them from the data and save to meta.
+  std::string metaname = filename + ".meta";
+  std::ifstream meta(metaname);
+  if (meta.is_open()) {
+    meta >> graph->n >> graph->m;
+    meta.close();
+    if (graph->m != edges.size()) {
+      std::string error = "Meta file " + metaname + " has " + std::to_string(graph->m) + " edges, the edge list " +
+                          std::to_string(edges.size());
+      delete graph;
+      throw std::runtime_error(error);
+    }
+  } else {
+    graph->n = edges.empty() ? 0 : max_id + 1;
+    graph->m = edges.size();
+    std::ofstream meta(metaname);
+    if (!meta.is_open()) {
+      throw std::runtime_error("Could not write to file: " + metaname);
+    } else{
+      meta << graph->n << " " << graph->m << std::endl;
+      meta.close();
+      std::cout << "Wriiten meta to " << metaname << std::endl;
+    }
+  }
+  if (!edges.empty() && max_id >= graph->n) {
+    throw std::runtime_error("Node id " + std::to_string(max_id) + " out of range of meta file " + metaname);
+  }
+
+  // Count row sizes, then scatter the edges into CSR rows
+  graph->offsets.assign(graph->n + 1, 0);
+  for (const auto &[u, v, w] : edges) {
+    ++graph->offsets[u + 1];
+  }
+  for (node_id u = 0; u < graph->n; ++u) graph->offsets[u + 1] += graph->offsets[u];
+  graph->targets.resize(graph->offsets[graph->n]);
+  graph->weights.resize(graph->offsets[graph->n]);
+  std::vector<size_t> pos(graph->offsets.begin(), graph->offsets.end() - 1);
+  for (const auto &[u, v, w] : edges) {
+    graph->targets[pos[u]] = v;
+    graph->weights[pos[u]++] = w;
+    graph->total_weight += w;
+  }
+  graph->build_alias_tables();
+  return graph;
+}
+
+};
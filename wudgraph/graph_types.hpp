@@ -0,0 +1,16 @@
+#pragma once
+
+#include <iostream>
+#include <cstddef>
+#include <cstdint>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace wudgraph {
+    using node_id = uint32_t;
+    using edge = std::pair<node_id, node_id>;
+    using edge_id = uint32_t;
+    using weight = double;
+    using weighted_edge = std::tuple<node_id, node_id, weight>;
+};